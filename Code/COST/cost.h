@@ -24,7 +24,7 @@
 *************************************************************************/
 
 #ifndef queue_t
-#define queue_t SimpleQueue
+#define queue_t SelectableQueue
 #endif
 
 #include <stdarg.h>
@@ -33,13 +33,40 @@
 #include <sys/time.h>
 #include <deque>
 #include <vector>
+#include <algorithm>
 #include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <poll.h>
+#include <errno.h>
+#include <sys/wait.h>
+#include <string>
 
 #include "priority_q.h"
 #include "corsa_alloc.h"
+#include "snapshot.h"
 
 class trigger_t {};
-typedef double simtime_t;
+
+/* the simulation clock counts integer picoseconds, so that event times are
+   compared exactly; the public interface keeps using seconds as doubles and
+   converts (rounding to the nearest picosecond) when an event is scheduled */
+typedef long long simtime_t;
+#define SIMTIME_PER_SECOND 1000000000000LL
+
+inline simtime_t ToSimTime(double seconds)
+{
+  return (simtime_t) floor(seconds*(double)SIMTIME_PER_SECOND+0.5);
+}
+inline double FromSimTime(simtime_t t)
+{
+  return (double)t/(double)SIMTIME_PER_SECOND;
+}
+// rounds a time in seconds to the resolution of the simulation clock
+inline double RoundToSimTime(double seconds)
+{
+  return FromSimTime(ToSimTime(seconds));
+}
 
 #ifdef COST_DEBUG
 #define Printf(x) Print x
@@ -55,12 +82,15 @@ class TimerBase;
 
 struct CostEvent
 {
-  double time;
+  typedef simtime_t time_type;
+  simtime_t time;
   CostEvent* next;
   union {
     CostEvent* prev;
     int pos;  // exclusively for heap queue.
   };
+  int bucket;  // exclusively for ladder queue.
+  unsigned long long seq;  // insertion order, stamped by SelectableQueue (breaks time ties).
   TimerBase* object;
   int index;
   unsigned char active;
@@ -72,12 +102,36 @@ class TimerBase
 {
  public:
   virtual void activate(CostEvent*) = 0;
+  // saves or loads the pending time and data (only timers registered with the engine)
+  virtual void Checkpoint(CostSnapshot&) {}
+  virtual CostEvent* SnapshotEvent() { return NULL; }
   inline virtual ~TimerBase() {}	//mwl required by gcc 4.0
 };
 
 class TypeII;
 
-/* the COST simulation engine */
+/* the COST simulation engine
+
+   Several engines may live in the same process (e.g. one per thread when
+   running replications). Components and timers attach to the current
+   engine of the calling thread, which is the last engine constructed on
+   that thread (or the one passed to MakeCurrent()). Each engine owns its
+   components, allocators and random number generator.
+
+   An engine can also run independent sub-simulations in parallel:
+   components moved to another engine with MoveComponent() run on its own
+   thread, each engine straight to the stop time. Components of different
+   sub-simulations must not interact at all (no events nor calls between
+   them), and timers are scheduled in the engine of the thread that sets
+   them.
+
+   A serial run can be saved to a snapshot at a given time and another
+   process can resume it from there (see SaveSnapshot()/LoadSnapshot()),
+   so that a warm-up is simulated once and shared by several runs.
+
+   A serial run can also branch at ClearStatsTime() into several variants
+   (see Branches()): one child process is forked per branch, so the
+   warm-up is shared through copy-on-write memory. */
 
 class CostSimEng
 {
@@ -86,18 +140,25 @@ class CostSimEng
   class seed_t
       {
        public:
-	void operator = (long seed) { srand48(seed); };
+	seed_t(CostSimEng* engine) : m_engine(engine) {};
+	void operator = (long seed) { m_engine->SeedRandom(seed); };
+       private:
+	CostSimEng* m_engine;
       };
   seed_t		Seed;
   CostSimEng()
-      : stopTime( 0), clearStatsTime( 0), m_clock( 0.0)
+      : Seed( this), stopTime( 0), clearStatsTime( 0), snapshotTime( 0), m_snapshot_save( NULL),
+	m_snapshot_load( NULL), m_num_branches( 0), m_max_branches_running( 0), m_branch( -1),
+	m_branch_output( NULL), m_clock( 0), m_parent( NULL)
       {
-        if( m_instance == NULL)
-	  m_instance = this;
-        else
-	  printf("Error: only one simulation engine can be created\n");
+        SeedRandom(0);
+        m_instance = this;
+      }
+  virtual		~CostSimEng()
+      {
+        if( m_instance == this)
+	  m_instance = NULL;
       }
-  virtual		~CostSimEng()	{ }
   static CostSimEng	*Instance()
       {
         if(m_instance==NULL)
@@ -107,6 +168,14 @@ class CostSimEng
         }
         return m_instance;
       }
+  void		MakeCurrent()	{ m_instance = this; }
+  // same state as srand48(seed), so single-engine runs keep their random sequence
+  void		SeedRandom(long seed)
+      {
+        m_rand_state[0] = 0x330E;
+        m_rand_state[1] = (unsigned short) (seed & 0xFFFF);
+        m_rand_state[2] = (unsigned short) ((seed >> 16) & 0xFFFF);
+      }
   CorsaAllocator	*GetAllocator(unsigned int datasize)
       {
     	for(unsigned int i=0;i<m_allocators.size();i++)
@@ -124,6 +193,16 @@ class CostSimEng
       {
         m_components.push_back(c);
       }
+  void		RemoveComponent(TypeII*c)
+      {
+        std::vector<TypeII*>::iterator iter = std::find(m_components.begin(), m_components.end(), c);
+        if( iter != m_components.end())
+	  m_components.erase(iter);
+      }
+  void		AddTimer(TimerBase*t)	{ m_timers.push_back(t); }
+  // moves a component to a sub-simulation run by this engine in parallel
+  inline void	MoveComponent(TypeII* c, CostSimEng* sub);
+  int		SubSimulations() const	{ return (int) m_subsimulations.size() + 1; }
   void		ScheduleEvent(CostEvent*e)
       {
 	if( e->time < m_clock)
@@ -136,29 +215,69 @@ class CostSimEng
         //printf("cancel event-> time: %f, object: %p\n",e->time,e->object);
         m_queue.Delete(e);
       }
-  double	Random( double v=1.0)	{ return v*drand48();}
-  int		Random( int v)		{ return (int)(v*drand48()); }
+  double	Random( double v=1.0)	{ return v*erand48(m_rand_state);}
+  int		Random( int v)		{ return (int)(v*erand48(m_rand_state)); }
   double	Exponential(double mean)	{ return -mean*log(Random());}
+  // picks the event queue backend ("simple", "heap", "dary", "calendar" or "ladder"),
+  // must be called before any event is scheduled
+  bool		EventQueue(const char* name)	{ return m_queue.Select(name); }
   virtual void	Start()		{}
   virtual void	Stop()		{}
   void		Run();
-  double	SimTime()	{ return m_clock; } 
-  void		StopTime( double t)	{ stopTime = t; }
-  double	StopTime() const	{ return stopTime; }
-  void		ClearStatsTime( double t)	{ clearStatsTime = t; }
-  double	ClearStatsTime() const	{ return clearStatsTime; }
+  double	SimTime()	{ return FromSimTime(m_clock); } 
+  simtime_t	SimTimeTicks()	{ return m_clock; } 
+  void		StopTime( double t)	{ stopTime = ToSimTime(t); }
+  double	StopTime() const	{ return FromSimTime(stopTime); }
+  void		ClearStatsTime( double t)	{ clearStatsTime = ToSimTime(t); }
+  double	ClearStatsTime() const	{ return FromSimTime(clearStatsTime); }
   virtual void	ClearStats()	{}
+  // Run() writes a snapshot when the clock reaches the given time, or resumes
+  // from a snapshot after starting the components (same binary and inputs)
+  void		SaveSnapshot( double t, const char* filename)	{ snapshotTime = ToSimTime(t); m_snapshot_save = filename; }
+  void		LoadSnapshot( const char* filename)	{ m_snapshot_load = filename; }
+  // state of the derived simulation (the components checkpoint themselves)
+  virtual void	Checkpoint( CostSnapshot&)	{}
+  // Run() forks one child process per branch when the clock reaches
+  // ClearStatsTime() (at most max_running at a time, 0: one per core). Each
+  // child calls Branch(), clears the statistics, runs until StopTime() and
+  // writes its results to BranchOutput(). The parent passes them in branch
+  // order to BranchResults() and returns from Run() without stopping.
+  void		Branches( int num_branches, int max_running)	{ m_num_branches = num_branches; m_max_branches_running = max_running; }
+  int		BranchIndex() const	{ return m_branch; }
+  FILE*		BranchOutput()	{ return m_branch_output; }
+  virtual void	Branch( int)	{}
+  virtual void	BranchResults( int, const std::string&)	{}
  private:
-  double	stopTime;
-  double	clearStatsTime;	// time to zero stats
+  void		Begin();
+  void		RunUntil( simtime_t limit);
+  void		End();
+  void		RunParallel();
+  static void	*RunSubSimulation( void *engine);
+  void		Snapshot( const char* filename, bool loading);
+  bool		ForkBranches();
+  simtime_t	stopTime;
+  simtime_t	clearStatsTime;	// time to zero stats
+  simtime_t	snapshotTime;	// time to write m_snapshot_save
+  const char*	m_snapshot_save;
+  const char*	m_snapshot_load;
+  int		m_num_branches;
+  int		m_max_branches_running;
+  int		m_branch;	// branch run by this process (-1: not a branch)
+  FILE*		m_branch_output;	// pipe to the parent of a branch
   double	eventRate;
   double	runningTime;
   long		eventsProcessed;
-  double	m_clock;
+  simtime_t	m_clock;
+  struct timeval	start_time;
   queue_t<CostEvent>	m_queue;
   std::vector<TypeII*>	m_components;
-  static CostSimEng	*m_instance;
+  std::vector<TimerBase*>	m_timers;	// timers that can be saved in snapshots
+  static __thread CostSimEng	*m_instance;	// current engine of each thread
   std::vector<CorsaAllocator*>	m_allocators;
+  unsigned short	m_rand_state[3];
+  std::vector<CostSimEng*>	m_subsimulations;	// engines run in parallel by this one
+  CostSimEng*	m_parent;	// engine running this sub-simulation
+  pthread_barrier_t	m_clear_stats;	// sub-simulations waiting while the statistics are cleared
 };
 
 /* the base class of all component classes */
@@ -169,6 +288,12 @@ class TypeII
  public: 
   virtual void Start() {};
   virtual void Stop() {};
+  // saves or loads the state of the component (see CostSnapshot)
+  virtual void Checkpoint(CostSnapshot&)
+      {
+        printf("Error: a component does not support snapshots\n");
+        exit(-1);
+      }
   inline virtual ~TypeII() {}		//mwl required by gcc 4.0
   TypeII()
       {
@@ -180,15 +305,30 @@ class TypeII
   void Print(const bool, const char*, ...);
 #endif
     
-  double Random(double v=1.0) { return v*drand48();}
-  int Random(int v) { return (int)(v*drand48());}
+  double Random(double v=1.0) { return m_simeng->Random(v);}
+  int Random(int v) { return m_simeng->Random(v);}
   double Exponential(double mean) { return -mean*log(Random());}
   inline double SimTime() const { return m_simeng->SimTime(); }
+  inline simtime_t SimTimeTicks() const { return m_simeng->SimTimeTicks(); }
   inline double StopTime() const { return m_simeng->StopTime(); }
  private:
+  friend class CostSimEng;
   CostSimEng* m_simeng;
 }; 
 
+void CostSimEng::MoveComponent(TypeII* c, CostSimEng* sub)
+{
+  if( std::find(m_subsimulations.begin(), m_subsimulations.end(), sub) == m_subsimulations.end())
+  {
+    m_subsimulations.push_back(sub);
+    sub->m_parent = this;
+    sub->m_queue.Select(m_queue.Type());
+  }
+  c->m_simeng->RemoveComponent(c);
+  sub->AddComponent(c);
+  c->m_simeng = sub;
+}
+
 #ifdef COST_DEBUG
 void TypeII::Print(const bool flag, const char* format, ...)
 {
@@ -201,64 +341,334 @@ void TypeII::Print(const bool flag, const char* format, ...)
 }
 #endif
 
-CostSimEng* CostSimEng::m_instance = NULL;
+__thread CostSimEng* CostSimEng::m_instance = NULL;
 
 void CostSimEng::Run()
 {
-  double	nextTime = (clearStatsTime != 0.0 && clearStatsTime < stopTime) ? clearStatsTime : stopTime;
-
-  m_clock = 0.0;
-  eventsProcessed = 0l;
-  std::vector<TypeII*>::iterator iter;
-      
-  struct timeval start_time;    
-  gettimeofday( &start_time, NULL);
-
-  Start();
+  Begin();
 
-  for( iter = m_components.begin(); iter != m_components.end(); iter++)
-    (*iter)->Start();
-
-  CostEvent* e=m_queue.DeQueue();
-  while( e != NULL)
+  if( !m_subsimulations.empty())
   {
-    if( e->time >= nextTime)
+    if( m_snapshot_save != NULL || m_snapshot_load != NULL || m_num_branches > 0)
     {
-      if( nextTime == stopTime)
-	break;
-      // otherwise, nextTime == clearStatsTime
-      printf( "Clearing statistics @ %f\n", nextTime);
-      nextTime = stopTime;
-      ClearStats();
+      printf("Error: snapshots and branches need a serial run (no sub-simulations)\n");
+      exit(-1);
     }
-    //printf("time: %f, event: %p\n", e->time, e); 
-    assert( e->time >= m_clock);
-    m_clock = e->time;
-    e->object->activate( e);
-    eventsProcessed++;
-    e = m_queue.DeQueue();
+    RunParallel();
+  }
+  else
+  {
+    if( m_snapshot_load != NULL)
+    {
+      Snapshot( m_snapshot_load, true);
+      printf( "Resuming from snapshot '%s' @ %f\n", m_snapshot_load, FromSimTime(m_clock));
+    }
+    // the snapshot and the clearing of statistics happen in time order
+    bool save_pending = m_snapshot_save != NULL && snapshotTime >= m_clock && snapshotTime < stopTime;
+    bool clear_pending = clearStatsTime != 0 && clearStatsTime >= m_clock && clearStatsTime < stopTime;
+    while( save_pending || clear_pending)
+    {
+      if( save_pending && (!clear_pending || snapshotTime <= clearStatsTime))
+      {
+        RunUntil( snapshotTime);
+        printf( "Saving snapshot '%s' @ %f\n", m_snapshot_save, FromSimTime(snapshotTime));
+        Snapshot( m_snapshot_save, false);
+        save_pending = false;
+      }
+      else
+      {
+        RunUntil( clearStatsTime);
+        if( m_num_branches > 0)
+        {
+          if( save_pending)
+          {
+            printf("Error: a snapshot cannot be saved after branching\n");
+            exit(-1);
+          }
+          if( !ForkBranches())
+            return;
+        }
+        printf( "Clearing statistics @ %f\n", FromSimTime(clearStatsTime));
+        ClearStats();
+        clear_pending = false;
+      }
+    }
+    RunUntil( stopTime);
+  }
+
+  End();
+  if( m_branch_output != NULL)
+  {
+    fclose( m_branch_output);
+    m_branch_output = NULL;
   }
-  m_clock = stopTime;
-  for(iter = m_components.begin(); iter != m_components.end(); iter++)
-    (*iter)->Stop();
-	    
-  Stop();
 
   struct timeval stop_time;    
   gettimeofday(&stop_time,NULL);
 
   runningTime = stop_time.tv_sec - start_time.tv_sec +
       (stop_time.tv_usec - start_time.tv_usec) / 1000000.0;
+  for( unsigned int i = 0; i < m_subsimulations.size(); i++)
+    eventsProcessed += m_subsimulations[i]->eventsProcessed;
   eventRate = eventsProcessed/runningTime;
   
   //#ifndef VIZ
   printf("# -------------------------------------------------------------------------\n");	
-  printf("# CostSimEng with %s, stopped at %f\n", m_queue.GetName(), stopTime);	
+  printf("# CostSimEng with %s, stopped at %f\n", m_queue.GetName(), FromSimTime(stopTime));	
+  if( !m_subsimulations.empty())
+    printf("# %d sub-simulations in parallel\n", SubSimulations());
   printf("# %ld events processed in %.3f seconds, event processing rate: %.0f\n",	
   eventsProcessed, runningTime, eventRate);
+  printf("# event queue: %ld enqueued, %ld dequeued, %ld cancelled, peak size %ld\n",
+  m_queue.Enqueued(), m_queue.Dequeued(), m_queue.Deleted(), m_queue.PeakSize());
   //#endif //VIZ
 }
 
+void CostSimEng::Begin()
+{
+  m_clock = 0;
+  eventsProcessed = 0l;
+  gettimeofday( &start_time, NULL);
+
+  // the parent starts itself, sub-simulations only start their components
+  if( m_parent == NULL)
+    Start();
+
+  for( std::vector<TypeII*>::iterator iter = m_components.begin(); iter != m_components.end(); iter++)
+    (*iter)->Start();
+}
+
+// processes the events scheduled before the given limit
+void CostSimEng::RunUntil( simtime_t limit)
+{
+  CostEvent* e=m_queue.NextEvent();
+  while( e != NULL && e->time < limit)
+  {
+    m_queue.DeQueue();
+    //printf("time: %f, event: %p\n", e->time, e); 
+    assert( e->time >= m_clock);
+    m_clock = e->time;
+    e->object->activate( e);
+    eventsProcessed++;
+    e = m_queue.NextEvent();
+  }
+}
+
+void CostSimEng::End()
+{
+  m_clock = stopTime;
+  for( std::vector<TypeII*>::iterator iter = m_components.begin(); iter != m_components.end(); iter++)
+    (*iter)->Stop();
+
+  if( m_parent == NULL)
+    Stop();
+}
+
+/* parallel execution: the sub-simulations do not interact, so each one
+   runs on its own thread straight to the stop time and the parent joins
+   them at the end. They only meet at ClearStatsTime(), where the
+   statistics are cleared while all the engines are waiting. */
+
+void CostSimEng::RunParallel()
+{
+  bool clear_pending = clearStatsTime != 0 && clearStatsTime < stopTime;
+  pthread_barrier_init( &m_clear_stats, NULL, m_subsimulations.size() + 1);
+
+  std::vector<pthread_t> threads( m_subsimulations.size());
+  for( unsigned int i = 0; i < m_subsimulations.size(); i++)
+  {
+    m_subsimulations[i]->stopTime = stopTime;
+    m_subsimulations[i]->clearStatsTime = clear_pending ? clearStatsTime : 0;
+    pthread_create( &threads[i], NULL, RunSubSimulation, m_subsimulations[i]);
+  }
+
+  if( clear_pending)
+  {
+    RunUntil( clearStatsTime);
+    pthread_barrier_wait( &m_clear_stats);
+    printf( "Clearing statistics @ %f\n", FromSimTime(clearStatsTime));
+    ClearStats();
+    pthread_barrier_wait( &m_clear_stats);
+  }
+  RunUntil( stopTime);
+
+  // the sub-simulations stop their components when they reach the stop time
+  for( unsigned int i = 0; i < threads.size(); i++)
+    pthread_join( threads[i], NULL);
+  pthread_barrier_destroy( &m_clear_stats);
+}
+
+/* saves (or loads) the engine: clock, random number generator, pending
+   events and then every component in order. Pending events are written as
+   indices of their timers, in processing order. When loading, the events
+   scheduled by Start() are dropped before the timers are overwritten. The
+   queue is rebuilt the same way when saving and loading, so the run that
+   saved the snapshot and the resumed ones process the same sequence of
+   events (simultaneous ones included) with every queue. */
+
+void CostSimEng::Snapshot( const char* filename, bool loading)
+{
+  CostSnapshot snapshot;
+  snapshot.Open( filename, loading);
+  snapshot.Check( COST_SNAPSHOT_VERSION, "version");
+  snapshot.Check( (long) m_components.size(), "components");
+  snapshot.Check( (long) m_timers.size(), "timers");
+  snapshot.Value( m_clock);
+  snapshot.Value( eventsProcessed);
+  snapshot.Array( m_rand_state, 3);
+
+  std::vector<CostEvent*> events;
+  m_queue.Drain( events);
+  long num_events = events.size();
+  snapshot.Value( num_events);
+  std::vector<int> timer_per_event( num_events);
+  if( !loading)
+  {
+    std::map<TimerBase*,int> timer_index;
+    for( unsigned int i = 0; i < m_timers.size(); i++)
+      timer_index[ m_timers[i]] = i;
+    for( long i = 0; i < num_events; i++)
+    {
+      std::map<TimerBase*,int>::iterator iter = timer_index.find( events[i]->object);
+      if( iter == timer_index.end())
+      {
+        printf("Error: a pending event belongs to a timer that does not support snapshots\n");
+        exit(-1);
+      }
+      timer_per_event[i] = iter->second;
+    }
+  }
+  if( num_events > 0)
+    snapshot.Array( &timer_per_event[0], num_events);
+
+  for( unsigned int i = 0; i < m_timers.size(); i++)
+    m_timers[i]->Checkpoint( snapshot);
+  if( loading)
+  {
+    events.resize( num_events);
+    for( long i = 0; i < num_events; i++)
+      events[i] = m_timers[ timer_per_event[i]]->SnapshotEvent();
+  }
+  m_queue.Restore( events);
+
+  for( std::vector<TypeII*>::iterator iter = m_components.begin(); iter != m_components.end(); iter++)
+    (*iter)->Checkpoint( snapshot);
+  Checkpoint( snapshot);
+  snapshot.Close();
+}
+
+/* forks the branches and collects their results through one pipe per
+   branch, which are read as data arrives so that no child blocks on a full
+   pipe. Returns true in a child (which goes on running its branch) and
+   false in the parent once every branch has finished. Buffered output is
+   flushed first, otherwise every child would write it again. */
+
+bool CostSimEng::ForkBranches()
+{
+  int max_running = m_max_branches_running;
+  if( max_running <= 0)
+    max_running = sysconf( _SC_NPROCESSORS_ONLN);
+
+  std::vector<std::string> results( m_num_branches);
+  std::vector<struct pollfd> pipes;	// read end of the running branches
+  std::vector<int> branch_per_pipe;
+  std::vector<pid_t> pid_per_pipe;
+  int next_branch = 0;
+  int num_failed = 0;
+
+  fflush( NULL);
+  while( next_branch < m_num_branches || !pipes.empty())
+  {
+    while( next_branch < m_num_branches && (int) pipes.size() < max_running)
+    {
+      int fd[2];
+      if( pipe( fd) != 0)
+      {
+        printf("Error: the pipe of branch %d cannot be created\n", next_branch);
+        exit(-1);
+      }
+      pid_t pid = fork();
+      if( pid < 0)
+      {
+        printf("Error: branch %d cannot be forked\n", next_branch);
+        exit(-1);
+      }
+      if( pid == 0)
+      {
+        for( unsigned int i = 0; i < pipes.size(); i++)
+          close( pipes[i].fd);
+        close( fd[0]);
+        m_branch = next_branch;
+        m_branch_output = fdopen( fd[1], "w");
+        m_num_branches = 0;
+        printf( "Branch %d forked @ %f\n", m_branch, FromSimTime(clearStatsTime));
+        Branch( m_branch);
+        return true;
+      }
+      close( fd[1]);
+      struct pollfd entry;
+      entry.fd = fd[0];
+      entry.events = POLLIN;
+      entry.revents = 0;
+      pipes.push_back( entry);
+      branch_per_pipe.push_back( next_branch);
+      pid_per_pipe.push_back( pid);
+      next_branch++;
+    }
+
+    if( poll( &pipes[0], pipes.size(), -1) < 0)
+      continue;
+    for( unsigned int i = 0; i < pipes.size(); i++)
+    {
+      if( pipes[i].revents == 0)
+        continue;
+      char buffer[4096];
+      ssize_t size = read( pipes[i].fd, buffer, sizeof(buffer));
+      if( size > 0 || (size < 0 && errno == EINTR))
+      {
+        if( size > 0)
+          results[ branch_per_pipe[i]].append( buffer, size);
+        continue;
+      }
+      // end of the branch
+      int status;
+      close( pipes[i].fd);
+      waitpid( pid_per_pipe[i], &status, 0);
+      if( !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      {
+        printf("Error: branch %d failed\n", branch_per_pipe[i]);
+        num_failed++;
+      }
+      pipes.erase( pipes.begin() + i);
+      branch_per_pipe.erase( branch_per_pipe.begin() + i);
+      pid_per_pipe.erase( pid_per_pipe.begin() + i);
+      i--;
+    }
+  }
+
+  for( int i = 0; i < m_num_branches; i++)
+    BranchResults( i, results[i]);
+  printf("# %d branches finished (%d failed) from %f\n", m_num_branches, num_failed, FromSimTime(clearStatsTime));
+  return false;
+}
+
+void *CostSimEng::RunSubSimulation( void *engine)
+{
+  CostSimEng* sub = (CostSimEng*) engine;
+  CostSimEng* parent = sub->m_parent;
+  sub->MakeCurrent();
+  sub->Begin();
+  if( sub->clearStatsTime != 0)
+  {
+    sub->RunUntil( sub->clearStatsTime);
+    pthread_barrier_wait( &parent->m_clear_stats);
+    pthread_barrier_wait( &parent->m_clear_stats);
+  }
+  sub->RunUntil( sub->stopTime);
+  sub->End();
+  return NULL;
+}
+
 
 
 
@@ -270,16 +680,18 @@ template <class T> component Timer : public TimerBase
   struct event_t : public CostEvent { T data; };
   /* the pointer to the simulation engine is passed
      in the configuration function */
-  Timer() { m_simeng = CostSimEng::Instance(); m_event.active= false; }
+  Timer() { m_simeng = CostSimEng::Instance(); m_event.active= false; m_simeng->AddTimer(this); }
   inline void Set(T const &, double );
   inline void Set(double );
-  inline double GetTime() { return m_event.time; }
+  inline double GetTime() { return FromSimTime(m_event.time); }
   inline bool Active() { return m_event.active; }
   inline T& GetData() { return m_event.data; }
   inline void SetData(T const &d) { m_event.data = d; }
   void Cancel();
   outport void to_component(T&);
   void activate(CostEvent*);
+  void Checkpoint(CostSnapshot&);
+  CostEvent* SnapshotEvent() { return &m_event; }
  private:
   CostSimEng* m_simeng;
   event_t m_event;
@@ -290,10 +702,11 @@ void Timer<T>::Set(T const & data, double time)
 {
   if(m_event.active)
     m_simeng->CancelEvent(&m_event);
-  m_event.time = time;
+  m_event.time = ToSimTime(time);
   m_event.data = data;
   m_event.object = this;
   m_event.active=true;
+  m_simeng = CostSimEng::Instance();	// the engine of the sub-simulation setting the timer
   m_simeng->ScheduleEvent(&m_event);
 }
 
@@ -302,9 +715,10 @@ void Timer<T>::Set(double time)
 {
   if(m_event.active)
     m_simeng->CancelEvent(&m_event);
-  m_event.time = time;
+  m_event.time = ToSimTime(time);
   m_event.object = this;
   m_event.active=true;
+  m_simeng = CostSimEng::Instance();	// the engine of the sub-simulation setting the timer
   m_simeng->ScheduleEvent(&m_event);
 }
 
@@ -324,6 +738,20 @@ void Timer<T>::activate(CostEvent*e)
   to_component(m_event.data);
 }
 
+// the data of the timer is saved as a plain value
+template <class T>
+void Timer<T>::Checkpoint(CostSnapshot& snapshot)
+{
+  snapshot.Value(m_event.time);
+  snapshot.Value(m_event.active);
+  snapshot.Value(m_event.data);
+  if(snapshot.Loading())
+  {
+    m_event.object = this;
+    m_simeng = CostSimEng::Instance();
+  }
+}
+
 /* another, more complicated timer */
 
 template <class T> component MultiTimer : public TimerBase
@@ -341,13 +769,15 @@ template <class T> component MultiTimer : public TimerBase
   void activate(CostEvent*event);
 
   inline bool Active(unsigned int index=0) { return GetEvent(index)->active; }
-  inline double GetTime(unsigned int index=0) { return GetEvent(index)->time; }
+  inline double GetTime(unsigned int index=0) { return FromSimTime(GetEvent(index)->time); }
   inline T& GetData(unsigned int index=0) { return GetEvent(index)->data; }
   inline void SetData(T const &d, unsigned int index) { GetEvent(index)->data = d; }
 
   event_t* GetEvent(unsigned int index);
 				 
  private:
+  inline void Bind();
+
   std::vector<event_t*> m_events;
   CostSimEng* m_simeng;
 };
@@ -381,12 +811,27 @@ typename MultiTimer<T>::event_t* MultiTimer<T>::GetEvent(unsigned int index)
   return m_events[index];
 }
 
+// binds the timer to the engine of the sub-simulation setting it (as
+// Timer::Set does). Pending events stay in the engine that scheduled them,
+// so the engine only changes while no event is pending.
+template <class T>
+void MultiTimer<T>::Bind()
+{
+  CostSimEng* engine = CostSimEng::Instance();
+  if(engine == m_simeng) return;
+  for(unsigned int i=0;i<m_events.size();i++)
+    assert(!m_events[i]->active);
+  m_simeng = engine;
+}
+
 template <class T>
 void MultiTimer<T>::Set(T const & data, double time, unsigned int index)
 {
   event_t * e = GetEvent(index);
   if(e->active)m_simeng->CancelEvent(e);
-  e->time = time;
+  e->active = false;
+  Bind();
+  e->time = ToSimTime(time);
   e->data = data;
   e->object = this;
   e->active = true;
@@ -398,7 +843,9 @@ void MultiTimer<T>::Set(double time, unsigned int index)
 {
   event_t * e = GetEvent(index);
   if(e->active)m_simeng->CancelEvent(e);
-  e->time = time;
+  e->active = false;
+  Bind();
+  e->time = ToSimTime(time);
   e->object = this;
   e->active = true;
   m_simeng->ScheduleEvent(e);
@@ -441,15 +888,17 @@ template <class T> component InfiTimer : public TimerBase
   inline event_t* GetEvent(unsigned int index);
 
   inline bool Active(unsigned int index) { return GetEvent(index)->active; }
-  inline double GetTime(unsigned int index) { return GetEvent(index)->time; }
+  inline double GetTime(unsigned int index) { return FromSimTime(GetEvent(index)->time); }
   inline T& GetData(unsigned int index) { return GetEvent(index)->data; }
   inline void SetData(T const &d, unsigned int index) { GetEvent(index)->data = d; }
 
  private:
   inline void ReleaseSlot(unsigned int i) { m_free_slots.push_back(i); }
   inline unsigned int GetSlot();
+  inline void Bind();
 					 
   std::vector<event_t*> m_events;
+  std::vector<CorsaAllocator*> m_event_allocators;	// allocator of each event (engines may change)
   std::vector<unsigned int> m_free_slots;
   CostSimEng* m_simeng;
 
@@ -468,7 +917,7 @@ template <class T>
 InfiTimer<T>::~InfiTimer()
 {
   for(unsigned int i=0;i<m_events.size();i++)
-    m_allocator->free(m_events[i]);
+    m_event_allocators[i]->free(m_events[i]);
 }
 
 template <class T>
@@ -479,6 +928,7 @@ typename InfiTimer<T>::event_t* InfiTimer<T>::GetEvent(unsigned int index)
     for (unsigned int i=m_events.size();i<=index;i++)
     {
       m_events.push_back( (event_t*) m_allocator->alloc() );
+      m_event_allocators.push_back( m_allocator);
       m_events[i]->active=false;
       m_events[i]->index=i;
       m_free_slots.push_back(i);
@@ -487,13 +937,30 @@ typename InfiTimer<T>::event_t* InfiTimer<T>::GetEvent(unsigned int index)
   return m_events[index];
 }
 
+// binds the timer to the engine of the sub-simulation setting it (as
+// Timer::Set does), and new events to the allocator of that engine. The
+// events allocated before stay with their allocator, and pending events in
+// the engine that scheduled them, so the engine only changes while no
+// event is pending.
+template <class T>
+void InfiTimer<T>::Bind()
+{
+  CostSimEng* engine = CostSimEng::Instance();
+  if(engine == m_simeng) return;
+  for(unsigned int i=0;i<m_events.size();i++)
+    assert(!m_events[i]->active);
+  m_simeng = engine;
+  m_allocator = m_simeng->GetAllocator(sizeof(event_t));
+}
+
 template <class T>
 unsigned int InfiTimer<T>::Set(T const & data, double time)
 {
+  Bind();
   int index=GetSlot();
   event_t * e = GetEvent(index);
   assert(e->active==false);
-  e->time = time;
+  e->time = ToSimTime(time);
   e->data = data;
   e->object = this;
   e->active = true;
@@ -504,10 +971,11 @@ unsigned int InfiTimer<T>::Set(T const & data, double time)
 template <class T>
 unsigned int InfiTimer<T>::Set(double time)
 {
+  Bind();
   int index=GetSlot();
   event_t * e = GetEvent(index);
   assert(e->active==false);
-  e->time = time;
+  e->time = ToSimTime(time);
   e->object = this;
   e->active = true;
   m_simeng->ScheduleEvent(e);
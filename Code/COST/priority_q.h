@@ -25,15 +25,20 @@
 #define PRIORITY_QUEUE_H
 #include <stdio.h>
 #include <string.h>
+#include <vector>
+#include <algorithm>
 
 /*
-  Five Priority Queues:
+  Eight Priority Queues:
 
   SimpleQueue: Double Linked list
   GuardedQueue: Derived from SimpleQueue, checks before EnQueue() and Delete()
   ErrorQueue: Derived from SimpleQueue, only correct half of the time (for debugging)
   HeadQueue: Implicit Heap
+  DaryHeapQueue: Implicit 4-ary heap keeping the keys next to the pointers
   CalendarQueue: The fastest
+  LadderQueue: Top/rungs/bottom ladder, O(1) amortized for bursty schedules
+  SelectableQueue: Wrapper choosing one of the above at run time
 
   Last Modified: Nov 18, 2002 by Gilbert Chen 
 
@@ -48,8 +53,11 @@ class SimpleQueue
   ITEM* DeQueue();
   void Delete(ITEM*);
   ITEM* NextEvent() const { return m_head; };
+  void Restore(std::vector<ITEM*>&);
   const char* GetName();
  protected:
+  // ties are broken by insertion order (ITEM::seq, stamped by SelectableQueue)
+  static bool Earlier(const ITEM* a, const ITEM* b) { return a->time < b->time || (a->time == b->time && a->seq < b->seq); };
   ITEM* m_head;
 };
 
@@ -63,7 +71,7 @@ const char* SimpleQueue<ITEM>::GetName()
 template <class ITEM>
 void SimpleQueue<ITEM>::EnQueue(ITEM* item)
 {
-  if( m_head==NULL || item->time < m_head->time )
+  if( m_head==NULL || Earlier(item,m_head) )
   {
     if(m_head!=NULL)m_head->prev=item;
     item->next=m_head;
@@ -73,7 +81,7 @@ void SimpleQueue<ITEM>::EnQueue(ITEM* item)
   }
     
   ITEM* i=m_head;
-  while( i->next!=NULL && item->time > i->next->time)
+  while( i->next!=NULL && Earlier(i->next,item))
     i=i->next;
   item->next=i->next;
   if(i->next!=NULL)i->next->prev=item;
@@ -92,6 +100,24 @@ ITEM* SimpleQueue<ITEM> ::DeQueue()
   return item;
 }
 
+// links the items in the given order (already sorted by time) into an empty queue,
+// so that simultaneous items keep the order in which they were taken out
+template <class ITEM>
+void SimpleQueue<ITEM>::Restore(std::vector<ITEM*>& items)
+{
+  m_head=NULL;
+  ITEM* last=NULL;
+  for(unsigned int i=0;i<items.size();i++)
+  {
+    ITEM* item=items[i];
+    item->prev=last;
+    item->next=NULL;
+    if(last==NULL) m_head=item;
+    else last->next=item;
+    last=item;
+  }
+}
+
 template <class ITEM>
 void SimpleQueue<ITEM>::Delete(ITEM* item)
 {
@@ -128,7 +154,7 @@ void GuardedQueue<ITEM>::EnQueue(ITEM* item)
   {
     if(i==item)
     {
-      pthread_printf("queue error: item %f(%p) is already in the queue\n",item->time,item);
+      pthread_printf("queue error: item %f(%p) is already in the queue\n",(double)item->time,item);
     }
     i=i->next;
   }
@@ -142,7 +168,7 @@ void GuardedQueue<ITEM>::Delete(ITEM* item)
   while(i!=item&&i!=NULL)
     i=i->next;
   if(i==NULL)
-    pthread_printf("error: cannot find the to-be-deleted event %f(%p)\n",item->time,item);
+    pthread_printf("error: cannot find the to-be-deleted event %f(%p)\n",(double)item->time,item);
   else
     SimpleQueue<ITEM>::Delete(item);
 }
@@ -158,7 +184,7 @@ bool GuardedQueue<ITEM>::Validate(const char* s)
   sprintf(out,"queue error %s : ",s);
   while(i!=NULL)
   {
-    sprintf(buff,"%f ",i->time);
+    sprintf(buff,"%f ",(double)i->time);
     strcat(out,buff);
     if(i->next!=NULL)
       if(i->next->prev!=i)
@@ -235,6 +261,8 @@ class HeapQueue
   const char* GetName();
   ITEM* NextEvent() const { return num_of_elems?elems[0]:NULL; };
  private:
+  // ties are broken by insertion order (ITEM::seq, stamped by SelectableQueue)
+  static bool Earlier(const ITEM* a, const ITEM* b) { return a->time < b->time || (a->time == b->time && a->seq < b->seq); };
   void SiftDown(int);
   void PercolateUp(int);
   void Validate(const char*);
@@ -264,9 +292,9 @@ void HeapQueue<ITEM>::Validate(const char* s)
       for(j=0;j<num_of_elems;j++)
       {
 	if(i!=j)
-	  sprintf(buff,"%f(%d) ",elems[j]->time,j);
+	  sprintf(buff,"%f(%d) ",(double)elems[j]->time,j);
 	else
-	  sprintf(buff,"{%f(%d)} ",elems[j]->time,j);
+	  sprintf(buff,"{%f(%d)} ",(double)elems[j]->time,j);
 	strcat(out,buff);
       }
       printf("%s\n",out);
@@ -295,9 +323,9 @@ void HeapQueue<ITEM>::SiftDown(int node)
     k=i;
     c1=c2=2*i+1;
     c2++;
-    if(c1<num_of_elems && elems[c1]->time < elems[i]->time)
+    if(c1<num_of_elems && Earlier(elems[c1],elems[i]))
       i=c1;
-    if(c2<num_of_elems && elems[c2]->time < elems[i]->time)
+    if(c2<num_of_elems && Earlier(elems[c2],elems[i]))
       i=c2;
     if(k!=i)
     {
@@ -320,7 +348,7 @@ void HeapQueue<ITEM>::PercolateUp(int node)
     if( (p=(i+1)/2) != 0)
     {
       --p;
-      if(elems[i]->time < elems[p]->time)
+      if(Earlier(elems[i],elems[p]))
       {
 	i=p;
 	temp=elems[i];
@@ -378,6 +406,152 @@ void HeapQueue<ITEM>::Delete(ITEM* item)
 }
 
 
+/*
+  DaryHeapQueue: implicit D-ary heap (D=4 by default). Each slot keeps a copy
+  of the event time and insertion order next to the event pointer, so that
+  sifting compares keys stored contiguously instead of dereferencing every
+  child. Ties are broken by insertion order (ITEM::seq, stamped by
+  SelectableQueue), as in the other queues. As in HeapQueue, ITEM::pos holds
+  the slot of the item, which makes Delete() O(log n).
+*/
+
+template < class ITEM, int D = 4 >
+class DaryHeapQueue 
+{
+ public:
+  DaryHeapQueue();
+  ~DaryHeapQueue();
+  void EnQueue(ITEM*);
+  ITEM* DeQueue();
+  void Delete(ITEM*);
+  const char* GetName();
+  ITEM* NextEvent() const { return num_of_elems?elems[0].item:NULL; };
+ private:
+  struct slot_t
+  {
+    typename ITEM::time_type time;
+    unsigned long long seq;
+    ITEM* item;
+  };
+  static bool Earlier(const slot_t& a, const slot_t& b) { return a.time < b.time || (a.time == b.time && a.seq < b.seq); };
+  void SiftDown(int);
+  void PercolateUp(int);
+  void Place(int i, const slot_t& s) { elems[i]=s; s.item->pos=i; };
+
+  slot_t* elems;
+  int num_of_elems;
+  int curr_max;
+  char m_name[32];
+};
+
+template <class ITEM, int D>
+const char* DaryHeapQueue<ITEM,D>::GetName()
+{
+  sprintf(m_name,"DaryHeapQueue (d=%d)",D);
+  return m_name;
+}
+
+template <class ITEM, int D>
+DaryHeapQueue<ITEM,D>::DaryHeapQueue()
+{
+  curr_max=64;
+  elems=new slot_t[curr_max];
+  num_of_elems=0;
+}
+
+template <class ITEM, int D>
+DaryHeapQueue<ITEM,D>::~DaryHeapQueue()
+{
+  delete [] elems;
+}
+
+template <class ITEM, int D>
+void DaryHeapQueue<ITEM,D>::SiftDown(int node)
+{
+  slot_t moving=elems[node];
+  int i=node;
+  for(;;)
+  {
+    int first=D*i+1;
+    if(first>=num_of_elems) break;
+    int last=first+D;
+    if(last>num_of_elems) last=num_of_elems;
+    int best=first;
+    for(int c=first+1;c<last;c++)
+      if(Earlier(elems[c],elems[best]))
+	best=c;
+    if(!Earlier(elems[best],moving)) break;
+    Place(i,elems[best]);
+    i=best;
+  }
+  Place(i,moving);
+}
+
+template <class ITEM, int D>
+void DaryHeapQueue<ITEM,D>::PercolateUp(int node)
+{
+  slot_t moving=elems[node];
+  int i=node;
+  while(i>0)
+  {
+    int p=(i-1)/D;
+    if(!Earlier(moving,elems[p])) break;
+    Place(i,elems[p]);
+    i=p;
+  }
+  Place(i,moving);
+}
+
+template <class ITEM, int D>
+void DaryHeapQueue<ITEM,D>::EnQueue(ITEM* item)
+{
+  if(num_of_elems>=curr_max)
+  {
+    curr_max*=2;
+    slot_t* buffer=new slot_t[curr_max];
+    for(int i=0;i<num_of_elems;i++)
+      buffer[i]=elems[i];
+    delete[] elems;
+    elems=buffer;
+  }
+
+  elems[num_of_elems].time=item->time;
+  elems[num_of_elems].seq=item->seq;
+  elems[num_of_elems].item=item;
+  item->pos=num_of_elems;
+  num_of_elems++;
+  PercolateUp(num_of_elems-1);
+}
+
+template <class ITEM, int D>
+ITEM* DaryHeapQueue<ITEM,D>::DeQueue()
+{
+  if(num_of_elems<=0)return NULL;
+
+  ITEM* item=elems[0].item;
+  num_of_elems--;
+  if(num_of_elems>0)
+  {
+    Place(0,elems[num_of_elems]);
+    SiftDown(0);
+  }
+  return item;
+}
+
+template <class ITEM, int D>
+void DaryHeapQueue<ITEM,D>::Delete(ITEM* item)
+{
+  int i=item->pos;
+
+  num_of_elems--;
+  if(i==num_of_elems) return;
+  Place(i,elems[num_of_elems]);
+  if(i>0 && Earlier(elems[i],elems[(i-1)/D]))
+    PercolateUp(i);
+  else
+    SiftDown(i);
+}
+
 
 #define CQ_MAX_SAMPLES 25
 
@@ -409,6 +583,8 @@ class CalendarQueue
   double last_priority;
   bool resizable;
 
+  // ties are broken by insertion order (ITEM::seq, stamped by SelectableQueue)
+  static bool Earlier(const ITEM* a, const ITEM* b) { return a->time < b->time || (a->time == b->time && a->seq < b->seq); };
   ITEM* m_head;
   char m_name[100];
 };
@@ -536,7 +712,7 @@ ITEM* CalendarQueue<ITEM>::dequeue()
     if(buckets[i]==NULL)
       continue;
     else
-      if(buckets[i]->time<buckets[smallest]->time)
+      if(Earlier(buckets[i],buckets[smallest]))
 	smallest=i;
   }
   ITEM * item=buckets[smallest];
@@ -557,7 +733,7 @@ void CalendarQueue<ITEM>::EnQueue(ITEM* item)
     m_head=item;
     return;
   }
-  if(m_head->time>item->time)
+  if(Earlier(item,m_head))
   {
     enqueue(m_head);
     m_head=item;
@@ -586,7 +762,7 @@ void CalendarQueue<ITEM>::enqueue(ITEM* item)
         
   /*Insert into buckets[i] */
 
-  if(buckets[i]==NULL||item->time<buckets[i]->time)
+  if(buckets[i]==NULL||Earlier(item,buckets[i]))
   {
     item->next=buckets[i];
     buckets[i]=item;
@@ -595,7 +771,7 @@ void CalendarQueue<ITEM>::enqueue(ITEM* item)
   {
 
     ITEM* pos=buckets[i];
-    while(pos->next!=NULL&&item->time>pos->next->time)
+    while(pos->next!=NULL&&Earlier(pos->next,item))
     {
       pos=pos->next;
     }
@@ -722,4 +898,541 @@ double CalendarQueue<ITEM>::NewWidth()
   return avg2;
 }
 
+/*
+  LadderQueue (Tang, Goh and Thng, 2005). Events far in the future are kept
+  unsorted in Top; when Bottom runs dry, Top is spread over a rung of
+  buckets, and any bucket holding more than LQ_THRESHOLD events is spread
+  again over a finer child rung. Only the first small bucket is sorted into
+  Bottom. Events with the same timestamp are never spread: they go to
+  Bottom at once, which suits the bursts produced by the simulator (all
+  receivers reacting to the same transmission, SIFS/DIFS timers, slot
+  aligned backoffs).
+
+  Ties are broken by insertion order (ITEM::seq, stamped by
+  SelectableQueue): simultaneous events come out first-in first-out,
+  whatever rungs they went through.
+
+  Bottom is a sorted list: an event goes to its head or tail in O(1), and
+  otherwise Bottom is spilled into a new rung once it holds more than
+  LQ_THRESHOLD events, which bounds the scan.
+
+  Items are linked through ITEM::next and ITEM::prev, and ITEM::bucket
+  records where the item lives so that Delete() is O(1).
+*/
+
+#define LQ_MAX_RUNGS 8
+#define LQ_THRESHOLD 50
+#define LQ_IN_TOP -1
+#define LQ_IN_BOTTOM -2
+
+template <class ITEM>
+class LadderQueue 
+{
+ public:
+  LadderQueue();
+  void EnQueue(ITEM*);
+  ITEM* DeQueue();
+  void Delete(ITEM*);
+  ITEM* NextEvent() const;
+  const char* GetName();
+ private:
+  struct rung_t
+  {
+    double start;		// time of the first bucket
+    double width;		// bucket width
+    long current;		// first bucket not yet moved to the bottom
+    long count;			// events held by the rung
+    std::vector<ITEM*> buckets;
+    std::vector<long> sizes;
+  };
+  static bool Earlier(const ITEM* a, const ITEM* b) { return a->time < b->time || (a->time == b->time && a->seq < b->seq); };
+  void Push(ITEM*& head, ITEM* item);
+  void Unlink(ITEM*& head, ITEM* item);
+  long BucketOf(const rung_t& r, double time) const;
+  void InsertBottom(ITEM*);
+  bool SpillBottom();
+  void SpawnRung(ITEM* list, long n, double start, double min, double max);
+  void SortIntoBottom(ITEM* list);
+  bool RefillBottom();
+
+  ITEM* m_top;
+  long m_top_count;
+  double m_top_min;
+  double m_top_max;
+  double m_top_start;
+
+  rung_t m_rungs[LQ_MAX_RUNGS];
+  int m_num_rungs;
+  int m_max_rungs_used;
+
+  ITEM* m_bottom;
+  ITEM* m_bottom_tail;
+  long m_bottom_count;
+
+  std::vector<ITEM*> m_scratch;
+  char m_name[64];
+};
+
+template <class ITEM>
+LadderQueue<ITEM>::LadderQueue()
+  : m_top(NULL), m_top_count(0), m_top_min(0.0), m_top_max(0.0), m_top_start(0.0),
+    m_num_rungs(0), m_max_rungs_used(0), m_bottom(NULL), m_bottom_tail(NULL), m_bottom_count(0)
+{
+}
+
+template <class ITEM>
+const char* LadderQueue<ITEM>::GetName()
+{
+  sprintf(m_name,"LadderQueue (max rungs used: %d, threshold: %d)",m_max_rungs_used,LQ_THRESHOLD);
+  return m_name;
+}
+
+template <class ITEM>
+void LadderQueue<ITEM>::Push(ITEM*& head, ITEM* item)
+{
+  item->prev=NULL;
+  item->next=head;
+  if(head!=NULL)head->prev=item;
+  head=item;
+}
+
+template <class ITEM>
+void LadderQueue<ITEM>::Unlink(ITEM*& head, ITEM* item)
+{
+  if(item->prev!=NULL)
+    item->prev->next=item->next;
+  else
+    head=item->next;
+  if(item->next!=NULL)item->next->prev=item->prev;
+}
+
+template <class ITEM>
+long LadderQueue<ITEM>::BucketOf(const rung_t& r, double time) const
+{
+  long b=(long)((time-r.start)/r.width);
+  if(b<r.current) b=r.current;	// rounding at the lower edge
+  if(b>=(long)r.buckets.size()) b=r.buckets.size()-1;
+  return b;
+}
+
+template <class ITEM>
+void LadderQueue<ITEM>::InsertBottom(ITEM* item)
+{
+  // scan from the tail: new events are usually the latest ones (an event
+  // earlier than the head is put first right away)
+  ITEM* i=m_bottom_tail;
+  if(m_bottom!=NULL && Earlier(item,m_bottom))
+    i=NULL;
+  while(i!=NULL && Earlier(item,i))
+    i=i->prev;
+  item->prev=i;
+  if(i==NULL)
+  {
+    item->next=m_bottom;
+    m_bottom=item;
+  }
+  else
+  {
+    item->next=i->next;
+    i->next=item;
+  }
+  if(item->next!=NULL)
+    item->next->prev=item;
+  else
+    m_bottom_tail=item;
+  item->bucket=LQ_IN_BOTTOM;
+  m_bottom_count++;
+}
+
+// moves a large Bottom to a new rung, so that inserting into it stays cheap
+template <class ITEM>
+bool LadderQueue<ITEM>::SpillBottom()
+{
+  if(m_bottom_count<=LQ_THRESHOLD || m_num_rungs>=LQ_MAX_RUNGS
+     || m_bottom->time==m_bottom_tail->time)
+    return false;
+  ITEM* list=m_bottom;
+  long n=m_bottom_count;
+  double min=m_bottom->time,max=m_bottom_tail->time;
+  m_bottom=NULL;
+  m_bottom_tail=NULL;
+  m_bottom_count=0;
+  // every event of Bottom is earlier than the buckets left in the other rungs
+  SpawnRung(list,n,min,min,max);
+  return true;
+}
+
+template <class ITEM>
+void LadderQueue<ITEM>::EnQueue(ITEM* item)
+{
+  if(item->time >= m_top_start || (m_num_rungs==0 && m_bottom==NULL))
+  {
+    if(m_top_count==0 || item->time < m_top_min) m_top_min=item->time;
+    if(m_top_count==0 || item->time > m_top_max) m_top_max=item->time;
+    Push(m_top,item);
+    item->bucket=LQ_IN_TOP;
+    m_top_count++;
+    return;
+  }
+
+  for(int r=0;r<m_num_rungs;r++)
+  {
+    rung_t& rung=m_rungs[r];
+    // an exhausted rung is only popped on the next refill, skip it
+    if(rung.current<(long)rung.buckets.size() && item->time >= rung.start+rung.current*rung.width)
+    {
+      long b=BucketOf(rung,item->time);
+      Push(rung.buckets[b],item);
+      rung.sizes[b]++;
+      rung.count++;
+      item->bucket=b*LQ_MAX_RUNGS+r;
+      return;
+    }
+  }
+
+  // an event going to neither end of a large Bottom spills it into a new rung
+  if(m_bottom!=NULL && Earlier(m_bottom,item) && Earlier(item,m_bottom_tail) && SpillBottom())
+  {
+    EnQueue(item);
+    return;
+  }
+  InsertBottom(item);
+}
+
+template <class ITEM>
+void LadderQueue<ITEM>::SpawnRung(ITEM* list, long n, double start, double min, double max)
+{
+  rung_t& rung=m_rungs[m_num_rungs];
+  long num_buckets=n+1;
+  rung.start=start;
+  rung.width=(max-start)/n;
+  if(rung.width<=0.0) rung.width=(max-min)/n;
+  rung.current=0;
+  rung.count=0;
+  rung.buckets.assign(num_buckets,(ITEM*)NULL);
+  rung.sizes.assign(num_buckets,0);
+  int r=m_num_rungs++;
+  if(m_num_rungs>m_max_rungs_used) m_max_rungs_used=m_num_rungs;
+
+  ITEM* next;
+  for(ITEM* i=list;i!=NULL;i=next)
+  {
+    next=i->next;
+    long b=BucketOf(rung,i->time);
+    Push(rung.buckets[b],i);
+    rung.sizes[b]++;
+    rung.count++;
+    i->bucket=b*LQ_MAX_RUNGS+r;
+  }
+}
+
+// sorts a list of events by time and insertion order and appends it to the (empty) Bottom
+template <class ITEM>
+void LadderQueue<ITEM>::SortIntoBottom(ITEM* list)
+{
+  m_scratch.clear();
+  for(ITEM* i=list;i!=NULL;i=i->next) m_scratch.push_back(i);
+  std::sort(m_scratch.begin(),m_scratch.end(),Earlier);
+  for(unsigned long k=0;k<m_scratch.size();k++) InsertBottom(m_scratch[k]);
+}
+
+template <class ITEM>
+bool LadderQueue<ITEM>::RefillBottom()
+{
+  for(;;)
+  {
+    if(m_num_rungs==0)
+    {
+      if(m_top==NULL) return false;
+      ITEM* list=m_top;
+      long n=m_top_count;
+      double min=m_top_min,max=m_top_max;
+      m_top=NULL;
+      m_top_count=0;
+      if(max==min)
+      {
+	// a single timestamp, nothing to spread
+	m_top_start=max;
+	SortIntoBottom(list);
+	return true;
+      }
+      SpawnRung(list,n,min,min,max);
+      const rung_t& rung=m_rungs[0];
+      m_top_start=rung.start+rung.buckets.size()*rung.width;
+    }
+
+    rung_t& rung=m_rungs[m_num_rungs-1];
+    long num_buckets=rung.buckets.size();
+    while(rung.current<num_buckets && rung.buckets[rung.current]==NULL)
+      rung.current++;
+    if(rung.current>=num_buckets)
+    {
+      m_num_rungs--;
+      continue;
+    }
+
+    long b=rung.current;
+    ITEM* list=rung.buckets[b];
+    long n=rung.sizes[b];
+    rung.buckets[b]=NULL;
+    rung.sizes[b]=0;
+    rung.count-=n;
+    rung.current++;
+
+    double min=list->time,max=list->time;
+    for(ITEM* i=list->next;i!=NULL;i=i->next)
+    {
+      if(i->time<min) min=i->time;
+      if(i->time>max) max=i->time;
+    }
+    double bucket_start=rung.start+b*rung.width;
+
+    if(n>LQ_THRESHOLD && max>min && m_num_rungs<LQ_MAX_RUNGS)
+    {
+      SpawnRung(list,n,bucket_start<min?bucket_start:min,min,max);
+      continue;
+    }
+
+    // small bucket (or too deep): sort it into the bottom
+    SortIntoBottom(list);
+    return true;
+  }
+}
+
+template <class ITEM>
+ITEM* LadderQueue<ITEM>::DeQueue()
+{
+  if(m_bottom==NULL && !RefillBottom()) return NULL;
+  ITEM* item=m_bottom;
+  m_bottom=item->next;
+  if(m_bottom!=NULL)
+    m_bottom->prev=NULL;
+  else
+    m_bottom_tail=NULL;
+  m_bottom_count--;
+  item->next=NULL;
+  return item;
+}
+
+template <class ITEM>
+ITEM* LadderQueue<ITEM>::NextEvent() const
+{
+  if(m_bottom==NULL && !const_cast<LadderQueue<ITEM>*>(this)->RefillBottom()) return NULL;
+  return m_bottom;
+}
+
+template <class ITEM>
+void LadderQueue<ITEM>::Delete(ITEM* item)
+{
+  if(item->bucket==LQ_IN_TOP)
+  {
+    // the cached min/max stay valid bounds
+    Unlink(m_top,item);
+    m_top_count--;
+  }
+  else if(item->bucket==LQ_IN_BOTTOM)
+  {
+    if(item==m_bottom_tail) m_bottom_tail=item->prev;
+    Unlink(m_bottom,item);
+    m_bottom_count--;
+  }
+  else
+  {
+    rung_t& rung=m_rungs[item->bucket%LQ_MAX_RUNGS];
+    long b=item->bucket/LQ_MAX_RUNGS;
+    Unlink(rung.buckets[b],item);
+    rung.sizes[b]--;
+    rung.count--;
+  }
+}
+
+
+/*
+  SelectableQueue: forwards every operation to the queue picked with Select()
+  and keeps a few counters that are reported at the end of the simulation.
+  SimpleQueue remains the default so that existing results are reproduced.
+  Drain() and Restore() take out and put back all the pending items (e.g. to
+  save a snapshot) without touching the counters.
+*/
+
+enum {
+  EVENT_QUEUE_SIMPLE,
+  EVENT_QUEUE_HEAP,
+  EVENT_QUEUE_DARY_HEAP,
+  EVENT_QUEUE_CALENDAR,
+  EVENT_QUEUE_LADDER
+};
+
+template <class ITEM>
+class SelectableQueue 
+{
+ public:
+  SelectableQueue() : m_type(EVENT_QUEUE_SIMPLE), m_size(0), m_peak_size(0),
+    m_enqueued(0), m_dequeued(0), m_deleted(0), m_seq(0) {};
+  bool Select(const char*);
+  bool Select(int);
+  int Type() const { return m_type; };
+  void EnQueue(ITEM*);
+  ITEM* DeQueue();
+  void Delete(ITEM*);
+  ITEM* NextEvent() const;
+  void Drain(std::vector<ITEM*>&);
+  void Restore(std::vector<ITEM*>&);
+  const char* GetName();
+  long Size() const { return m_size; };
+  long PeakSize() const { return m_peak_size; };
+  long Enqueued() const { return m_enqueued; };
+  long Dequeued() const { return m_dequeued; };
+  long Deleted() const { return m_deleted; };
+ private:
+  int m_type;
+  long m_size;
+  long m_peak_size;
+  long m_enqueued;
+  long m_dequeued;
+  long m_deleted;
+  unsigned long long m_seq;	// insertion order of the next item
+
+  SimpleQueue<ITEM> m_simple;
+  HeapQueue<ITEM> m_heap;
+  DaryHeapQueue<ITEM> m_dary;
+  CalendarQueue<ITEM> m_calendar;
+  LadderQueue<ITEM> m_ladder;
+};
+
+template <class ITEM>
+bool SelectableQueue<ITEM>::Select(const char* name)
+{
+  int type;
+  if(strcmp(name,"simple")==0) type=EVENT_QUEUE_SIMPLE;
+  else if(strcmp(name,"heap")==0) type=EVENT_QUEUE_HEAP;
+  else if(strcmp(name,"dary")==0) type=EVENT_QUEUE_DARY_HEAP;
+  else if(strcmp(name,"calendar")==0) type=EVENT_QUEUE_CALENDAR;
+  else if(strcmp(name,"ladder")==0) type=EVENT_QUEUE_LADDER;
+  else return false;
+  return Select(type);
+}
+
+template <class ITEM>
+bool SelectableQueue<ITEM>::Select(int type)
+{
+  // events cannot be moved across queues, the selection must come first
+  if(m_size!=0) return false;
+  m_type=type;
+  return true;
+}
+
+template <class ITEM>
+const char* SelectableQueue<ITEM>::GetName()
+{
+  switch(m_type)
+  {
+  case EVENT_QUEUE_HEAP: return m_heap.GetName();
+  case EVENT_QUEUE_DARY_HEAP: return m_dary.GetName();
+  case EVENT_QUEUE_CALENDAR: return m_calendar.GetName();
+  case EVENT_QUEUE_LADDER: return m_ladder.GetName();
+  default: return m_simple.GetName();
+  }
+}
+
+template <class ITEM>
+void SelectableQueue<ITEM>::EnQueue(ITEM* item)
+{
+  // every backend takes simultaneous items out in insertion order
+  item->seq=m_seq++;
+  switch(m_type)
+  {
+  case EVENT_QUEUE_HEAP: m_heap.EnQueue(item); break;
+  case EVENT_QUEUE_DARY_HEAP: m_dary.EnQueue(item); break;
+  case EVENT_QUEUE_CALENDAR: m_calendar.EnQueue(item); break;
+  case EVENT_QUEUE_LADDER: m_ladder.EnQueue(item); break;
+  default: m_simple.EnQueue(item); break;
+  }
+  m_enqueued++;
+  if(++m_size>m_peak_size) m_peak_size=m_size;
+}
+
+template <class ITEM>
+ITEM* SelectableQueue<ITEM>::DeQueue()
+{
+  ITEM* item;
+  switch(m_type)
+  {
+  case EVENT_QUEUE_HEAP: item=m_heap.DeQueue(); break;
+  case EVENT_QUEUE_DARY_HEAP: item=m_dary.DeQueue(); break;
+  case EVENT_QUEUE_CALENDAR: item=m_calendar.DeQueue(); break;
+  case EVENT_QUEUE_LADDER: item=m_ladder.DeQueue(); break;
+  default: item=m_simple.DeQueue(); break;
+  }
+  if(item!=NULL)
+  {
+    m_dequeued++;
+    m_size--;
+  }
+  return item;
+}
+
+template <class ITEM>
+void SelectableQueue<ITEM>::Delete(ITEM* item)
+{
+  switch(m_type)
+  {
+  case EVENT_QUEUE_HEAP: m_heap.Delete(item); break;
+  case EVENT_QUEUE_DARY_HEAP: m_dary.Delete(item); break;
+  case EVENT_QUEUE_CALENDAR: m_calendar.Delete(item); break;
+  case EVENT_QUEUE_LADDER: m_ladder.Delete(item); break;
+  default: m_simple.Delete(item); break;
+  }
+  m_deleted++;
+  m_size--;
+}
+
+template <class ITEM>
+ITEM* SelectableQueue<ITEM>::NextEvent() const
+{
+  switch(m_type)
+  {
+  case EVENT_QUEUE_HEAP: return m_heap.NextEvent();
+  case EVENT_QUEUE_DARY_HEAP: return m_dary.NextEvent();
+  case EVENT_QUEUE_CALENDAR: return m_calendar.NextEvent();
+  case EVENT_QUEUE_LADDER: return m_ladder.NextEvent();
+  default: return m_simple.NextEvent();
+  }
+}
+
+// takes out every pending item in processing order
+template <class ITEM>
+void SelectableQueue<ITEM>::Drain(std::vector<ITEM*>& items)
+{
+  items.clear();
+  while(NextEvent()!=NULL)
+  {
+    items.push_back(DeQueue());
+    m_dequeued--;
+  }
+}
+
+// puts back the items taken out by Drain() into the empty queue, stamped again
+// in processing order; the simple queue relinks them, the others enqueue them
+template <class ITEM>
+void SelectableQueue<ITEM>::Restore(std::vector<ITEM*>& items)
+{
+  if(m_type==EVENT_QUEUE_SIMPLE)
+  {
+    for(unsigned int i=0;i<items.size();i++)
+      items[i]->seq=m_seq++;
+    m_simple.Restore(items);
+    m_size=items.size();
+  }
+  else
+  {
+    for(unsigned int i=0;i<items.size();i++)
+    {
+      EnQueue(items[i]);
+      m_enqueued--;
+    }
+  }
+  if(m_size>m_peak_size) m_peak_size=m_size;
+}
+
 #endif /*PRIORITY_QUEUE_H*/
@@ -0,0 +1,156 @@
+/************************************************************************
+ * CostSnapshot is a binary file holding the state of a simulation at a
+ * given time. Saving and loading share the same code: every object
+ * provides a Checkpoint(CostSnapshot&) method that passes its members to
+ * Value(), Array() and Objects(), which write them when saving and
+ * overwrite them when loading.
+ *
+ * Objects are not created from the snapshot: the simulation is built
+ * and started again from the same inputs (which allocates every array
+ * with its size) and then its state is overwritten. Hence a snapshot
+ * can only be loaded by the same binary with the same inputs, which is
+ * checked with Check() on a few counts. Pointers are never written.
+ ************************************************************************/
+
+#ifndef COST_SNAPSHOT_H
+#define COST_SNAPSHOT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <map>
+#include <deque>
+
+#define COST_SNAPSHOT_VERSION 6
+
+class CostSnapshot
+{
+ public:
+  CostSnapshot() : m_file( NULL), m_loading( false) {}
+  ~CostSnapshot() { Close(); }
+  void Open( const char* filename, bool loading);
+  void Close();
+  bool Loading() const { return m_loading; }
+
+  // plain values (numbers and structures without pointers)
+  template <class T> void Value( T& value) { Bytes( &value, sizeof(T)); }
+  void Value( std::string& value);
+  template <class K, class V> void Value( std::map<K,V>& value);
+  // arrays already allocated by their owner with the given size
+  template <class T> void Array( T* array, int size);
+  // objects providing their own Checkpoint()
+  template <class T> void Objects( T* array, int size);
+  template <class T> void Objects( std::deque<T>& container);
+  // both sides must agree on a count (e.g. number of components)
+  void Check( long count, const char* what);
+
+ private:
+  void Bytes( void* data, size_t size);
+  FILE* m_file;
+  bool m_loading;
+};
+
+void CostSnapshot::Open( const char* filename, bool loading)
+{
+  m_loading = loading;
+  m_file = fopen( filename, loading ? "rb" : "wb");
+  if( m_file == NULL)
+  {
+    printf( "Error: snapshot '%s' cannot be %s\n", filename, loading ? "read" : "written");
+    exit(-1);
+  }
+}
+
+void CostSnapshot::Close()
+{
+  if( m_file != NULL)
+    fclose( m_file);
+  m_file = NULL;
+}
+
+void CostSnapshot::Bytes( void* data, size_t size)
+{
+  size_t done = m_loading ? fread( data, 1, size, m_file) : fwrite( data, 1, size, m_file);
+  if( done != size)
+  {
+    printf( "Error: snapshot %s\n", m_loading ? "truncated" : "could not be written");
+    exit(-1);
+  }
+}
+
+void CostSnapshot::Value( std::string& value)
+{
+  long size = value.size();
+  Value( size);
+  if( m_loading)
+    value.resize( size);
+  if( size > 0)
+    Bytes( &value[0], size);
+}
+
+template <class K, class V>
+void CostSnapshot::Value( std::map<K,V>& value)
+{
+  long size = value.size();
+  Value( size);
+  if( m_loading)
+  {
+    value.clear();
+    for( long i = 0; i < size; i++)
+    {
+      K key;
+      V item;
+      Value( key);
+      Value( item);
+      value[key] = item;
+    }
+  }
+  else
+  {
+    for( typename std::map<K,V>::iterator iter = value.begin(); iter != value.end(); iter++)
+    {
+      K key = iter->first;
+      Value( key);
+      Value( iter->second);
+    }
+  }
+}
+
+template <class T>
+void CostSnapshot::Array( T* array, int size)
+{
+  if( size > 0)
+    Bytes( array, sizeof(T) * size);
+}
+
+template <class T>
+void CostSnapshot::Objects( T* array, int size)
+{
+  for( int i = 0; i < size; i++)
+    array[i].Checkpoint( *this);
+}
+
+template <class T>
+void CostSnapshot::Objects( std::deque<T>& container)
+{
+  long size = container.size();
+  Value( size);
+  if( m_loading)
+    container.resize( size);
+  for( long i = 0; i < size; i++)
+    container[i].Checkpoint( *this);
+}
+
+void CostSnapshot::Check( long count, const char* what)
+{
+  long saved = count;
+  Value( saved);
+  if( saved != count)
+  {
+    printf( "Error: snapshot does not match this simulation (%s: %ld saved, %ld now)\n",
+	    what, saved, count);
+    exit(-1);
+  }
+}
+
+#endif /* COST_SNAPSHOT_H */
@@ -70,6 +70,7 @@ class MlModel {
 
 		// Generic
 		int agent_id;					///> ID of the agent calling the ML method
+		int seed;						///> Simulation seed (key of the random streams)
 		int learning_mechanism;			///> Index of the learning mechanism employed
 		int action_selection_strategy;	///> Index of the chosen action-selection strategy
 
@@ -203,6 +204,7 @@ class MlModel {
 				/* Multi-Armed Bandits */
 				case MULTI_ARMED_BANDITS: {
 					mab_agent.agent_id = agent_id;
+					mab_agent.seed = seed;
 					mab_agent.save_logs = save_logs;
 					mab_agent.print_logs = print_logs;
 					mab_agent.action_selection_strategy = action_selection_strategy;
@@ -231,6 +233,37 @@ class MlModel {
 			}
 		}
 
+		/**
+		* Save or load the state of the learning mechanism (RTOT keeps no state between iterations)
+		* @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+		*/
+		void Checkpoint(CostSnapshot &snapshot) {
+			switch(learning_mechanism) {
+				case MULTI_ARMED_BANDITS: {
+					mab_agent.Checkpoint(snapshot);
+					break;
+				}
+				case CENTRALIZED_ACTION_BANNING: {
+					printf("[ML MODEL] ERROR: snapshots of the centralized action-banning are not supported\n");
+					exit(EXIT_FAILURE);
+					break;
+				}
+				default: {
+					// Nothing to be saved
+					break;
+				}
+			}
+		}
+
+		/**
+		* Change the action-selection strategy (e.g., by the variants of a sweep)
+		* @param "strategy" [type int]: index of the new action-selection strategy
+		*/
+		void SetActionSelectionStrategy(int strategy) {
+			action_selection_strategy = strategy;
+			mab_agent.action_selection_strategy = strategy;
+		}
+
 		/*************************/
 		/*************************/
 		/*  PRINT/WRITE METHODS  */
@@ -50,6 +50,8 @@
  */
 
 #include "../../list_of_macros.h"
+#include "../../structures/random_stream.h"
+#include "../../COST/snapshot.h"
 
 #ifndef _AUX_MABS_
 #define _AUX_MABS_
@@ -65,6 +67,7 @@ class MultiArmedBandit {
 
         // General information
 		int agent_id;						///> Identified of the agent using MABs
+		int seed;							///> Simulation seed (key of the random stream)
 		int num_arms;					///> Number of actions
 		int action_selection_strategy;		///> Index of the chosen action-selection strategy
 
@@ -83,6 +86,14 @@ class MultiArmedBandit {
 		double initial_epsilon;		///> Initial epsilon parameter (exploration coefficient)
 		double epsilon;				///> Epsilon parameter (exploration coefficient)
 
+		// Thompson sampling specific variables (state of the polar method, kept per bandit)
+		double gauss_V1;			///> First uniform sample in [-1,1]
+		double gauss_V2;			///> Second uniform sample in [-1,1]
+		double gauss_S;				///> Squared norm of (V1,V2)
+		int gauss_phase;			///> Whether a new pair of samples must be drawn (0) or not (1)
+
+		RandomStream rng_learning;	///> Action selection draws (keyed by seed and agent id)
+
 	// Methods
 	public:
 
@@ -182,14 +193,14 @@ class MultiArmedBandit {
 		 */
 		int PickArmEgreedy(int num_arms, double *reward_per_arm, double epsilon, int *available_arms) {
 
-			double rand_number = ((double) rand() / (RAND_MAX));
+			double rand_number = rng_learning.Uniform();
 			int action_ix;
 
 			if (rand_number < epsilon) { //EXPLORE
-				action_ix = rand() % num_arms;
+				action_ix = rng_learning.Uniform(num_arms);
 				int counter(0);
 				while (!available_arms[action_ix]) {
-					action_ix = rand() % num_arms;
+					action_ix = rng_learning.Uniform(num_arms);
 					if(counter > 1000) break; // To avoid getting stuck (none of the actions is available)
 				}
 //				printf("EXPLORE: Selected action %d (available = %d)\n", action_ix, available_arms[action_ix]);
@@ -215,22 +226,20 @@ class MultiArmedBandit {
 		/*******************************/
 
 		double gaussrand(double mean, double std){
-			static double V1, V2, S;
-			static int phase = 0;
 			double X;
-			if(phase == 0) {
+			if(gauss_phase == 0) {
 				do {
-					double U1 = (double)rand() /  RAND_MAX;
-					double U2 = (double)rand() /  RAND_MAX;
-					V1 = 2*U1 - 1;
-					V2 = 2*U2 - 1;
-					S = V1 * V1 + V2 * V2;
-				} while (S >= 1 || S == 0);
-				X = (V1 * sqrt(-2 * log(S) / S)) * std + mean;
+					double U1 = rng_learning.Uniform();
+					double U2 = rng_learning.Uniform();
+					gauss_V1 = 2*U1 - 1;
+					gauss_V2 = 2*U2 - 1;
+					gauss_S = gauss_V1 * gauss_V1 + gauss_V2 * gauss_V2;
+				} while (gauss_S >= 1 || gauss_S == 0);
+				X = (gauss_V1 * sqrt(-2 * log(gauss_S) / gauss_S)) * std + mean;
 			} else {
-				X = (V1 * sqrt(-2 * log(S) / S)) * std + mean;
+				X = (gauss_V1 * sqrt(-2 * log(gauss_S) / gauss_S)) * std + mean;
 			}
-			phase = 1 - phase;
+			gauss_phase = 1 - gauss_phase;
 			return X;
 		}
 
@@ -383,6 +392,8 @@ class MultiArmedBandit {
 			epsilon = initial_epsilon;
 			initial_reward = 0;
 			num_iterations = 1;
+			gauss_phase = 0;
+			rng_learning.Initialize(seed, agent_id, RNG_STREAM_LEARNING);
 			// Initialize the rewards assigned to each arm
 			reward_per_arm = new double[num_arms];
 			cumulative_reward_per_arm = new double[num_arms];
@@ -399,6 +410,25 @@ class MultiArmedBandit {
 			}
 		}
 
+		/**
+		 * Save or load the statistics of the arms and the state of the action selection
+		 * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+		 */
+		void Checkpoint(CostSnapshot &snapshot){
+			snapshot.Value(num_iterations);
+			snapshot.Array(reward_per_arm, num_arms);
+			snapshot.Array(cumulative_reward_per_arm, num_arms);
+			snapshot.Array(average_reward_per_arm, num_arms);
+			snapshot.Array(estimated_reward_per_arm, num_arms);
+			snapshot.Array(times_arm_has_been_selected, num_arms);
+			snapshot.Value(epsilon);
+			snapshot.Value(gauss_V1);
+			snapshot.Value(gauss_V2);
+			snapshot.Value(gauss_S);
+			snapshot.Value(gauss_phase);
+			snapshot.Value(rng_learning);
+		}
+
 };
 
 #endif
@@ -195,6 +195,7 @@
 #define PATHLOSS_INROOM_LOSS_5250KHZ	10	///> In-room LoS for 5.25 GHz
 #define PATHLOSS_ROOM_CORRIDOR_5250KHZ	11	///> Room-corridor for 5.25 GHz
 #define PATHLOSS_TMB	12					///> 11ax for 5 GHz
+#define PATH_LOSS_MEASURED	13				///> Measured path loss per link (path_loss_matrix file in config_models)
 
 #define PATH_LOSS_DISTANCE_BREAKPOINT_CHANNEL_B	5	///> Breakpoint distance for channel model B [m]
 
@@ -221,6 +222,10 @@
 #define ADJACENT_CHANNEL_NONE		0	///> No adjacent channel interference
 #define ADJACENT_CHANNEL_BOUNDARY	1	///> (RECOMMENDED) Boundary adjacent channel interference: only boundary channels (left and right) used in the TX affect the rest of channels
 #define ADJACENT_CHANNEL_EXTREME	2	///> Extreme adjacent channel interference: ALL channels used in the TX affect the rest of channels
+#define ADJACENT_CHANNEL_LOSS_DB	20	///> Power lost per channel of distance by the adjacent channel interference [dB]
+
+// Power sensed
+#define CHANNEL_POWER_RECOMPUTE_UPDATES	1024	///> Updates of the power sensed after which it is recomputed from the transmissions sensed
 
 // Traffic model
 #define TRAFFIC_FULL_BUFFER						0	///> Transmitters always have packets to transmit
@@ -249,6 +254,21 @@
 #define BACKOFF_SLOTTED		0
 #define BACKOFF_CONTINUOUS	1
 
+// Random number streams (purpose of each stream owned by a node, traffic generator or agent)
+#define RNG_STREAM_BACKOFF			0	///> Backoff slots
+#define RNG_STREAM_TRAFFIC			1	///> Packet generation times
+#define RNG_STREAM_PACKET_LOSS		2	///> Packet error rate draws
+#define RNG_STREAM_CHANNEL_BONDING	3	///> Probabilistic channel bonding
+#define RNG_STREAM_SHADOWING		4	///> Shadowing and obstacles of the path loss models
+#define RNG_STREAM_DESTINATION		5	///> Destination STA of each transmission
+#define RNG_STREAM_START			6	///> Random offset of the first backoff
+#define RNG_STREAM_LEARNING			7	///> Action selection of the learning modules
+
+// Parameter changed by the variants of a sweep (each variant is a child process forked at the sweep time)
+#define SWEEP_TRAFFIC_LOAD		0	///> Traffic load of every traffic generator [packets/s]
+#define SWEEP_DCB_POLICY		1	///> Channel bonding model of every node
+#define SWEEP_AGENT_STRATEGY	2	///> Action-selection strategy of every agent
+
 /* *********************
  * * System parameters *
  * *********************
@@ -259,6 +279,8 @@
 #define NUM_CHANNELS_KOMONDOR	8   ///> Total number of frequency channels
 #define CHANNEL_BW_MHZ			20	///> Bandwidth of a basic channel [MHz]
 #define NOISE_LEVEL_DBM			-95	///> Noise level [dBm]
+#define INTERFERENCE_ISLAND_MARGIN_DB	30	///> Power this far below the noise does not link two nodes in the same interference island [dB]
+#define CONNECTION_MARGIN_DB	30	///> Default margin below the noise under which transmissions are not delivered to a node [dB]
 #define ANTENNA_RX_GAIN_DB 		0	///> Antenna receiption gain [dB]
 #define ANTENNA_TX_GAIN_DB 		0	///> Antenna transmission gain [dB]
 
@@ -454,6 +476,9 @@
 #define FILE_TYPE_NODES			1
 #define FILE_NAME_CODE_NODES	"nodes"
 
+// System configuration file (config_models): index of the parameter among the non-comment lines
+#define IX_CONFIG_PATH_LOSS_MATRIX	7
+
 // Nodes file
 #define IX_NODE_CODE				1
 #define IX_NODE_TYPE				2
@@ -77,12 +77,14 @@ component Agent : public TypeII{
 		void Setup();
 		void Start();
 		void Stop();
+		void Checkpoint(CostSnapshot &snapshot);
 
 		// Generic
 		void InitializeAgent();
         void InitializeMlPipeline();
 		void InitializePreProcessor();
 		void InitializeMlModel();
+		void SetActionSelectionStrategy(int strategy);
 
 		// Communication with AP
 		void RequestInformationToAp();
@@ -110,6 +112,7 @@ component Agent : public TypeII{
 
 		// Specific to each agent
 		int agent_id; 				///> Node identifier
+		int seed;					///> Simulation seed (key of the random streams)
 		int agent_centralized;		///> Indicates the mode of the agent (DECENTRALIZED; COOPERATIVE; CENTRALIZED)
 		std::string wlan_code;		///> WLAN code to which the agent belongs
 		int wlan_id;                ///> WLAN identifier to which the agent belongs
@@ -251,6 +254,39 @@ void Agent :: Stop(){
 	if(save_agent_logs) fclose(agent_logger.file);
 };
 
+/**
+ * Checkpoint(): save or load the learning state of the agent (the rest is rebuilt from the input)
+ * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+ */
+void Agent :: Checkpoint(CostSnapshot &snapshot){
+	snapshot.Check(num_arms, "number of actions");
+	// Reports
+	performance.Checkpoint(snapshot);
+	configuration.Checkpoint(snapshot);
+	new_configuration.Checkpoint(snapshot);
+	configuration_from_controller.Checkpoint(snapshot);
+	snapshot.Value(ml_output);
+	snapshot.Value(processed_configuration);
+	snapshot.Value(processed_reward);
+	snapshot.Value(processed_reward_cc);
+	// Actions and ML model
+	snapshot.Objects(actions, num_arms);
+	snapshot.Array(list_of_available_actions, num_arms);
+	ml_model.Checkpoint(snapshot);
+	snapshot.Value(learning_allowed);
+	snapshot.Value(flag_compute_new_configuration);
+	// Interaction with the CC
+	snapshot.Value(controller_on);
+	snapshot.Value(type_of_reward);
+	snapshot.Value(time_between_requests);
+	snapshot.Value(automatic_forward_enabled);
+	snapshot.Value(flag_request_from_controller);
+	snapshot.Value(flag_information_available);
+	// Auxiliary
+	snapshot.Value(num_requests);
+	snapshot.Value(initial_reward);
+};
+
 /***************************/
 /***************************/
 /*  AP-AGENT COMMUNICATION */
@@ -318,7 +354,7 @@ void Agent :: InportReceivingInformationFromAp(Configuration &received_configura
 
 	// Compute a new configuration (if necessary)
 	if (learning_mechanism == MONITORING_ONLY) {
-		trigger_request_information_to_ap.Set(FixTimeOffset(SimTime() + time_between_requests,13,12));
+		trigger_request_information_to_ap.Set(SimTime() + time_between_requests);
 	} else {
 		ComputeNewConfiguration();
 	}
@@ -346,8 +382,8 @@ void Agent :: SendNewConfigurationToAp(Configuration &configuration_to_send){
 
 	// Set trigger for next request in case of being an independent agent (not controlled by a central entity)
 	LOGS(save_agent_logs, agent_logger.file, "%.15f;A%d;%s;%s Next request to be sent at %f\n",
-		SimTime(), agent_id, LOG_C00, LOG_LVL2, FixTimeOffset(SimTime() + time_between_requests,13,12));
-	trigger_request_information_to_ap.Set(FixTimeOffset(SimTime() + time_between_requests,13,12));
+		SimTime(), agent_id, LOG_C00, LOG_LVL2, RoundToSimTime(SimTime() + time_between_requests));
+	trigger_request_information_to_ap.Set(SimTime() + time_between_requests);
 	flag_compute_new_configuration = true;
 
 };
@@ -387,7 +423,7 @@ void Agent :: InportReceiveCommandFromController(int destination_agent_id, int c
 					ForwardInformationToController();
 				} else {
 					// Request information to the AP (trigger = 0)
-					trigger_request_information_to_ap.Set(FixTimeOffset(SimTime(),13,12));
+					trigger_request_information_to_ap.Set(SimTime());
 					flag_request_from_controller = true;
 				}
 				break;
@@ -570,7 +606,7 @@ void Agent :: ComputeNewConfiguration(){
 			// *** We generate here the first request in order to obtain the AP's configuration
 			// TODO: add an activation time, to be introduced by the user in the agent's configuration file
 			double extra_wait_test = 0.005 * (double) agent_id;
-			trigger_request_information_to_ap.Set(FixTimeOffset(SimTime() + time_between_requests + extra_wait_test,13,12));
+			trigger_request_information_to_ap.Set(SimTime() + time_between_requests + extra_wait_test);
 		}
 
 	} else {
@@ -672,6 +708,7 @@ void Agent :: InitializePreProcessor() {
 void Agent :: InitializeMlModel() {
 	// Agent information
 	ml_model.agent_id = agent_id;
+	ml_model.seed = seed;
 	ml_model.num_stas = num_stas;
 	// ML model information
 	ml_model.learning_mechanism = learning_mechanism;
@@ -689,6 +726,15 @@ void Agent :: InitializeMlModel() {
 	ml_model.InitializeVariables();
 }
 
+/**
+ * Change the action-selection strategy of the agent and its ML model
+ * @param "strategy" [type int]: index of the new action-selection strategy
+ */
+void Agent :: SetActionSelectionStrategy(int strategy) {
+	action_selection_strategy = strategy;
+	ml_model.SetActionSelectionStrategy(strategy);
+}
+
 /******************************/
 /******************************/
 /*  PRINT/WRITE INFORMATION   */
@@ -81,6 +81,7 @@ component CentralController : public TypeII{
 		void Setup();
 		void Start();
 		void Stop();
+		void Checkpoint(CostSnapshot &snapshot);
 
 		// Generic
 		void InitializeCentralController();
@@ -130,6 +131,7 @@ component CentralController : public TypeII{
 		int total_nodes_number;			///> Number of nodes
 		int *num_arms_per_agent;		///> Array containing the number of actions available to each agent
 		int max_number_of_actions;		///> Maximum number of actions available for all the agents (for generating data structures)
+		int seed;						///> Simulation seed (key of the random streams)
 
 		// Reward and ML method types
 		int type_of_reward;				///> Type of reward
@@ -249,6 +251,18 @@ void CentralController :: Stop() {
 
 };
 
+/**
+ * Checkpoint(): an inactive CC has no state to be saved
+ * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+ */
+void CentralController :: Checkpoint(CostSnapshot &snapshot) {
+	snapshot.Check(controller_on, "central controller activity");
+	if (controller_on) {
+		printf("[CC] ERROR: snapshots of an active central controller are not supported\n");
+		exit(EXIT_FAILURE);
+	}
+};
+
 /**************************/
 /**************************/
 /*  CONTROLLER'S ACTIVITY */
@@ -265,7 +279,7 @@ void CentralController :: StartCcActivity() {
         SendCommandToAllAgents(COMMUNICATION_UPON_TRIGGER, configuration_array);    // TODO: based on the intent for the CC, decide to use triggers or not (now it is hardcoded)
         // Generate the time trigger for the first request
         if (time_between_requests > 0) {
-            trigger_request_information_to_agents.Set(FixTimeOffset(SimTime() + time_between_requests, 13, 12));
+            trigger_request_information_to_agents.Set(SimTime() + time_between_requests);
         } else {
             // TODO: [Idea] when "time_between_requests" is negative, apply the ML method after the simulation ends (batch learning)
         }
@@ -458,7 +472,7 @@ void CentralController :: InportReceivingInformationFromAgent(int agent_id,
 			GenerateClusters(agent_id, performance_array[agent_id], configuration_array[agent_id]);
 			// Once all the information is available, compute a new configuration according to the updated rewards
 			if (counter_responses_received == agents_number) {
-				trigger_apply_ml_method.Set(FixTimeOffset(SimTime(), 13, 12));
+				trigger_apply_ml_method.Set(SimTime());
 				counter_responses_received = 0;
 			}
 			break;
@@ -509,7 +523,7 @@ void CentralController :: ApplyMlMethod(trigger_t &){
 	}
 
 	// STEP 3: Set the trigger for initiating the next CC iteration
-	trigger_request_information_to_agents.Set(FixTimeOffset(SimTime() + time_between_requests,13,12));
+	trigger_request_information_to_agents.Set(SimTime() + time_between_requests);
 	++ cc_iteration;
 
 };
@@ -534,9 +548,11 @@ void CentralController :: GenerateClusters(int wlan_id, Performance performance,
 		// CCA + Margin
 		case CLUSTER_BY_CCA :{
 			double margin_db(5);	// TODO: read this margin from the input file (now it is hardcoded)
+			double cca_dbm (PwToDbm(configuration.capabilities.sensitivity_default));
+			std::vector<double> max_received_power_dbm_per_wlan(wlans_number);
+			PwToDbmArray(performance.max_received_power_in_ap_per_wlan, &max_received_power_dbm_per_wlan[0], wlans_number);
 			for (int j = 0; j < wlans_number; ++j) {
-				if (wlan_id != j && ConvertPower(PW_TO_DBM, performance.max_received_power_in_ap_per_wlan[j])
-					  > ConvertPower(PW_TO_DBM, configuration.capabilities.sensitivity_default) - margin_db ) {
+				if (wlan_id != j && max_received_power_dbm_per_wlan[j] > cca_dbm - margin_db ) {
 					controller_report.clusters_per_wlan[wlan_id][j] = 1;
 				}
 			}
@@ -682,6 +698,8 @@ void CentralController :: InitializePreProcessor() {
  */
 void CentralController :: InitializeMlModel() {
 
+	ml_model.agent_id = NODE_ID_NONE;	// The CC is not attached to any agent
+	ml_model.seed = seed;
 	ml_model.learning_mechanism = learning_mechanism;
 	ml_model.save_logs = save_controller_logs;
 	ml_model.print_logs = print_controller_logs;
@@ -60,12 +60,17 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <pthread.h>
 
 #include ".././COST/cost.h"
 
 #include "../list_of_macros.h"
 
+#include "../structures/link_budget.h"
+#include "../structures/input_scenario.h"
 #include "../structures/logical_nack.h"
+#include "../structures/spatial_grid.h"
+#include "../structures/shadowing_field.h"
 #include "../structures/notification.h"
 #include "../structures/wlan.h"
 
@@ -76,8 +81,8 @@
 #include "agent.h"
 #include "central_controller.h"
 
-int total_nodes_number;			// Total number of nodes
-char* tmp_nodes;
+pthread_mutex_t output_mutex = PTHREAD_MUTEX_INITIALIZER;	// Serializes the writing of the shared script output among replications
+int fast_power_conversion (FALSE);	// Fast dB/linear conversions in the hot paths (see power_conversion_methods.h)
 
 /* Sequential simulation engine from where the system to be simulated is derived. */
 component Komondor : public CostSimEng {
@@ -87,20 +92,32 @@ component Komondor : public CostSimEng {
 
 		void Setup(double simulation_time_komondor, int save_node_logs, int save_agent_logs,
 			int print_node_logs, int print_system_logs, int print_agent_logs, const char *nodes_filename,
-			const char *script_filename, const char *simulation_code, int seed_console, int agents_enabled, const char *agents_filename);
+			const char *script_filename, const char *simulation_code, int seed_console, int agents_enabled, const char *agents_filename,
+			const InputScenario *input_scenario);
 		void Stop();
 		void Start();
+		void Checkpoint(CostSnapshot &snapshot);
+		void ClearStats();
+		void Branch(int branch);
+		void BranchResults(int branch, const std::string &results);
 		void InputChecker();
+		void ComputeMaxTxPowerPerNode();
+		double MaxPowerReceived(int n, int m);
+		int NodesMayInteract(int n, int m, double floor_dbm);
+		void GetLinkCandidates(int n, std::vector<int> &nodes);
+		void BuildInterferenceIslands();
+		void AssignIslandsToThreads();
 
 		void SetupEnvironmentByReadingConfigFile();
-		void GenerateNodesByReadingInputFile(const char *nodes_filename);
+		void GenerateNodesByReadingInputFile();
 
-		void GenerateAgents(const char *agents_filename, const char *simulation_code_console);
-		void GenerateCentralController(const char *agents_filename);
+		void GenerateAgents(const char *simulation_code_console);
+		void GenerateCentralController();
 
-		int GetNumOfLines(const char *nodes_filename);
-		int GetNumOfNodes(const char *nodes_filename, int node_type, std::string wlan_code);
-		int CheckCentralController(const char *agents_filename);
+		int GetNumOfNodes(int node_type, std::string wlan_code);
+		int GetWlanId(const std::string &wlan_code);
+		int SameWlan(int n, int m);
+		int CheckCentralController();
 
 		void PrintSystemInfo();
 		void PrintAllWlansInfo();
@@ -121,6 +138,7 @@ component Komondor : public CostSimEng {
 		TrafficGenerator[]
 		   traffic_generator_container; ///> Container of traffic generators (associated to nodes)
 
+		int total_nodes_number;						///> Total number of nodes
 		int total_wlans_number;						///> Total number of WLANs
 		int total_agents_number;					///> Total number of agents
 		int total_controlled_agents_number;		///> Total number of agents attached to the central controller
@@ -136,6 +154,7 @@ component Komondor : public CostSimEng {
 		int pdf_backoff;				///> Probability distribution type of the backoff (0: exponential, 1: deterministic)
 		int pdf_tx_time;				///> Probability distribution type of the transmission time (0: exponential, 1: deterministic)
 		int path_loss_model;			///> Path loss model (0: free-space, 1: Okumura-Hata model - Uban areas)
+		std::string path_loss_matrix_filename;	///> Measured path loss matrix replacing the model (empty if none)
 		int adjacent_channel_model;		///> Co-channel interference model
 		int collisions_model;			///> Collisions model
 		double constant_per;			///> Constant PER for successful transmissions
@@ -145,6 +164,28 @@ component Komondor : public CostSimEng {
 
 		int agents_enabled;				///> Determined according to the input (for generating agents or not)
 
+		// Connections among nodes
+		double *max_tx_power_per_node;	///> Largest transmission power each node may use [pW]
+		double connection_margin_db;	///> Nodes are only connected if they may receive each other above the noise minus this margin [dB]
+		Medium medium;					///> Medium delivering the transmissions to the nodes subscribed to their channels
+		LinkBudget link_budget;			///> Distance and power received of each pair of nodes
+		std::map<double, PathLossKernel*>
+			path_loss_per_frequency;	///> Link budget kernel of the path loss model per central frequency
+		double interference_radius;		///> Only the nodes closer than this (or in the same WLAN) compute their links (0: all the pairs) [m]
+		double shadowing_decorrelation;	///> Links between the same cells of this size share their random losses (0: independent per link) [m]
+		ShadowingField shadowing_field;	///> Random losses of each link (fixed per seed)
+		SpatialGrid spatial_grid;		///> Grid indexing the positions of the nodes (only with an interference radius)
+
+		// Interference islands and parallel execution
+		int num_islands;				///> Number of interference islands (groups of nodes that never interact)
+		int *island_per_node;			///> Interference island of each node
+		int num_island_threads;			///> Maximum number of threads running the interference islands
+		int *thread_per_node;			///> Thread (sub-simulation) running the island of each node
+
+		// Sweep (one variant per child process forked when the statistics are cleared)
+		int sweep_parameter;				///> Parameter changed by the variants (SWEEP_TRAFFIC_LOAD, SWEEP_DCB_POLICY or SWEEP_AGENT_STRATEGY)
+		std::vector<double> sweep_values;	///> Value of the parameter in each variant (empty: no sweep)
+
 		// Public items (to shared with the agents)
 		public:
 
@@ -167,15 +208,24 @@ component Komondor : public CostSimEng {
 		int seed;							///> Simulation seed number
 		int print_system_logs;				///> Flag for activating the printing of system logs
 		std::string simulation_code;		///> Komondor simulation code
+		std::string script_code;			///> Simulation code written in the script output (variants append their index)
 		const char *nodes_input_filename;	///> Filename of the nodes (AP or Deterministic Nodes) input CSV
 		const char *agents_input_filename;	///> Filename of the agents input CSV
+		const InputScenario *input_scenario;	///> Contents of the input files (read once, shared by the replications)
+		std::map<std::string, int> wlan_id_per_code;	///> WLAN ID of each WLAN code (interned when reading the nodes)
 		FILE *script_output_file;			///> File for the whole input files included in the script TODO
 		Logger logger_script;				///> Logger for the script file (containing 1+ simulations) Readable version
 
 		// Auxiliar variables
-		int first_line_skiped_flag;		///> Flag for skipping first informative line of input file
 		int central_controller_flag; 	///> In order to allow the generation of the central controller
 
+	// Connections
+	public:
+
+		// INPORT connections for receiving the transmissions of the nodes (delivered through the medium)
+		inport void inline InportMediumStartTX(Notification &notification);
+		inport void inline InportMediumFinishTX(Notification &notification);
+
 };
 
 /**
@@ -194,12 +244,14 @@ component Komondor : public CostSimEng {
  * @param "seed_console" [type int]: random seed
  * @param "agents_enabled_console" [type int]: flag indicating that agents are enabled
  * @param "agents_input_filename_console" [type char*]: filename of the agents input CSV
+ * @param "input_scenario_console" [type InputScenario*]: contents of the input files (config_models, nodes and agents)
  */
 void Komondor :: Setup(double sim_time_console, int save_node_logs_console,
 		int save_agent_logs_console, int print_system_logs_console, int print_node_logs_console,
 		int print_agent_logs_console, const char *nodes_input_filename_console,
 		const char *script_output_filename, const char *simulation_code_console, int seed_console,
-		int agents_enabled_console, const char *agents_input_filename_console){
+		int agents_enabled_console, const char *agents_input_filename_console,
+		const InputScenario *input_scenario_console){
 
 	// Setup variables corresponding to the console's input
 	simulation_time_komondor = sim_time_console;
@@ -210,6 +262,7 @@ void Komondor :: Setup(double sim_time_console, int save_node_logs_console,
 	print_agent_logs = print_agent_logs_console;
 	nodes_input_filename = nodes_input_filename_console;
 	agents_input_filename = agents_input_filename_console;
+	input_scenario = input_scenario_console;
 //	std::string simulation_code;
 //    simulation_code.append(ToString(simulation_code_console));
 	seed = seed_console;
@@ -234,53 +287,98 @@ void Komondor :: Setup(double sim_time_console, int save_node_logs_console,
 	script_output_file = fopen(script_output_filename, "at");	// Script output is removed when script is executed
 	logger_script.save_logs = SAVE_LOG;
 	logger_script.file = script_output_file;
-	fprintf(logger_script.file, "%s KOMONDOR SIMULATION '%s' (seed %d)", LOG_LVL1, simulation_code_console, seed);
+	script_code = ToString(simulation_code_console);
+	// The variants of a sweep write their own line when they finish. The line stays in the buffer of
+	// this stream until Stop() writes the rest of the output (under output_mutex) and closes it
+	if(sweep_values.empty()) {
+		fprintf(logger_script.file, "%s KOMONDOR SIMULATION '%s' (seed %d)", LOG_LVL1, simulation_code_console, seed);
+	}
 
 	// Read system (environment) file
 	SetupEnvironmentByReadingConfigFile();
 
 	// Generate nodes
-	GenerateNodesByReadingInputFile(nodes_input_filename);
+	GenerateNodesByReadingInputFile();
+
+	// Index the positions of the nodes if the links are limited to an interference radius
+	if(interference_radius > 0) {
+		std::vector<double> x(total_nodes_number), y(total_nodes_number), z(total_nodes_number);
+		for(int i = 0; i < total_nodes_number; ++i) {
+			x[i] = node_container[i].x;
+			y[i] = node_container[i].y;
+			z[i] = node_container[i].z;
+		}
+		spatial_grid.BuildSpatialGrid(total_nodes_number, &x[0], &y[0], &z[0], interference_radius);
+	}
 
-	// Compute distance of each pair of nodes
+	// Compute the received power of the links (the rest receive nothing). Only the links within the
+	// interference radius are stored if there is one, and distances are computed from the positions.
+	// The path loss of each link is fixed, so changes of transmission power just scale the powers received
+	link_budget.InitializeLinkBudget(total_nodes_number, interference_radius > 0);
 	for(int i = 0; i < total_nodes_number; ++i) {
-		node_container[i].distances_array = new double[total_nodes_number];
-		node_container[i].received_power_array = new double[total_nodes_number];
-		for(int j = 0; j < total_nodes_number; ++j) {
-			// Compute and assign distances for each other node
-			node_container[i].distances_array[j] = ComputeDistance(node_container[i].x,node_container[i].y,
-				node_container[i].z,node_container[j].x,node_container[j].y,node_container[j].z);
-			// Compute and assign the received power from each other node
-			if(i == j) {
-				node_container[i].received_power_array[j] = 0;
-			} else {
-				node_container[i].received_power_array[j] = ComputePowerReceived(node_container[i].distances_array[j],
-					node_container[j].tx_power_default, node_container[i].central_frequency, path_loss_model);
-			}
+		link_budget.SetNode(i, node_container[i].x, node_container[i].y, node_container[i].z,
+			node_container[i].tx_power_default);
+		node_container[i].links.link_budget = &link_budget;
+		node_container[i].links.node_id = i;
+		// The path loss model is instantiated once per central frequency
+		if(path_loss_model != PATH_LOSS_MEASURED) {
+			PathLossKernel *&path_loss (path_loss_per_frequency[node_container[i].central_frequency]);
+			if(path_loss == NULL) path_loss = CreatePathLossKernel(path_loss_model, node_container[i].central_frequency);
 		}
 	}
-
-	// Compute the maximum power received from each WLAN
+	// A measured path loss is stored as it is (minus the transmission power): no model is evaluated
+	const PathLossMatrix &path_loss_matrix (input_scenario->path_loss_matrix);
+	std::vector<float> tx_power_default_dbm;
+	if(path_loss_model == PATH_LOSS_MEASURED) {
+		tx_power_default_dbm.resize(total_nodes_number);
+		for(int i = 0; i < total_nodes_number; ++i) tx_power_default_dbm[i] = PwToDbm(node_container[i].tx_power_default);
+	}
+	shadowing_field.InitializeShadowingField(seed, shadowing_decorrelation, link_budget.x, link_budget.y, link_budget.z);
+	std::vector<int> link_candidates;
+	std::vector<double> distance_row, tx_power_row, power_row;
+	std::vector<LinkShadowing> shadowing_row;
 	for(int i = 0; i < total_nodes_number; ++i) {
-		double max_power_received_per_wlan;
+		// The APs also keep the maximum power received from each other WLAN (0 from their own one and
+		// from WLANs without links: every WLAN has some node, received with at least 0 pW)
+		double *max_power_per_wlan (NULL);
 		if (node_container[i].node_type == NODE_TYPE_AP) {
-			node_container[i].max_received_power_in_ap_per_wlan = new double[total_wlans_number];
-			for(int j = 0; j < total_wlans_number; ++j) {
-				if (strcmp(node_container[i].wlan_code.c_str(),wlan_container[j].wlan_code.c_str()) == 0) {
-					// Same WLAN
-					node_container[i].max_received_power_in_ap_per_wlan[j] = 0;
-				} else {
-					// Different WLAN
-					max_power_received_per_wlan = -1000;
-					for (int k = 0; k < total_nodes_number; ++k) {
-						// Check only nodes in WLAN "j"
-						if(strcmp(node_container[k].wlan_code.c_str(),wlan_container[j].wlan_code.c_str()) == 0) {
-							if (node_container[i].received_power_array[k] > max_power_received_per_wlan) {
-								max_power_received_per_wlan = node_container[i].received_power_array[k];
-							}
-						}
-					}
-					node_container[i].max_received_power_in_ap_per_wlan[j] = max_power_received_per_wlan;
+			max_power_per_wlan = new double[total_wlans_number];
+			for(int w = 0; w < total_wlans_number; ++w) max_power_per_wlan[w] = 0;
+			node_container[i].max_received_power_in_ap_per_wlan = max_power_per_wlan;
+		}
+		GetLinkCandidates(i, link_candidates);
+		link_candidates.erase(std::remove(link_candidates.begin(), link_candidates.end(), i), link_candidates.end());
+		int num_links (link_candidates.size());
+		if(path_loss_model == PATH_LOSS_MEASURED) {
+			// Missing links (NaN) are not stored
+			for(int c = 0; c < num_links; ++c) {
+				int j (link_candidates[c]);
+				float path_loss (path_loss_matrix.PathLoss(i, j));
+				if(!isnan(path_loss)) link_budget.AddLinkDbm(i, j, tx_power_default_dbm[j] - path_loss);
+			}
+		} else {
+			// The row of the node is computed at once by the kernel of its frequency
+			distance_row.resize(num_links);
+			tx_power_row.resize(num_links);
+			shadowing_row.resize(num_links);
+			power_row.resize(num_links);
+			for(int c = 0; c < num_links; ++c) {
+				distance_row[c] = link_budget.Distance(i, link_candidates[c]);
+				tx_power_row[c] = node_container[link_candidates[c]].tx_power_default;
+				shadowing_row[c] = shadowing_field.Link(i, link_candidates[c]);
+			}
+			if(num_links > 0) {
+				path_loss_per_frequency[node_container[i].central_frequency]->PowerReceivedRow(&distance_row[0],
+					&tx_power_row[0], &shadowing_row[0], num_links, &power_row[0]);
+			}
+			for(int c = 0; c < num_links; ++c) link_budget.AddLink(i, link_candidates[c], power_row[c]);
+		}
+		if(max_power_per_wlan != NULL) {
+			for(int c = 0; c < num_links; ++c) {
+				int j (link_candidates[c]);
+				int w (node_container[j].wlan.wlan_id);
+				if(w != node_container[i].wlan.wlan_id && w != WLAN_ID_NONE) {
+					max_power_per_wlan[w] = std::max(max_power_per_wlan[w], link_budget.ReceivedPower(i, j));
 				}
 			}
 		}
@@ -288,9 +386,9 @@ void Komondor :: Setup(double sim_time_console, int save_node_logs_console,
 
 	// Generate agents (if enabled)
 	central_controller_flag = 0;
-	if (agents_enabled) { GenerateAgents(agents_input_filename, simulation_code_console); }
+	if (agents_enabled) { GenerateAgents(simulation_code_console); }
 	// Generate the central controller (if enabled)
-	if (agents_enabled && central_controller_flag) { GenerateCentralController(agents_input_filename); }
+	if (agents_enabled && central_controller_flag) { GenerateCentralController(); }
 
 	// Print detected configuration (system, nodes and agents)
 	if (print_system_logs) {
@@ -308,19 +406,60 @@ void Komondor :: Setup(double sim_time_console, int save_node_logs_console,
 	// Run the input checker in order to avoid unexpected situations
 	InputChecker();
 
+	// Split the nodes into interference islands, which run in parallel
+	ComputeMaxTxPowerPerNode();
+	BuildInterferenceIslands();
+	AssignIslandsToThreads();
+
 	// Set connections among nodes
+	double connection_floor_dbm (NOISE_LEVEL_DBM - connection_margin_db);
+	int num_connections (0);
+	int num_connections_pruned (0);
+	medium.InitializeMedium(total_nodes_number, num_islands, island_per_node);
+	std::vector<int> island_size(num_islands, 0);
+	for(int n = 0; n < total_nodes_number; ++n) ++island_size[island_per_node[n]];
 	for(int n = 0; n < total_nodes_number; ++n){
 
 		connect traffic_generator_container[n].outportNewPacketGenerated,node_container[n].InportNewPacketGenerated;
 
-		for(int m=0; m < total_nodes_number; ++m) {
+		// Transmissions go through the medium, which only delivers them to the nodes subscribed to the channels they reach
+		connect node_container[n].outportSelfStartTX,InportMediumStartTX;
+		connect node_container[n].outportSelfFinishTX,InportMediumFinishTX;
+		node_container[n].medium = &medium;
+
+		// Only the nodes linked to "n" (and node 0) may be connected
+		GetLinkCandidates(n, link_candidates);
+		if(link_candidates.empty() || link_candidates[0] != 0) link_candidates.insert(link_candidates.begin(), 0);
+		int num_nodes_connected (0);
+
+		for(size_t c = 0; c < link_candidates.size(); ++c) {
 
-			connect node_container[n].outportSelfStartTX,node_container[m].InportSomeNodeStartTX;
-			connect node_container[n].outportSelfFinishTX,node_container[m].InportSomeNodeFinishTX;
-			connect node_container[n].outportSendLogicalNack,node_container[m].InportNackReceived;
+			int m (link_candidates[c]);
+
+			// Nodes in different interference islands never interact
+			if(island_per_node[n] != island_per_node[m]) continue;
+
+			// Transmissions are only delivered to the nodes that may sense them (node 0 monitors the channel of all the nodes)
+			int same_wlan (SameWlan(n, m));
+			int listener (n == m || m == 0 || same_wlan);
+			if(listener || NodesMayInteract(n, m, connection_floor_dbm)) {
+				if(listener) {
+					medium.listeners_per_node[n].push_back(m);
+				} else {
+					medium.neighbors_per_node[n].push_back(m);
+					// Adjacent channel interference reaches the channels where the power is still above the floor (rounded up)
+					if(adjacent_channel_model != ADJACENT_CHANNEL_NONE) {
+						int reach ((int) ceil((MaxPowerReceived(n, m) - connection_floor_dbm) / ADJACENT_CHANNEL_LOSS_DB));
+						medium.channel_reach_per_node[n] = std::min(NUM_CHANNELS_KOMONDOR - 1,
+							std::max(medium.channel_reach_per_node[n], reach));
+					}
+				}
+				connect node_container[n].outportSendLogicalNack,node_container[m].InportNackReceived;
+				++num_nodes_connected;
+			}
 
 			// Nodes belonging to the same WLAN
-			if(strcmp(node_container[n].wlan_code.c_str(),node_container[m].wlan_code.c_str()) == 0 && n!=m) {
+			if(same_wlan && n!=m) {
 				// Connections regarding MCS
 				connect node_container[n].outportAskForTxModulation,node_container[m].InportMCSRequestReceived;
 				connect node_container[n].outportAnswerTxModulation,node_container[m].InportMCSResponseReceived;
@@ -333,13 +472,15 @@ void Komondor :: Setup(double sim_time_console, int save_node_logs_console,
 				}
 			}
 		}
+		num_connections += 3 * num_nodes_connected;
+		num_connections_pruned += 3 * (island_size[island_per_node[n]] - num_nodes_connected);
 
 		if (agents_enabled) {
 			// Set connections among APs and Agents
 			if ( node_container[n].node_type == NODE_TYPE_AP ) {
 				for(int w = 0; w < total_agents_number; ++w){
 					// Connect the agent to the corresponding AP, according to "wlan_code"
-					if (strcmp(node_container[n].wlan_code.c_str(), agent_container[w].wlan_code.c_str()) == 0) {
+					if (agent_container[w].wlan_id == node_container[n].wlan.wlan_id) {
 //						printf("Connecting agent %d with node %d\n", agent_container[w].agent_id, node_container[n].node_id);
 						connect agent_container[w].outportRequestInformationToAp,node_container[n].InportReceivingRequestFromAgent;
 						connect node_container[n].outportAnswerToAgent,agent_container[w].InportReceivingInformationFromAp;
@@ -350,6 +491,17 @@ void Komondor :: Setup(double sim_time_console, int save_node_logs_console,
 		}
 	}
 
+	// Subscribe each node to its allowed channels
+	std::vector<int> late_senders;
+	for(int n = 0; n < total_nodes_number; ++n){
+		medium.Subscribe(n, node_container[n].min_channel_allowed, node_container[n].max_channel_allowed, late_senders);
+	}
+
+	if(print_system_logs) {
+		printf("%s Connections among nodes: %d (%d pruned, floor %.1f dBm)\n", LOG_LVL2,
+			num_connections, num_connections_pruned, connection_floor_dbm);
+	}
+
 	// Connect the agents to the central controller, if applicable
 	if (agents_enabled && central_controller_flag) {
 		for(int w = 0; w < total_agents_number; ++w){
@@ -384,18 +536,304 @@ void Komondor :: Stop(){
 		configuration_per_node[i] = node_container[i].configuration;
 	}
 
-	// Generate the output for scripts
-	GenerateScriptOutput(simulation_index, performance_per_node, configuration_per_node, logger_script,
-		total_wlans_number, total_nodes_number, wlan_container, simulation_time_komondor);
+	// Generate the output for scripts (the file may be shared with other replications)
+	// - The variants of a sweep send it to the parent process, which writes it in branch order
+	double observation_time (simulation_time_komondor - ClearStatsTime());
+	pthread_mutex_lock(&output_mutex);
+	if(BranchOutput() != NULL) {
+		Logger logger_branch;
+		logger_branch.save_logs = SAVE_LOG;
+		logger_branch.file = BranchOutput();
+		fprintf(logger_branch.file, "%s KOMONDOR SIMULATION '%s' (seed %d)", LOG_LVL1, script_code.c_str(), seed);
+		GenerateScriptOutput(simulation_index, performance_per_node, configuration_per_node, logger_branch,
+			total_wlans_number, total_nodes_number, wlan_container, observation_time);
+	} else {
+		GenerateScriptOutput(simulation_index, performance_per_node, configuration_per_node, logger_script,
+			total_wlans_number, total_nodes_number, wlan_container, observation_time);
+	}
 
 	// End of logs
 	fclose(script_output_file);
+	pthread_mutex_unlock(&output_mutex);
 
 	printf("%s SIMULATION '%s' FINISHED\n", LOG_LVL1, simulation_code.c_str());
 	printf("------------------------------------------\n");
 
 };
 
+/**
+ * Checkpoint(): the components save their own state, only check that the snapshot matches the inputs
+ * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+ */
+void Komondor :: Checkpoint(CostSnapshot &snapshot){
+	snapshot.Check(total_nodes_number, "nodes");
+	snapshot.Check(total_wlans_number, "WLANs");
+	snapshot.Check(agents_enabled ? total_agents_number : 0, "agents");
+	medium.Checkpoint(snapshot);
+	link_budget.Checkpoint(snapshot);
+};
+
+/**
+ * Called when a node starts a transmission: delivers it to the nodes the medium selects (all of them
+ * read the same notification, which is never copied per receiver)
+ * @param "notification" [type Notification]: notification containing the information of the transmission
+ */
+void Komondor :: InportMediumStartTX(Notification &notification){
+	std::vector<int> &receivers (medium.StartTransmission(notification));
+	for(size_t i = 0; i < receivers.size(); ++i){
+		node_container[receivers[i]].InportSomeNodeStartTX(notification);
+	}
+};
+
+/**
+ * Called when a node finishes a transmission: delivers it to the nodes its start was delivered to
+ * @param "notification" [type Notification]: notification containing the information of the transmission
+ */
+void Komondor :: InportMediumFinishTX(Notification &notification){
+	std::vector<int> receivers;
+	medium.FinishTransmission(notification.source_id, receivers);
+	for(size_t i = 0; i < receivers.size(); ++i){
+		node_container[receivers[i]].InportSomeNodeFinishTX(notification);
+	}
+};
+
+/**
+ * ClearStats(): called by the engine at ClearStatsTime (e.g., at the end of the warm-up)
+ */
+void Komondor :: ClearStats(){
+	for (int i = 0; i < total_nodes_number; ++i) {
+		node_container[i].ClearStatistics();
+	}
+};
+
+/**
+ * Branch(): called in the child process of a sweep variant, right before the statistics are cleared
+ * @param "branch" [type int]: index of the variant
+ */
+void Komondor :: Branch(int branch){
+
+	double value (sweep_values[branch]);
+	script_code.append("_sweep").append(ToString(branch));
+
+	switch(sweep_parameter) {
+		case SWEEP_TRAFFIC_LOAD:{
+			for (int i = 0; i < total_nodes_number; ++i) {
+				traffic_generator_container[i].traffic_load = value;
+			}
+			break;
+		}
+		case SWEEP_DCB_POLICY:{
+			for (int i = 0; i < total_nodes_number; ++i) {
+				node_container[i].current_dcb_policy = (int) value;
+			}
+			break;
+		}
+		case SWEEP_AGENT_STRATEGY:{
+			for (int i = 0; i < total_agents_number; ++i) {
+				agent_container[i].SetActionSelectionStrategy((int) value);
+			}
+			break;
+		}
+		default:{
+			printf("%sERROR: Unknown sweep parameter %d!\n", LOG_LVL1, sweep_parameter);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	printf("%s SWEEP VARIANT '%s' (parameter %d = %f)\n", LOG_LVL1, script_code.c_str(), sweep_parameter, value);
+};
+
+/**
+ * BranchResults(): called in the parent process with the script output of each variant of a sweep
+ * @param "branch" [type int]: index of the variant
+ * @param "results" [type std::string]: script output written by the variant
+ */
+void Komondor :: BranchResults(int branch, const std::string &results){
+	fputs(results.c_str(), script_output_file);
+	// The parent does not stop the components: the file is closed after the last variant
+	if(branch == (int) sweep_values.size() - 1) fclose(script_output_file);
+};
+
+/**
+ * Compute the largest transmission power each node may use: its default one or, if agents are
+ * enabled, the largest one any agent (or the central controller through them) may set
+ */
+void Komondor :: ComputeMaxTxPowerPerNode(){
+
+	double max_tx_power_agents (0);
+	if(agents_enabled) {
+		for(int w = 0; w < total_agents_number; ++w) {
+			for(int i = 0; i < agent_container[w].num_arms_tx_power; ++i) {
+				max_tx_power_agents = std::max(max_tx_power_agents, agent_container[w].list_of_tx_power_values[i]);
+			}
+		}
+		for(int n = 0; n < total_nodes_number; ++n) {
+			max_tx_power_agents = std::max(max_tx_power_agents, node_container[n].tx_power_default);
+		}
+	}
+
+	max_tx_power_per_node = new double[total_nodes_number];
+	for(int n = 0; n < total_nodes_number; ++n) {
+		max_tx_power_per_node[n] = std::max(node_container[n].tx_power_default, max_tx_power_agents);
+	}
+}
+
+/**
+ * Largest power a node may receive from another one, for any transmission power the transmitter may
+ * use. The received power scales linearly with the transmission power used to compute the link budget.
+ * @param "n" [type int]: transmitter
+ * @param "m" [type int]: receiver
+ * @return "max_power_dbm" [type double]: largest power received [dBm]
+ */
+double Komondor :: MaxPowerReceived(int n, int m){
+	return ConvertPower(PW_TO_DBM, link_budget.ReceivedPower(m, n)
+		* max_tx_power_per_node[n] / node_container[n].tx_power_default);
+}
+
+/**
+ * Get the nodes whose link with a node is computed: all of them without an interference radius, or
+ * the ones within the radius (found in the spatial grid) and the ones of its WLAN
+ * @param "n" [type int]: node
+ * @param "nodes" [type std::vector<int>]: nodes linked to "n", itself included, sorted (to be filled)
+ */
+void Komondor :: GetLinkCandidates(int n, std::vector<int> &nodes){
+
+	if(interference_radius <= 0) {
+		nodes.resize(total_nodes_number);
+		for(int m = 0; m < total_nodes_number; ++m) nodes[m] = m;
+		return;
+	}
+
+	spatial_grid.GetNodesInRadius(node_container[n].x, node_container[n].y, node_container[n].z,
+		interference_radius, nodes);
+	if(node_container[n].wlan.wlan_id != WLAN_ID_NONE) {
+		Wlan &wlan (wlan_container[node_container[n].wlan.wlan_id]);
+		nodes.push_back(wlan.ap_id);
+		for(int s = 0; s < wlan.num_stas; ++s) nodes.push_back(wlan.list_sta_id[s]);
+	}
+	std::sort(nodes.begin(), nodes.end());
+	nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+}
+
+/**
+ * Determine whether any of two nodes may receive the other above a given floor (see MaxPowerReceived())
+ * @param "n" [type int]: first node
+ * @param "m" [type int]: second node
+ * @param "floor_dbm" [type double]: power floor [dBm]
+ * @return "may_interact" [type int]: TRUE if the nodes may receive each other above the floor
+ */
+int Komondor :: NodesMayInteract(int n, int m, double floor_dbm){
+	return (MaxPowerReceived(n, m) >= floor_dbm || MaxPowerReceived(m, n) >= floor_dbm);
+}
+
+/**
+ * Split the nodes into interference islands: connected components of the graph linking the nodes
+ * of the same WLAN and the pairs of nodes that can interfere, i.e., that share some channel and
+ * receive each other above the interference floor (INTERFERENCE_ISLAND_MARGIN_DB below the noise).
+ * Nodes in different islands are not connected. Agents can change channels and transmit powers
+ * at run time, so they keep all the nodes in the same island. Islands only pay off when they run in
+ * parallel: a serial run keeps a single island, so the medium delivers every transmission as without
+ * islands (e.g., node 0 monitors the channel of all the nodes).
+ */
+void Komondor :: BuildInterferenceIslands(){
+
+	island_per_node = new int[total_nodes_number];
+	for(int n = 0; n < total_nodes_number; ++n) island_per_node[n] = n;
+
+	double interference_floor_dbm (NOISE_LEVEL_DBM - INTERFERENCE_ISLAND_MARGIN_DB);
+	int single_island (agents_enabled || num_island_threads <= 1);
+
+	std::vector<int> link_candidates;
+	for(int n = 0; n < total_nodes_number; ++n) {
+		// Agents and serial runs keep all the nodes in the same island
+		if(single_island) {
+			if(n > 0) JoinSets(island_per_node, 0, n);
+			continue;
+		}
+		// Nodes without a link receive nothing from each other: only the candidates are checked
+		GetLinkCandidates(n, link_candidates);
+		for(size_t c = 0; c < link_candidates.size(); ++c) {
+			int m (link_candidates[c]);
+			if(m <= n) continue;
+			// Adjacent channel interference reaches every channel
+			int share_channels (adjacent_channel_model != ADJACENT_CHANNEL_NONE
+				|| (node_container[n].min_channel_allowed <= node_container[m].max_channel_allowed
+				&& node_container[m].min_channel_allowed <= node_container[n].max_channel_allowed));
+			int hear_each_other (NodesMayInteract(n, m, interference_floor_dbm));
+			if(SameWlan(n, m) || (share_channels && hear_each_other)) {
+				JoinSets(island_per_node, n, m);
+			}
+		}
+	}
+
+	// Relabel the islands as 0, 1, 2...
+	std::vector<int> root_per_node(total_nodes_number);
+	std::vector<int> label_per_root(total_nodes_number, -1);
+	num_islands = 0;
+	for(int n = 0; n < total_nodes_number; ++n) {
+		root_per_node[n] = FindSet(island_per_node, n);
+		if(label_per_root[root_per_node[n]] < 0) label_per_root[root_per_node[n]] = num_islands++;
+	}
+	for(int n = 0; n < total_nodes_number; ++n) {
+		island_per_node[n] = label_per_root[root_per_node[n]];
+	}
+
+	if(print_system_logs) {
+		printf("%s Interference islands: %d\n", LOG_LVL2, num_islands);
+	}
+	if(agents_enabled && num_island_threads > 1) {
+		printf("%s NOTE: agents keep all the nodes in a single interference island, so the simulation runs"
+			" in 1 thread (%d requested)\n", LOG_LVL2, num_island_threads);
+	}
+}
+
+/**
+ * Assign the interference islands to threads, each one a sub-simulation run by its own engine until
+ * the end of the simulation (the islands never interact). The islands, largest first, go to the
+ * least loaded thread.
+ */
+void Komondor :: AssignIslandsToThreads(){
+
+	thread_per_node = new int[total_nodes_number];
+	for(int n = 0; n < total_nodes_number; ++n) thread_per_node[n] = 0;
+
+	int num_threads (std::min(num_island_threads, num_islands));
+	if(num_threads <= 1) return;
+
+	std::vector<int> island_size(num_islands, 0);
+	for(int n = 0; n < total_nodes_number; ++n) ++island_size[island_per_node[n]];
+
+	std::vector<int> load_per_thread(num_threads, 0);
+	std::vector<int> thread_per_island(num_islands, -1);
+	for(int i = 0; i < num_islands; ++i) {
+		int largest_island (-1);
+		for(int j = 0; j < num_islands; ++j) {
+			if(thread_per_island[j] < 0 && (largest_island < 0 || island_size[j] > island_size[largest_island])) {
+				largest_island = j;
+			}
+		}
+		int least_loaded (std::min_element(load_per_thread.begin(), load_per_thread.end()) - load_per_thread.begin());
+		thread_per_island[largest_island] = least_loaded;
+		load_per_thread[least_loaded] += island_size[largest_island];
+	}
+
+	// Thread 0 runs this engine, the rest get their own engine
+	std::vector<CostSimEng*> engines(num_threads, (CostSimEng*) this);
+	for(int t = 1; t < num_threads; ++t) engines[t] = new CostSimEng;
+	MakeCurrent();
+	for(int n = 0; n < total_nodes_number; ++n) {
+		thread_per_node[n] = thread_per_island[island_per_node[n]];
+		if(thread_per_node[n] > 0) {
+			MoveComponent(&node_container[n], engines[thread_per_node[n]]);
+			MoveComponent(&traffic_generator_container[n], engines[thread_per_node[n]]);
+		}
+	}
+
+	if(print_system_logs) {
+		printf("%s Parallel execution: %d islands in %d threads\n", LOG_LVL2, num_islands, num_threads);
+	}
+}
+
 /**
  * Identify errors in the introduced input to prevent unexpected situations during the simulation
  */
@@ -450,18 +888,27 @@ void Komondor :: InputChecker(){
 		}
 	}
 
+	// Sort the nodes by ID and by position: repeated values end up next to each other
+	std::vector< std::pair<int,int> > id_line(total_nodes_number);
+	std::vector< std::pair<std::pair<double,double>, std::pair<double,int> > > position_line(total_nodes_number);
 	for (int i = 0; i < total_nodes_number; ++i) {
-		for (int j = 0; j < total_nodes_number; ++j) {
-			// Node IDs must be different
-			if(i!=j && nodes_ids[i] == nodes_ids[j] && i < j) {
-				printf("\nERROR: Nodes in lines %d and %d have the same ID\n\n",i+2,j+2);
-				exit(-1);
-			}
-			// The position of nodes must be different
-			if(i!=j && nodes_x[i] == nodes_x[j] && nodes_y[i] == nodes_y[j] && nodes_z[i] == nodes_z[j] && i < j) {
-				printf("%s nERROR: Nodes in lines %d and %d are exactly at the same position\n\n", LOG_LVL2, i+2,j+2);
-				exit(-1);
-			}
+		id_line[i] = std::make_pair(nodes_ids[i], i);
+		position_line[i] = std::make_pair(std::make_pair(nodes_x[i], nodes_y[i]), std::make_pair(nodes_z[i], i));
+	}
+	std::sort(id_line.begin(), id_line.end());
+	std::sort(position_line.begin(), position_line.end());
+	for (int k = 1; k < total_nodes_number; ++k) {
+		// Node IDs must be different
+		if(id_line[k].first == id_line[k-1].first) {
+			printf("\nERROR: Nodes in lines %d and %d have the same ID\n\n",id_line[k-1].second+2,id_line[k].second+2);
+			exit(-1);
+		}
+		// The position of nodes must be different
+		if(position_line[k].first == position_line[k-1].first
+			&& position_line[k].second.first == position_line[k-1].second.first) {
+			printf("%s nERROR: Nodes in lines %d and %d are exactly at the same position\n\n", LOG_LVL2,
+				position_line[k-1].second.second+2, position_line[k].second.second+2);
+			exit(-1);
 		}
 	}
 
@@ -470,30 +917,13 @@ void Komondor :: InputChecker(){
 }
 
 /**
- * Set up the Komondor environment by reading the system input file (MS-DOS type)
- * @param "system_input_filename" [type char*]: filename of the system input CSV
+ * Set up the Komondor environment from the system input file (config_models) of the input scenario
  */
 void Komondor :: SetupEnvironmentByReadingConfigFile() {
 
-	const char *filename_test = "../config_models";
-	char delim[] = "=";
-	char *ptr;
-	int ix_param = 0;
-	if (print_system_logs) printf("\n%s Reading system configuration file '%s'...\n", LOG_LVL1, filename_test);
-	FILE* test_input_config = fopen(filename_test, "r");
-	if (!test_input_config){
-		printf("%s Test file '%s' not found!\n", LOG_LVL3, filename_test);
-		exit(-1);
-	}
-	char line_system[CHAR_BUFFER_SIZE];
-	while (fgets(line_system, CHAR_BUFFER_SIZE, test_input_config)){
-		// Ignore lines with comments
-		if(line_system[0] == '#') {
-			continue;
-		}
-		// Separate the value of the parameter from the entire line
-		ptr = strtok(line_system, delim);
-		ptr = strtok(NULL, delim);
+	const std::vector<std::string> &config_values (input_scenario->config_values);
+	for(int ix_param = 0; ix_param < (int) config_values.size(); ++ix_param){
+		const char *ptr (config_values[ix_param].c_str());
 		// Store the parameter as a global variable
 		if (ix_param == 0){
 			// Path-loss model
@@ -516,10 +946,12 @@ void Komondor :: SetupEnvironmentByReadingConfigFile() {
 		} else if (ix_param == 6) {
 			// Simulation index (script's output)
 			simulation_index = atoi(ptr);
+		} else if (ix_param == IX_CONFIG_PATH_LOSS_MATRIX) {
+			// Measured path loss matrix (optional): it replaces the path-loss model
+			path_loss_matrix_filename = input_scenario->path_loss_matrix_filename;
+			if(!path_loss_matrix_filename.empty()) path_loss_model = PATH_LOSS_MEASURED;
 		}
-		ix_param++;
 	}
-	fclose(test_input_config);
 
 	if (print_system_logs) printf("%s System environment properly set!\n", LOG_LVL2);
 
@@ -531,220 +963,175 @@ void Komondor :: SetupEnvironmentByReadingConfigFile() {
  */
 
 /**
- * Generate the nodes deterministically, according to the input nodes file
- * @param "nodes_filename" [type char*]: filename of the nodes input CSV
+ * Generate the nodes deterministically, according to the nodes input file of the input scenario
  */
-void Komondor :: GenerateNodesByReadingInputFile(const char *nodes_filename) {
+void Komondor :: GenerateNodesByReadingInputFile() {
 
 	if (print_system_logs) printf("\n%s Generating nodes DETERMINISTICALLY through NODES input file...\n", LOG_LVL1);
 
-	if (print_system_logs) printf("%s Reading nodes input file '%s'...\n", LOG_LVL2, nodes_filename);
+	if (print_system_logs) printf("%s Reading nodes input file '%s'...\n", LOG_LVL2, nodes_input_filename);
 
-		total_wlans_number = GetNumOfNodes(nodes_filename, NODE_TYPE_AP, ToString(""));
+		const std::vector<InputRow> &rows (input_scenario->nodes.rows);
+		total_wlans_number = GetNumOfNodes(NODE_TYPE_AP, ToString(""));
 		if (print_system_logs) printf("%s Num. of WLANs detected: %d\n", LOG_LVL3, total_wlans_number);
 		wlan_container = new Wlan[total_wlans_number];
-		FILE* stream_nodes = fopen(nodes_filename, "r");
-		char line_nodes[CHAR_BUFFER_SIZE];
-		first_line_skiped_flag = 0;	// Flag for skipping first informative line of input file
 		int wlan_ix (0);			// Auxiliar wlan index
+		std::map<std::string, int> num_stas_per_code;	// Number of STAs of each WLAN code
 
-		// Identify WLANs
-		while (fgets(line_nodes, CHAR_BUFFER_SIZE, stream_nodes)){
-			if(!first_line_skiped_flag){	// Skip the first line of the .csv file
-				first_line_skiped_flag = 1;
-			} else{
-				// Node type
-				tmp_nodes = strdup(line_nodes);
-				int node_type (atoi(GetField(tmp_nodes, IX_NODE_TYPE)));
-				if(node_type == NODE_TYPE_AP){	// If node is AP
-					// WLAN ID
-					wlan_container[wlan_ix].wlan_id = wlan_ix;
-					// WLAN code
-					tmp_nodes = strdup(line_nodes);
-					std::string wlan_code_aux = ToString(GetField(tmp_nodes, IX_WLAN_CODE));
-					wlan_container[wlan_ix].wlan_code = wlan_code_aux;
-					++wlan_ix;
-					free(tmp_nodes);
-				}
+		// Identify WLANs (interning their codes) and count their STAs in one pass
+		wlan_id_per_code.clear();
+		for(size_t r = 0; r < rows.size(); ++r){
+			// Node type
+			int node_type (atoi(rows[r].Field(IX_NODE_TYPE)));
+			// WLAN code
+			std::string wlan_code_aux = ToString(rows[r].Field(IX_WLAN_CODE));
+			if(node_type == NODE_TYPE_AP){	// If node is AP
+				// WLAN ID
+				wlan_container[wlan_ix].wlan_id = wlan_ix;
+				// WLAN code
+				wlan_container[wlan_ix].wlan_code = wlan_code_aux;
+				if(wlan_id_per_code.find(wlan_code_aux) == wlan_id_per_code.end()) wlan_id_per_code[wlan_code_aux] = wlan_ix;
+				++wlan_ix;
+			} else if(node_type == NODE_TYPE_STA){	// If node is STA
+				++num_stas_per_code[wlan_code_aux];
 			}
 		}
 
-		// Get number of STAs in each WLAN
+		// Set the number of STAs in each WLAN
 		for(int w = 0; w < total_wlans_number; ++w){
-			int num_stas_in_wlan (GetNumOfNodes(nodes_filename, NODE_TYPE_STA, wlan_container[w].wlan_code));
+			int num_stas_in_wlan (num_stas_per_code[wlan_container[w].wlan_code]);
 			wlan_container[w].num_stas = num_stas_in_wlan;
 			wlan_container[w].SetSizeOfSTAsArray(num_stas_in_wlan);
 		}
 
 		// Generate nodes (without wlan item), finish WLAN with ID lists, and set the wlan item of each STA.
 		if (print_system_logs) printf("%s Generating nodes...\n", LOG_LVL3);
-		total_nodes_number = GetNumOfNodes(nodes_filename, NODE_TYPE_UNKWNOW, ToString(""));
+		total_nodes_number = GetNumOfNodes(NODE_TYPE_UNKWNOW, ToString(""));
 		node_container.SetSize(total_nodes_number);
 		traffic_generator_container.SetSize(total_nodes_number);
-		stream_nodes = fopen(nodes_filename, "r");
-		int node_ix (0);	// Auxiliar index for nodes
-		wlan_ix = 0;		// Auxiliar index for WLANs
-		first_line_skiped_flag = 0;
-
-		while (fgets(line_nodes, CHAR_BUFFER_SIZE, stream_nodes)){	// For each WLAN
-
-			if(!first_line_skiped_flag){	// Skip the first line of the .csv file
-				first_line_skiped_flag = 1;
-			} else {
-				// Node ID (auto-assigned)
-				node_container[node_ix].node_id = node_ix;
-				// Node code
-				tmp_nodes = strdup(line_nodes);
-				std::string node_code = ToString(GetField(tmp_nodes, IX_NODE_CODE));
-				node_container[node_ix].node_code = node_code;
-				// Node type
-				tmp_nodes = strdup(line_nodes);
-				int node_type (atoi(GetField(tmp_nodes, IX_NODE_TYPE)));
-				node_container[node_ix].node_type = node_type;
-				// WLAN code: add AP or STA ID to corresponding WLAN
-				tmp_nodes = strdup(line_nodes);
-				const char *wlan_code_aux (GetField(tmp_nodes, IX_WLAN_CODE));
-				std::string wlan_code;
-				wlan_code.append(ToString(wlan_code_aux));
-				node_container[node_ix].wlan_code = wlan_code;
-				for(int w = 0; w < total_wlans_number; ++w){
-					if(strcmp(wlan_code.c_str(), wlan_container[w].wlan_code.c_str()) == 0){	// If nodes belong to WLAN
-						if(node_container[node_ix].node_type == NODE_TYPE_AP){	// If node is AP
-							wlan_container[w].ap_id = node_container[node_ix].node_id;
-						} else if (node_container[node_ix].node_type == NODE_TYPE_STA){	// If node is STA
-							for(int s = 0; s < wlan_container[w].num_stas; ++s){
-								if(wlan_container[w].list_sta_id[s] == NODE_ID_NONE){
-									wlan_container[w].list_sta_id[s] = node_container[node_ix].node_id;
-									break;
-								}
-							}
-						}
-					}
-				}
-				// Position
-				tmp_nodes = strdup(line_nodes);
-				node_container[node_ix].x = atof(GetField(tmp_nodes, IX_POSITION_X));
-				tmp_nodes = strdup(line_nodes);
-				node_container[node_ix].y = atof(GetField(tmp_nodes, IX_POSITION_Y));
-				tmp_nodes = strdup(line_nodes);
-				node_container[node_ix].z = atof(GetField(tmp_nodes, IX_POSITION_Z));
-				// Central frequency in GHz (e.g. 2.4)
-				tmp_nodes = strdup(line_nodes);
-				const char* central_frequency_char (GetField(tmp_nodes, IX_CENTRAL_FREQ));
-				node_container[node_ix].central_frequency = atof(central_frequency_char) * pow(10,9);
-				// Channel bonding model
-				tmp_nodes = strdup(line_nodes);
-				node_container[node_ix].current_dcb_policy = atoi(GetField(tmp_nodes, IX_CHANNEL_BONDING_MODEL));
-				// Primary channel
-				tmp_nodes = strdup(line_nodes);
-				node_container[node_ix].current_primary_channel = atoi(GetField(tmp_nodes, IX_PRIMARY_CHANNEL));
-				// Min channel allowed
-				tmp_nodes = strdup(line_nodes);
-				node_container[node_ix].min_channel_allowed = atoi(GetField(tmp_nodes, IX_MIN_CH_ALLOWED));
-				// Max channel allowed
-				tmp_nodes = strdup(line_nodes);
-				node_container[node_ix].max_channel_allowed = atoi(GetField(tmp_nodes, IX_MAX_CH_ALLOWED));
-				// Default tx_power
-				tmp_nodes = strdup(line_nodes);
-				double tx_power_default_dbm (atof(GetField(tmp_nodes, IX_TX_POWER_DEFAULT)));
-				node_container[node_ix].tx_power_default = ConvertPower(DBM_TO_PW, tx_power_default_dbm);
-				// Default pd threshold
-				tmp_nodes = strdup(line_nodes);
-				double sensitivity_default_dbm (atoi(GetField(tmp_nodes, IX_PD_DEFAULT)));
-				node_container[node_ix].sensitivity_default = ConvertPower(DBM_TO_PW, sensitivity_default_dbm);
-				// Traffic model
-				tmp_nodes = strdup(line_nodes);
-				const char* traffic_model_char (GetField(tmp_nodes, IX_TRAFFIC_MODEL));
-				// Traffic load (packet generation rate)
-				tmp_nodes = strdup(line_nodes);
-				const char* traffic_load_char (GetField(tmp_nodes, IX_TRAFFIC_LOAD));
-				// Packet length
-				tmp_nodes = strdup(line_nodes);
-				const char* packet_length_char (GetField(tmp_nodes, IX_PACKET_LENGTH));
-				node_container[node_ix].frame_length = atoi(packet_length_char);
-				// Maximum number of aggregated packets
-				tmp_nodes = strdup(line_nodes);
-				const char* packets_aggregated_char (GetField(tmp_nodes, IX_NUM_PACKETS_AGG));
-				node_container[node_ix].max_num_packets_aggregated = atoi(packets_aggregated_char);
-				// Capture effect model -  0=default (recommended) or 1=IEEE 802.11-like
-				tmp_nodes = strdup(line_nodes);
-				node_container[node_ix].capture_effect_model = atoi(GetField(tmp_nodes, IX_CAPTURE_EFFECT_MODEL));
-				// Capture effect threshold in dB
-				tmp_nodes = strdup(line_nodes);
-				const char* capture_effect_char (GetField(tmp_nodes, IX_CAPTURE_EFFECT_THR));
-				node_container[node_ix].capture_effect = ConvertPower(DB_TO_LINEAR, atof(capture_effect_char));
-				// Constant PER
-				tmp_nodes = strdup(line_nodes);
-				node_container[node_ix].constant_per = atof(GetField(tmp_nodes, IX_CONSTANT_PER));
-				// PIFS activated
-				tmp_nodes = strdup(line_nodes);
-				node_container[node_ix].pifs_activated = atoi(GetField(tmp_nodes, IX_PIFS_ACTIVATED));
-				// CW adaptation activated
-				tmp_nodes = strdup(line_nodes);
-				node_container[node_ix].cw_adaptation = atoi(GetField(tmp_nodes, IX_CW_ADAPTATION_FLAG));
-				// CW min
-				tmp_nodes = strdup(line_nodes);
-				node_container[node_ix].cw_min = atoi(GetField(tmp_nodes, IX_CW_MIN));
-				// CW max stage
-				tmp_nodes = strdup(line_nodes);
-				node_container[node_ix].cw_stage_max = atoi(GetField(tmp_nodes, IX_CW_STAGE_MAX));
-				// SPATIAL REUSE parameters
-				//  - BSS color
-				tmp_nodes = strdup(line_nodes);
-				const char* bss_color_char = GetField(tmp_nodes, IX_BSS_COLOR);
-				//  - Spatial Reuse Group (SRG)
-				tmp_nodes = strdup(line_nodes);
-				const char* srg_char = GetField(tmp_nodes, IX_SRG);
-				//  - non-SRG OBSS_PD
-				tmp_nodes = strdup(line_nodes);
-				const char* non_srg_obss_pd_char = GetField(tmp_nodes, IX_NON_SRG_OBSS_PD);
-				//  - SRG OBSS_PD
-				tmp_nodes = strdup(line_nodes);
-				const char* srg_obss_pd_char = GetField(tmp_nodes, IX_SRG_OBSS_PD);
-				// System and models
-				node_container[node_ix].simulation_time_komondor = simulation_time_komondor;
-				node_container[node_ix].total_wlans_number = total_wlans_number;
-				node_container[node_ix].total_nodes_number = total_nodes_number;
-				node_container[node_ix].collisions_model = collisions_model;
-				node_container[node_ix].save_node_logs = save_node_logs;
-				node_container[node_ix].print_node_logs = print_node_logs;
-				node_container[node_ix].adjacent_channel_model = adjacent_channel_model;
-				node_container[node_ix].pdf_backoff = pdf_backoff;
-				node_container[node_ix].path_loss_model = path_loss_model;
-				node_container[node_ix].pdf_tx_time = pdf_tx_time;
-				node_container[node_ix].backoff_type = backoff_type;
-				node_container[node_ix].simulation_code = simulation_code;
-				// SPATIAL REUSE
-				if (bss_color_char != NULL) { // Check if the input file is compliant with SR
-					node_container[node_ix].bss_color = atoi(bss_color_char);
-					node_container[node_ix].srg = atoi(srg_char);
-					double non_srg_obss_pd_dbm = atof(non_srg_obss_pd_char);
-					node_container[node_ix].non_srg_obss_pd = ConvertPower(DBM_TO_PW, non_srg_obss_pd_dbm);
-					double srg_obss_pd_dbm = atof(srg_obss_pd_char);
-					node_container[node_ix].srg_obss_pd = ConvertPower(DBM_TO_PW, srg_obss_pd_dbm);
-				} else {
-					node_container[node_ix].bss_color = -1;
-					node_container[node_ix].srg = -1;
-					node_container[node_ix].non_srg_obss_pd = -1;
-					node_container[node_ix].srg_obss_pd = -1;
+		std::vector<int> num_stas_listed(total_wlans_number, 0);	// STAs already added to the list of each WLAN
+
+		for(int node_ix = 0; node_ix < total_nodes_number; ++node_ix){	// For each node
+
+			const InputRow &row (rows[node_ix]);
+			// Node ID (auto-assigned)
+			node_container[node_ix].node_id = node_ix;
+			// Node code
+			std::string node_code = ToString(row.Field(IX_NODE_CODE));
+			node_container[node_ix].node_code = node_code;
+			// Node type
+			int node_type (atoi(row.Field(IX_NODE_TYPE)));
+			node_container[node_ix].node_type = node_type;
+			// WLAN code: add AP or STA ID to corresponding WLAN
+			const char *wlan_code_aux (row.Field(IX_WLAN_CODE));
+			std::string wlan_code;
+			wlan_code.append(ToString(wlan_code_aux));
+			node_container[node_ix].wlan_code = wlan_code;
+			int w (GetWlanId(wlan_code));
+			node_container[node_ix].wlan.wlan_id = w;
+			if(w != WLAN_ID_NONE){	// If node belongs to a WLAN
+				if(node_container[node_ix].node_type == NODE_TYPE_AP){	// If node is AP
+					wlan_container[w].ap_id = node_container[node_ix].node_id;
+				} else if (node_container[node_ix].node_type == NODE_TYPE_STA){	// If node is STA
+					wlan_container[w].list_sta_id[num_stas_listed[w]] = node_container[node_ix].node_id;
+					++num_stas_listed[w];
 				}
-				// Traffic generator
-				traffic_generator_container[node_ix].node_type = node_type;
-				traffic_generator_container[node_ix].node_id = node_ix;
-				traffic_generator_container[node_ix].traffic_model = atoi(traffic_model_char);
-				node_container[node_ix].traffic_model = atoi(traffic_model_char); // Tell the node in case full buffer model is selected
-				traffic_generator_container[node_ix].traffic_load = atof(traffic_load_char);
-
-				++node_ix;
-				free(tmp_nodes);
 			}
+			// Position
+			node_container[node_ix].x = atof(row.Field(IX_POSITION_X));
+			node_container[node_ix].y = atof(row.Field(IX_POSITION_Y));
+			node_container[node_ix].z = atof(row.Field(IX_POSITION_Z));
+			// Central frequency in GHz (e.g. 2.4)
+			const char* central_frequency_char (row.Field(IX_CENTRAL_FREQ));
+			node_container[node_ix].central_frequency = atof(central_frequency_char) * pow(10,9);
+			// Channel bonding model
+			node_container[node_ix].current_dcb_policy = atoi(row.Field(IX_CHANNEL_BONDING_MODEL));
+			// Primary channel
+			node_container[node_ix].current_primary_channel = atoi(row.Field(IX_PRIMARY_CHANNEL));
+			// Min channel allowed
+			node_container[node_ix].min_channel_allowed = atoi(row.Field(IX_MIN_CH_ALLOWED));
+			// Max channel allowed
+			node_container[node_ix].max_channel_allowed = atoi(row.Field(IX_MAX_CH_ALLOWED));
+			// Default tx_power
+			double tx_power_default_dbm (atof(row.Field(IX_TX_POWER_DEFAULT)));
+			node_container[node_ix].tx_power_default = ConvertPower(DBM_TO_PW, tx_power_default_dbm);
+			// Default pd threshold
+			double sensitivity_default_dbm (atoi(row.Field(IX_PD_DEFAULT)));
+			node_container[node_ix].sensitivity_default = ConvertPower(DBM_TO_PW, sensitivity_default_dbm);
+			// Traffic model
+			const char* traffic_model_char (row.Field(IX_TRAFFIC_MODEL));
+			// Traffic load (packet generation rate)
+			const char* traffic_load_char (row.Field(IX_TRAFFIC_LOAD));
+			// Packet length
+			const char* packet_length_char (row.Field(IX_PACKET_LENGTH));
+			node_container[node_ix].frame_length = atoi(packet_length_char);
+			// Maximum number of aggregated packets
+			const char* packets_aggregated_char (row.Field(IX_NUM_PACKETS_AGG));
+			node_container[node_ix].max_num_packets_aggregated = atoi(packets_aggregated_char);
+			// Capture effect model -  0=default (recommended) or 1=IEEE 802.11-like
+			node_container[node_ix].capture_effect_model = atoi(row.Field(IX_CAPTURE_EFFECT_MODEL));
+			// Capture effect threshold in dB
+			const char* capture_effect_char (row.Field(IX_CAPTURE_EFFECT_THR));
+			node_container[node_ix].capture_effect = ConvertPower(DB_TO_LINEAR, atof(capture_effect_char));
+			// Constant PER
+			node_container[node_ix].constant_per = atof(row.Field(IX_CONSTANT_PER));
+			// PIFS activated
+			node_container[node_ix].pifs_activated = atoi(row.Field(IX_PIFS_ACTIVATED));
+			// CW adaptation activated
+			node_container[node_ix].cw_adaptation = atoi(row.Field(IX_CW_ADAPTATION_FLAG));
+			// CW min
+			node_container[node_ix].cw_min = atoi(row.Field(IX_CW_MIN));
+			// CW max stage
+			node_container[node_ix].cw_stage_max = atoi(row.Field(IX_CW_STAGE_MAX));
+			// SPATIAL REUSE parameters
+			//  - BSS color
+			const char* bss_color_char = row.Field(IX_BSS_COLOR);
+			//  - Spatial Reuse Group (SRG)
+			const char* srg_char = row.Field(IX_SRG);
+			//  - non-SRG OBSS_PD
+			const char* non_srg_obss_pd_char = row.Field(IX_NON_SRG_OBSS_PD);
+			//  - SRG OBSS_PD
+			const char* srg_obss_pd_char = row.Field(IX_SRG_OBSS_PD);
+			// System and models
+			node_container[node_ix].simulation_time_komondor = simulation_time_komondor;
+			node_container[node_ix].total_wlans_number = total_wlans_number;
+			node_container[node_ix].total_nodes_number = total_nodes_number;
+			node_container[node_ix].collisions_model = collisions_model;
+			node_container[node_ix].save_node_logs = save_node_logs;
+			node_container[node_ix].print_node_logs = print_node_logs;
+			node_container[node_ix].adjacent_channel_model = adjacent_channel_model;
+			node_container[node_ix].pdf_backoff = pdf_backoff;
+			node_container[node_ix].path_loss_model = path_loss_model;
+			node_container[node_ix].pdf_tx_time = pdf_tx_time;
+			node_container[node_ix].backoff_type = backoff_type;
+			node_container[node_ix].simulation_code = simulation_code;
+			node_container[node_ix].seed = seed;
+			// SPATIAL REUSE
+			if (bss_color_char != NULL) { // Check if the input file is compliant with SR
+				node_container[node_ix].bss_color = atoi(bss_color_char);
+				node_container[node_ix].srg = atoi(srg_char);
+				double non_srg_obss_pd_dbm = atof(non_srg_obss_pd_char);
+				node_container[node_ix].non_srg_obss_pd = ConvertPower(DBM_TO_PW, non_srg_obss_pd_dbm);
+				double srg_obss_pd_dbm = atof(srg_obss_pd_char);
+				node_container[node_ix].srg_obss_pd = ConvertPower(DBM_TO_PW, srg_obss_pd_dbm);
+			} else {
+				node_container[node_ix].bss_color = -1;
+				node_container[node_ix].srg = -1;
+				node_container[node_ix].non_srg_obss_pd = -1;
+				node_container[node_ix].srg_obss_pd = -1;
+			}
+			// Traffic generator
+			traffic_generator_container[node_ix].node_type = node_type;
+			traffic_generator_container[node_ix].node_id = node_ix;
+			traffic_generator_container[node_ix].seed = seed;
+			traffic_generator_container[node_ix].traffic_model = atoi(traffic_model_char);
+			node_container[node_ix].traffic_model = atoi(traffic_model_char); // Tell the node in case full buffer model is selected
+			traffic_generator_container[node_ix].traffic_load = atof(traffic_load_char);
 		}
 		// Set corresponding WLAN to each node
 		for(int n = 0; n < total_nodes_number; ++n){
-			for(int w = 0; w < total_wlans_number; ++w){
-				if (strcmp(node_container[n].wlan_code.c_str(), wlan_container[w].wlan_code.c_str()) == 0) {
-					node_container[n].wlan = wlan_container[w];
-				}
+			if(node_container[n].wlan.wlan_id != WLAN_ID_NONE) {
+				node_container[n].wlan = wlan_container[node_container[n].wlan.wlan_id];
 			}
 		}
 
@@ -752,234 +1139,207 @@ void Komondor :: GenerateNodesByReadingInputFile(const char *nodes_filename) {
 }
 
 /**
- * Generate the agents deterministically, according to the input agents file
- * @param "agents_filename" [type char*]: filename of the agents input CSV
+ * Generate the agents deterministically, according to the agents input file of the input scenario
+ * @param "simulation_code_console" [type char*]: simulation code assigned to current simulation
  */
-void Komondor :: GenerateAgents(const char *agents_filename, const char *simulation_code_console) {
+void Komondor :: GenerateAgents(const char *simulation_code_console) {
 
 	if (print_system_logs) printf("%s Generating agents...\n", LOG_LVL1);
-	if (print_system_logs) printf("%s Reading agents input file '%s'...\n", LOG_LVL2, agents_filename);
+	if (print_system_logs) printf("%s Reading agents input file '%s'...\n", LOG_LVL2, agents_input_filename);
 
+	const std::vector<InputRow> &rows (input_scenario->agents.rows);
 	// STEP 1: CHECK IF THERE IS A CC AND PARSE ITS INFORMATION DIFFERENTLY THAN FROM AGENTS
-	central_controller_flag = CheckCentralController(agents_filename);
+	central_controller_flag = CheckCentralController();
 	// STEP 2: SET SIZE OF THE AGENTS CONTAINER
-	total_agents_number = GetNumOfLines(agents_filename) - central_controller_flag;
+	total_agents_number = (int) rows.size() - central_controller_flag;
 	agent_container.SetSize(total_agents_number);
 	if (print_system_logs) printf("%s Num. of agents (WLANs): %d/%d\n", LOG_LVL3, total_agents_number, total_wlans_number);
 	// STEP 3: read the input file to determine the action space
 	if (print_system_logs) printf("%s Setting action space...\n", LOG_LVL4);
-	FILE* stream_agents = fopen(agents_filename, "r");
-	char line_agents[CHAR_BUFFER_SIZE];
-	first_line_skiped_flag = 0;	// Flag for skipping first informative line of input file
 	int agent_ix (0);	// Auxiliary index
-	while (fgets(line_agents, CHAR_BUFFER_SIZE, stream_agents)){
-		if(!first_line_skiped_flag){	// Skip the first line of the .csv file
-			first_line_skiped_flag = 1;
-		} else{
-			char* tmp_agents = strdup(line_agents);
-			const char *wlan_code_aux (GetField(tmp_agents, IX_AGENT_WLAN_CODE));
-			std::string wlan_code;
-			wlan_code.append(ToString(wlan_code_aux));
-			// Skip the line in case we find a Central Controller (CC). Otherwise, read it and initialize the agent
-			if (strcmp(wlan_code.c_str(), "NULL") == 0) continue;
-			// Find the length of the channel actions array
-			tmp_agents = strdup(line_agents);
-			const char *channel_values_aux (GetField(tmp_agents, IX_AGENT_CHANNEL_VALUES));
-			std::string channel_values_text;
-			channel_values_text.append(ToString(channel_values_aux));
-			const char *channel_aux;
-			channel_aux = strtok ((char*)channel_values_text.c_str(),",");
-			num_arms_channel = 0;
-			while (channel_aux != NULL) {
-				channel_aux = strtok (NULL, ",");
-				++ num_arms_channel;
-			}
-			// Set the length of channel actions to agent's field
-			agent_container[agent_ix].num_arms_channel = num_arms_channel;
-			// Find the length of the pd actions array
-			tmp_agents = strdup(line_agents);
-			const char *pd_values_aux (GetField(tmp_agents, IX_AGENT_PD_VALUES));
-			std::string pd_values_text;
-			pd_values_text.append(ToString(pd_values_aux));
-			const char *pd_aux;
-			pd_aux = strtok ((char*)pd_values_text.c_str(),",");
-			num_arms_sensitivity = 0;
-			while (pd_aux != NULL) {
-				pd_aux = strtok (NULL, ",");
-				++ num_arms_sensitivity;
-			}
-			// Set the length of sensitivity actions to agent's field
-			agent_container[agent_ix].num_arms_sensitivity = num_arms_sensitivity;
-			// Find the length of the Tx power actions array
-			tmp_agents = strdup(line_agents);
-			const char *tx_power_values_aux (GetField(tmp_agents, IX_AGENT_TX_POWER_VALUES));
-			std::string tx_power_values_text;
-			tx_power_values_text.append(ToString(tx_power_values_aux));
-			const char *tx_power_aux;
-			tx_power_aux = strtok ((char*)tx_power_values_text.c_str(),",");
-			num_arms_tx_power = 0;
-			while (tx_power_aux != NULL) {
-				tx_power_aux = strtok (NULL, ",");
-				++ num_arms_tx_power;
-			}
-			// Set the length of Tx power actions to agent's field
-			agent_container[agent_ix].num_arms_tx_power = num_arms_tx_power;
-			// Find the length of the DCB actions actions array
-			tmp_agents = strdup(line_agents);
-			const char *max_bandwidth_values_aux (GetField(tmp_agents, IX_AGENT_MAX_BANDWIDTH));
-			std::string max_bandwidth_values_text;
-			max_bandwidth_values_text.append(ToString(max_bandwidth_values_aux));
-			const char *max_bandwidth_aux;
-			max_bandwidth_aux = strtok ((char*)max_bandwidth_values_text.c_str(),",");
-			num_arms_max_bandwidth = 0;
-			while (max_bandwidth_aux != NULL) {
-				max_bandwidth_aux = strtok (NULL, ",");
-				++num_arms_max_bandwidth;
-			}
-			// Set the length of max bandwidth to agent's field
-			agent_container[agent_ix].num_arms_max_bandwidth = num_arms_max_bandwidth;
+	for(size_t r = 0; r < rows.size(); ++r){
+		const InputRow &row (rows[r]);
+		const char *wlan_code_aux (row.Field(IX_AGENT_WLAN_CODE));
+		std::string wlan_code;
+		wlan_code.append(ToString(wlan_code_aux));
+		// Skip the line in case we find a Central Controller (CC). Otherwise, read it and initialize the agent
+		if (strcmp(wlan_code.c_str(), "NULL") == 0) continue;
+		char *save_ptr;
+		// Find the length of the channel actions array
+		const char *channel_values_aux (row.Field(IX_AGENT_CHANNEL_VALUES));
+		std::string channel_values_text;
+		channel_values_text.append(ToString(channel_values_aux));
+		const char *channel_aux;
+		// strtok_r writes into its input: tokenize a copy (with the terminating '\0')
+		std::vector<char> channel_values_buffer (channel_values_text.c_str(), channel_values_text.c_str() + channel_values_text.size() + 1);
+		channel_aux = strtok_r (&channel_values_buffer[0], ",", &save_ptr);
+		num_arms_channel = 0;
+		while (channel_aux != NULL) {
+			channel_aux = strtok_r (NULL, ",", &save_ptr);
+			++ num_arms_channel;
+		}
+		// Set the length of channel actions to agent's field
+		agent_container[agent_ix].num_arms_channel = num_arms_channel;
+		// Find the length of the pd actions array
+		const char *pd_values_aux (row.Field(IX_AGENT_PD_VALUES));
+		std::string pd_values_text;
+		pd_values_text.append(ToString(pd_values_aux));
+		const char *pd_aux;
+		std::vector<char> pd_values_buffer (pd_values_text.c_str(), pd_values_text.c_str() + pd_values_text.size() + 1);
+		pd_aux = strtok_r (&pd_values_buffer[0], ",", &save_ptr);
+		num_arms_sensitivity = 0;
+		while (pd_aux != NULL) {
+			pd_aux = strtok_r (NULL, ",", &save_ptr);
+			++ num_arms_sensitivity;
+		}
+		// Set the length of sensitivity actions to agent's field
+		agent_container[agent_ix].num_arms_sensitivity = num_arms_sensitivity;
+		// Find the length of the Tx power actions array
+		const char *tx_power_values_aux (row.Field(IX_AGENT_TX_POWER_VALUES));
+		std::string tx_power_values_text;
+		tx_power_values_text.append(ToString(tx_power_values_aux));
+		const char *tx_power_aux;
+		std::vector<char> tx_power_values_buffer (tx_power_values_text.c_str(), tx_power_values_text.c_str() + tx_power_values_text.size() + 1);
+		tx_power_aux = strtok_r (&tx_power_values_buffer[0], ",", &save_ptr);
+		num_arms_tx_power = 0;
+		while (tx_power_aux != NULL) {
+			tx_power_aux = strtok_r (NULL, ",", &save_ptr);
+			++ num_arms_tx_power;
+		}
+		// Set the length of Tx power actions to agent's field
+		agent_container[agent_ix].num_arms_tx_power = num_arms_tx_power;
+		// Find the length of the DCB actions actions array
+		const char *max_bandwidth_values_aux (row.Field(IX_AGENT_MAX_BANDWIDTH));
+		std::string max_bandwidth_values_text;
+		max_bandwidth_values_text.append(ToString(max_bandwidth_values_aux));
+		const char *max_bandwidth_aux;
+		std::vector<char> max_bandwidth_values_buffer (max_bandwidth_values_text.c_str(), max_bandwidth_values_text.c_str() + max_bandwidth_values_text.size() + 1);
+		max_bandwidth_aux = strtok_r (&max_bandwidth_values_buffer[0], ",", &save_ptr);
+		num_arms_max_bandwidth = 0;
+		while (max_bandwidth_aux != NULL) {
+			max_bandwidth_aux = strtok_r (NULL, ",", &save_ptr);
+			++num_arms_max_bandwidth;
+		}
+		// Set the length of max bandwidth to agent's field
+		agent_container[agent_ix].num_arms_max_bandwidth = num_arms_max_bandwidth;
 
-			// Set the lenght of the total actions in the agent (combinations of parameters)
-			agent_container[agent_ix].num_arms = num_arms_channel * num_arms_sensitivity
-				* num_arms_tx_power * num_arms_max_bandwidth;
+		// Set the lenght of the total actions in the agent (combinations of parameters)
+		agent_container[agent_ix].num_arms = num_arms_channel * num_arms_sensitivity
+			* num_arms_tx_power * num_arms_max_bandwidth;
 
-			// Set the simulation code for generating output files
-			agent_container[agent_ix].simulation_code.append(ToString(simulation_code_console));
+		// Set the simulation code for generating output files
+		agent_container[agent_ix].simulation_code.append(ToString(simulation_code_console));
 
-			++agent_ix;
-			free(tmp_agents);
-		}
+		++agent_ix;
 	}
 
 	if (print_system_logs) printf("%s Action space set!\n", LOG_LVL4);
 
 	// STEP 3: set agents parameters
 	if (print_system_logs) printf("%s Setting agents parameters...\n", LOG_LVL4);
-	stream_agents = fopen(agents_filename, "r");
-	first_line_skiped_flag = 0;		// Flag for skipping first informative line of input file
 	agent_ix = 0;	// Auxiliary index
 	total_controlled_agents_number = 0;
-	while (fgets(line_agents, CHAR_BUFFER_SIZE, stream_agents)){
-		if(!first_line_skiped_flag){	// Skip the first line of the .csv file
-			first_line_skiped_flag = 1;
-		} else{
-			// WLAN code
-			char* tmp_agents (strdup(line_agents));
-			const char *wlan_code_aux (GetField(tmp_agents, IX_AGENT_WLAN_CODE));
-			std::string wlan_code;
-			wlan_code.append(ToString(wlan_code_aux));
-			// Skip the line in case we find a Central Controller (CC). Otherwise, read it and initialize the agent
-			if (strcmp(wlan_code.c_str(), "NULL") == 0) {
-				continue;
-			} else {
-				// Agent ID
-				agent_container[agent_ix].agent_id = agent_ix;
-				agent_container[agent_ix].wlan_code = wlan_code.c_str();
-				// WLAN Id
-				for(int w=0; w < total_wlans_number; ++w){
-					if(strcmp(wlan_container[w].wlan_code.c_str(), agent_container[agent_ix].wlan_code.c_str()) == 0) {
-						agent_container[agent_ix].wlan_id = w;
-					}
-				}
-				// Initialize actions and arrays in agents
-				agent_container[agent_ix].InitializeAgent();
-				//  Agent associated to the Central Controller (CC)
-				tmp_agents = strdup(line_agents);
-				int agent_centralized (atoi(GetField(tmp_agents, IX_COMMUNICATION_LEVEL)));
-				agent_container[agent_ix].agent_centralized = agent_centralized;
-				// Check if the central controller has to be created or not
-				if(agent_centralized) ++total_controlled_agents_number;
-				// Time between requests (in seconds)
-				tmp_agents = strdup(line_agents);
-				double time_between_requests (atof(GetField(tmp_agents, IX_AGENT_TIME_BW_REQUESTS)));
-				agent_container[agent_ix].time_between_requests = time_between_requests;
-				// Channel values
-				tmp_agents = strdup(line_agents);
-				std::string channel_values_text = ToString(GetField(tmp_agents, IX_AGENT_CHANNEL_VALUES));
-				// Fill the channel actions array
-				char *channel_aux_2;
-				char *channel_values_text_char = new char[channel_values_text.length() + 1];
-				strcpy(channel_values_text_char, channel_values_text.c_str());
-				channel_aux_2 = strtok (channel_values_text_char,",");
-				int ix (0);
-				while (channel_aux_2 != NULL) {
-					int a (atoi(channel_aux_2));
-					agent_container[agent_ix].list_of_channels[ix] = a;
-					channel_aux_2 = strtok (NULL, ",");
-					++ix;
-				}
-				// sensitivity values
-				tmp_agents = strdup(line_agents);
-				std::string pd_values_text = ToString(GetField(tmp_agents, IX_AGENT_PD_VALUES));
-				// Fill the sensitivity actions array
-				char *pd_aux_2;
-				char *pd_values_text_char = new char[pd_values_text.length() + 1];
-				strcpy(pd_values_text_char, pd_values_text.c_str());
-				pd_aux_2 = strtok (pd_values_text_char,",");
-				ix = 0;
-				while (pd_aux_2 != NULL) {
-					int a = atoi(pd_aux_2);
-					agent_container[agent_ix].list_of_pd_values[ix] = ConvertPower(DBM_TO_PW, a);
-					pd_aux_2 = strtok (NULL, ",");
-					++ix;
-				}
-				// Tx Power values
-				tmp_agents = strdup(line_agents);
-				std::string tx_power_values_text = ToString(GetField(tmp_agents, IX_AGENT_TX_POWER_VALUES));
-				// Fill the TX power actions array
-				char *tx_power_aux_2;
-				char *tx_power_values_text_char = new char[tx_power_values_text.length() + 1];
-				strcpy(tx_power_values_text_char, tx_power_values_text.c_str());
-				tx_power_aux_2 = strtok (tx_power_values_text_char,",");
-				ix = 0;
-				while (tx_power_aux_2 != NULL) {
-					int a (atoi(tx_power_aux_2));
-					agent_container[agent_ix].list_of_tx_power_values[ix] = ConvertPower(DBM_TO_PW, a);
-					tx_power_aux_2 = strtok (NULL, ",");
-					++ix;
-				}
-				// Max bandwidth values
-				tmp_agents = strdup(line_agents);
-				std::string max_bandwidth_values_text = ToString(GetField(tmp_agents, IX_AGENT_MAX_BANDWIDTH));
-				// Fill the max bandwidth actions array
-				char *max_bandwidth_aux_2;
-				char *max_bandwidth_values_text_char = new char[max_bandwidth_values_text.length() + 1];
-				strcpy(max_bandwidth_values_text_char, max_bandwidth_values_text.c_str());
-				max_bandwidth_aux_2 = strtok (max_bandwidth_values_text_char,",");
-				ix = 0;
-				while (max_bandwidth_aux_2 != NULL) {
-					int a (atoi(max_bandwidth_aux_2));
-					agent_container[agent_ix].list_of_max_bandwidth[ix] = a;
-					max_bandwidth_aux_2 = strtok (NULL, ",");
-					++ix;
-				}
-				// Type of reward
-				tmp_agents = strdup(line_agents);
-				int type_of_reward (atoi(GetField(tmp_agents, IX_AGENT_TYPE_OF_REWARD)));
-				agent_container[agent_ix].type_of_reward = type_of_reward;
-				// Learning mechanism
-				tmp_agents = strdup(line_agents);
-				int learning_mechanism (atoi(GetField(tmp_agents, IX_AGENT_LEARNING_MECHANISM)));
-				agent_container[agent_ix].learning_mechanism = learning_mechanism;
-				// Selected strategy
-				tmp_agents = strdup(line_agents);
-				int action_selection_strategy (atoi(GetField(tmp_agents, IX_AGENT_SELECTED_STRATEGY)));
-				agent_container[agent_ix].action_selection_strategy = action_selection_strategy;
-				// Other information
-				agent_container[agent_ix].save_agent_logs = save_agent_logs;
-				agent_container[agent_ix].print_agent_logs = print_agent_logs;
-				agent_container[agent_ix].num_stas = wlan_container[agent_container[agent_ix].wlan_id].num_stas;
-				// TRICKY - USE THE FIRST ELEMENT INT HE LIST OF PD VALUES AS THE MARGIN
-				if(agent_container[agent_ix].learning_mechanism == RTOT_ALGORITHM) {
-					agent_container[agent_ix].margin_rtot = agent_container[agent_ix].list_of_pd_values[0];
-				}
+	for(size_t r = 0; r < rows.size(); ++r){
+		const InputRow &row (rows[r]);
+		// WLAN code
+		const char *wlan_code_aux (row.Field(IX_AGENT_WLAN_CODE));
+		std::string wlan_code;
+		wlan_code.append(ToString(wlan_code_aux));
+		// Skip the line in case we find a Central Controller (CC). Otherwise, read it and initialize the agent
+		if (strcmp(wlan_code.c_str(), "NULL") == 0) {
+			continue;
+		} else {
+			char *save_ptr;
+			// Agent ID
+			agent_container[agent_ix].agent_id = agent_ix;
+			agent_container[agent_ix].seed = seed;
+			agent_container[agent_ix].wlan_code = wlan_code.c_str();
+			// WLAN Id
+			agent_container[agent_ix].wlan_id = GetWlanId(wlan_code);
+			// Initialize actions and arrays in agents
+			agent_container[agent_ix].InitializeAgent();
+			//  Agent associated to the Central Controller (CC)
+			int agent_centralized (atoi(row.Field(IX_COMMUNICATION_LEVEL)));
+			agent_container[agent_ix].agent_centralized = agent_centralized;
+			// Check if the central controller has to be created or not
+			if(agent_centralized) ++total_controlled_agents_number;
+			// Time between requests (in seconds)
+			double time_between_requests (atof(row.Field(IX_AGENT_TIME_BW_REQUESTS)));
+			agent_container[agent_ix].time_between_requests = time_between_requests;
+			// Channel values
+			std::string channel_values_text = ToString(row.Field(IX_AGENT_CHANNEL_VALUES));
+			// Fill the channel actions array
+			char *channel_aux_2;
+			std::vector<char> channel_values_buffer (channel_values_text.c_str(), channel_values_text.c_str() + channel_values_text.size() + 1);
+			channel_aux_2 = strtok_r (&channel_values_buffer[0], ",", &save_ptr);
+			int ix (0);
+			while (channel_aux_2 != NULL) {
+				int a (atoi(channel_aux_2));
+				agent_container[agent_ix].list_of_channels[ix] = a;
+				channel_aux_2 = strtok_r (NULL, ",", &save_ptr);
+				++ix;
+			}
+			// sensitivity values
+			std::string pd_values_text = ToString(row.Field(IX_AGENT_PD_VALUES));
+			// Fill the sensitivity actions array
+			char *pd_aux_2;
+			std::vector<char> pd_values_buffer (pd_values_text.c_str(), pd_values_text.c_str() + pd_values_text.size() + 1);
+			pd_aux_2 = strtok_r (&pd_values_buffer[0], ",", &save_ptr);
+			ix = 0;
+			while (pd_aux_2 != NULL) {
+				int a = atoi(pd_aux_2);
+				agent_container[agent_ix].list_of_pd_values[ix] = ConvertPower(DBM_TO_PW, a);
+				pd_aux_2 = strtok_r (NULL, ",", &save_ptr);
+				++ix;
+			}
+			// Tx Power values
+			std::string tx_power_values_text = ToString(row.Field(IX_AGENT_TX_POWER_VALUES));
+			// Fill the TX power actions array
+			char *tx_power_aux_2;
+			std::vector<char> tx_power_values_buffer (tx_power_values_text.c_str(), tx_power_values_text.c_str() + tx_power_values_text.size() + 1);
+			tx_power_aux_2 = strtok_r (&tx_power_values_buffer[0], ",", &save_ptr);
+			ix = 0;
+			while (tx_power_aux_2 != NULL) {
+				int a (atoi(tx_power_aux_2));
+				agent_container[agent_ix].list_of_tx_power_values[ix] = ConvertPower(DBM_TO_PW, a);
+				tx_power_aux_2 = strtok_r (NULL, ",", &save_ptr);
+				++ix;
+			}
+			// Max bandwidth values
+			std::string max_bandwidth_values_text = ToString(row.Field(IX_AGENT_MAX_BANDWIDTH));
+			// Fill the max bandwidth actions array
+			char *max_bandwidth_aux_2;
+			std::vector<char> max_bandwidth_values_buffer (max_bandwidth_values_text.c_str(), max_bandwidth_values_text.c_str() + max_bandwidth_values_text.size() + 1);
+			max_bandwidth_aux_2 = strtok_r (&max_bandwidth_values_buffer[0], ",", &save_ptr);
+			ix = 0;
+			while (max_bandwidth_aux_2 != NULL) {
+				int a (atoi(max_bandwidth_aux_2));
+				agent_container[agent_ix].list_of_max_bandwidth[ix] = a;
+				max_bandwidth_aux_2 = strtok_r (NULL, ",", &save_ptr);
+				++ix;
+			}
+			// Type of reward
+			int type_of_reward (atoi(row.Field(IX_AGENT_TYPE_OF_REWARD)));
+			agent_container[agent_ix].type_of_reward = type_of_reward;
+			// Learning mechanism
+			int learning_mechanism (atoi(row.Field(IX_AGENT_LEARNING_MECHANISM)));
+			agent_container[agent_ix].learning_mechanism = learning_mechanism;
+			// Selected strategy
+			int action_selection_strategy (atoi(row.Field(IX_AGENT_SELECTED_STRATEGY)));
+			agent_container[agent_ix].action_selection_strategy = action_selection_strategy;
+			// Other information
+			agent_container[agent_ix].save_agent_logs = save_agent_logs;
+			agent_container[agent_ix].print_agent_logs = print_agent_logs;
+			agent_container[agent_ix].num_stas = wlan_container[agent_container[agent_ix].wlan_id].num_stas;
+			// TRICKY - USE THE FIRST ELEMENT INT HE LIST OF PD VALUES AS THE MARGIN
+			if(agent_container[agent_ix].learning_mechanism == RTOT_ALGORITHM) {
+				agent_container[agent_ix].margin_rtot = agent_container[agent_ix].list_of_pd_values[0];
+			}
 
-				agent_container[agent_ix].PrintAgentInfo();
+			agent_container[agent_ix].PrintAgentInfo();
 
-				++agent_ix;
+			++agent_ix;
 
-			}
-			free(tmp_agents);
 		}
 	}
 	if (print_system_logs) printf("%s Agents parameters set!\n", LOG_LVL4);
@@ -987,10 +1347,9 @@ void Komondor :: GenerateAgents(const char *agents_filename, const char *simulat
 }
 
 /**
- * Generate the central controller (if active), according to the input agents file
- * @param "agents_filename" [type char*]: filename of the agents input CSV
+ * Generate the central controller (if active), according to the agents input file of the input scenario
  */
-void Komondor :: GenerateCentralController(const char *agents_filename) {
+void Komondor :: GenerateCentralController() {
 
 	if (print_system_logs) printf("%s Generating the Central Controller...\n", LOG_LVL1);
 	// So far, we consider a single controller. For scalability purposes, the CC must be declared as an array
@@ -998,6 +1357,7 @@ void Komondor :: GenerateCentralController(const char *agents_filename) {
 	if (total_controlled_agents_number > 0) {	// Check that the CC has one or more agents attached
 		central_controller[0].controller_on = TRUE;
 		central_controller[0].agents_number = total_controlled_agents_number;
+		central_controller[0].seed = seed;
 		central_controller[0].wlans_number = total_wlans_number;
 		int max_number_of_actions(0);
 		for (int agent_ix = 0; agent_ix < total_controlled_agents_number; ++agent_ix) {
@@ -1030,53 +1390,42 @@ void Komondor :: GenerateCentralController(const char *agents_filename) {
 		// The overall "time between requests" is set to the maximum among all the agents
 		central_controller[0].list_of_agents = agents_list;
 		// Initialize the CC with parameters from the agents input file
-		FILE* stream_cc = fopen(agents_filename, "r");
-		char line_agents[CHAR_BUFFER_SIZE];
-		char* tmp_cc (strdup(line_agents));
-		first_line_skiped_flag = 0;		// Flag for skipping first informative line of input file
-		while (fgets(line_agents, CHAR_BUFFER_SIZE, stream_cc)){
-			if(!first_line_skiped_flag){
-				first_line_skiped_flag = 1;
-			} else{
-				tmp_cc = strdup(line_agents);
-				const char *wlan_code_aux (GetField(tmp_cc, IX_AGENT_WLAN_CODE));
-				std::string wlan_code;
-				wlan_code.append(ToString(wlan_code_aux));
-				// Skip the line in case we find a Central Controller (CC). Otherwise, read it and initialize the agent
-				if (strcmp(wlan_code.c_str(), "NULL") == 0) {
-					// Time between requests
-					tmp_cc = strdup(line_agents);
-					double time_between_requests (atoi(GetField(tmp_cc, IX_AGENT_TIME_BW_REQUESTS)));
-					central_controller[0].time_between_requests = time_between_requests;
-					// Type of reward
-					tmp_cc = strdup(line_agents);
-					int type_of_reward (atoi(GetField(tmp_cc, IX_AGENT_TYPE_OF_REWARD)));
-					central_controller[0].type_of_reward = type_of_reward;
-					// Learning mechanism
-					tmp_cc = strdup(line_agents);
-					int learning_mechanism (atoi(GetField(tmp_cc, IX_AGENT_LEARNING_MECHANISM)));
-					central_controller[0].learning_mechanism = learning_mechanism;
-					// Selected strategy
-					tmp_cc = strdup(line_agents);
-					int action_selection_strategy (atoi(GetField(tmp_cc, IX_AGENT_SELECTED_STRATEGY)));
-					central_controller[0].action_selection_strategy = action_selection_strategy;
-					// Find the length of the channel actions array
-					tmp_cc = strdup(line_agents);
-					const char *channel_values_aux (GetField(tmp_cc, IX_AGENT_CHANNEL_VALUES));
-					std::string channel_values_text;
-					channel_values_text.append(ToString(channel_values_aux));
-					const char *channels_aux;
-					channels_aux = strtok ((char*)channel_values_text.c_str(),",");
-					int num_arms_channels = 0;
-					while (channels_aux != NULL) {
-						channels_aux = strtok (NULL, ",");
-						++ num_arms_channels;
-					}
-					free(tmp_cc);
-					break;	// Don't read all the other lines (entailed for agents)
-				} else {
-					continue; // Keep reading until finding "NULL", which indicated the CC line
+		const std::vector<InputRow> &rows (input_scenario->agents.rows);
+		for(size_t r = 0; r < rows.size(); ++r){
+			const InputRow &row (rows[r]);
+			const char *wlan_code_aux (row.Field(IX_AGENT_WLAN_CODE));
+			std::string wlan_code;
+			wlan_code.append(ToString(wlan_code_aux));
+			// Skip the line in case we find a Central Controller (CC). Otherwise, read it and initialize the agent
+			if (strcmp(wlan_code.c_str(), "NULL") == 0) {
+				// Time between requests
+				double time_between_requests (atoi(row.Field(IX_AGENT_TIME_BW_REQUESTS)));
+				central_controller[0].time_between_requests = time_between_requests;
+				// Type of reward
+				int type_of_reward (atoi(row.Field(IX_AGENT_TYPE_OF_REWARD)));
+				central_controller[0].type_of_reward = type_of_reward;
+				// Learning mechanism
+				int learning_mechanism (atoi(row.Field(IX_AGENT_LEARNING_MECHANISM)));
+				central_controller[0].learning_mechanism = learning_mechanism;
+				// Selected strategy
+				int action_selection_strategy (atoi(row.Field(IX_AGENT_SELECTED_STRATEGY)));
+				central_controller[0].action_selection_strategy = action_selection_strategy;
+				// Find the length of the channel actions array
+				const char *channel_values_aux (row.Field(IX_AGENT_CHANNEL_VALUES));
+				std::string channel_values_text;
+				channel_values_text.append(ToString(channel_values_aux));
+				char *save_ptr;
+				const char *channels_aux;
+				std::vector<char> channel_values_buffer (channel_values_text.c_str(), channel_values_text.c_str() + channel_values_text.size() + 1);
+				channels_aux = strtok_r (&channel_values_buffer[0], ",", &save_ptr);
+				int num_arms_channels = 0;
+				while (channels_aux != NULL) {
+					channels_aux = strtok_r (NULL, ",", &save_ptr);
+					++ num_arms_channels;
 				}
+				break;	// Don't read all the other lines (entailed for agents)
+			} else {
+				continue; // Keep reading until finding "NULL", which indicated the CC line
 			}
 		}
 
@@ -1108,6 +1457,7 @@ void Komondor :: PrintSystemInfo(){
 		printf("%s pdf_tx_time = %d\n", LOG_LVL3, pdf_tx_time);
 		printf("%s backoff_type = %d\n", LOG_LVL3, backoff_type);
 		printf("%s path_loss_model = %d\n", LOG_LVL3, path_loss_model);
+		if(!path_loss_matrix_filename.empty()) printf("%s path_loss_matrix = %s\n", LOG_LVL3, path_loss_matrix_filename.c_str());
 		printf("%s adjacent_channel_model = %d\n", LOG_LVL3, adjacent_channel_model);
 		printf("%s collisions_model = %d\n", LOG_LVL3, collisions_model);
 		printf("\n");
@@ -1123,6 +1473,7 @@ void Komondor :: WriteSystemInfo(Logger logger){
 	fprintf(logger.file, "%s pdf_backoff = %d\n", LOG_LVL3, pdf_backoff);
 	fprintf(logger.file, "%s pdf_tx_time = %d\n", LOG_LVL3, pdf_tx_time);
 	fprintf(logger.file, "%s path_loss_model = %d\n", LOG_LVL3, path_loss_model);
+	if(!path_loss_matrix_filename.empty()) fprintf(logger.file, "%s path_loss_matrix = %s\n", LOG_LVL3, path_loss_matrix_filename.c_str());
 	fprintf(logger.file, "%s adjacent_channel_model = %d\n", LOG_LVL3, adjacent_channel_model);
 	fprintf(logger.file, "%s collisions_model = %d\n", LOG_LVL3, collisions_model);
 }
@@ -1203,129 +1554,80 @@ void Komondor :: WriteAllAgentsInfo(Logger logger, std::string header_str){
 /*******************/
 
 /**
- * Return a field corresponding to a given index from a CSV file
- * @param "line" [type char*]: line of the CSV
- * @param "num" [type int]: field number (index)
- * @return "field" [type char*]: field corresponding to the introduced index
+ * Return the WLAN ID of a WLAN code (interned when reading the nodes)
+ * @param "wlan_code" [type std::string]: code of the WLAN
+ * @return "wlan_id" [type int]: WLAN ID, WLAN_ID_NONE if no AP declares the code
  */
-const char* GetField(char* line, int num){
-    const char* tok;
-    for (tok = strtok(line, ";");
-            tok && *tok;
-            tok = strtok(NULL, ";\n"))
-    {
-        if (!--num)
-            return tok;
-    }
-    return NULL;
+int Komondor :: GetWlanId(const std::string &wlan_code){
+	std::map<std::string, int>::iterator it (wlan_id_per_code.find(wlan_code));
+	return (it == wlan_id_per_code.end()) ? WLAN_ID_NONE : it->second;
 }
 
 /**
- * Return the number of lines of a csv file
- * @param "filename" [type char*]: CSV filename
- * @return "num_lines" [type int]: number of lines in the csv file
+ * Determine whether two nodes belong to the same WLAN (the ones without WLAN are compared by code)
+ * @param "n" [type int]: first node
+ * @param "m" [type int]: second node
+ * @return "same_wlan" [type int]: TRUE if both nodes belong to the same WLAN
  */
-int Komondor :: GetNumOfLines(const char *filename){
-	int num_lines (0);
-	// Nodes file
-	FILE* stream = fopen(filename, "r");
-	if (!stream){
-		printf("Nodes configuration file %s not found!\n", filename);
-		exit(-1);
-	}
-	char line[CHAR_BUFFER_SIZE];
-	while (fgets(line, CHAR_BUFFER_SIZE, stream))
-	{
-		++num_lines;
-	}
-	num_lines--;
-	fclose(stream);
-	return num_lines;
+int Komondor :: SameWlan(int n, int m){
+	if(node_container[n].wlan.wlan_id != node_container[m].wlan.wlan_id) return FALSE;
+	return (node_container[n].wlan.wlan_id != WLAN_ID_NONE || node_container[n].wlan_code == node_container[m].wlan_code);
 }
 
 /**
- * Return the number of nodes of a given type (0: AP, 1: STA, 2: Free Node)
- * @param "nodes_filename" [type char*]: nodes configuration filename
+ * Return the number of nodes of a given type (0: AP, 1: STA, 2: Free Node) in the nodes input file
  * @param "node_type" [type int]: type of node to consider in the counting
  * @param "wlan_code" [type std::string]: code of the wlan to consider in the counting
  * @return "num_nodes" [type int]: number of nodes of the introduced type in the indicated WLAN
  */
-int Komondor :: GetNumOfNodes(const char *nodes_filename, int node_type, std::string wlan_code){
+int Komondor :: GetNumOfNodes(int node_type, std::string wlan_code){
 
+	const std::vector<InputRow> &rows (input_scenario->nodes.rows);
 	int num_nodes(0);
-	char line_nodes[CHAR_BUFFER_SIZE];
-	first_line_skiped_flag = 0;
 	int type_found;
 	std::string wlan_code_found;
 
-	FILE* stream_nodes = fopen(nodes_filename, "r");
-
-	if (!stream_nodes){
-		printf("[MAIN] ERROR: Nodes configuration file %s not found!\n", nodes_filename);
-		exit(-1);
-	}
-
 	if(node_type == NODE_TYPE_UNKWNOW){	// Count all type of nodes
 
-		num_nodes = GetNumOfLines(nodes_filename);
+		num_nodes = (int) rows.size();
 
 	} else {	// Count specific nodes
 
-		while (fgets(line_nodes, CHAR_BUFFER_SIZE, stream_nodes)){
-
-			if(!first_line_skiped_flag){
-
-				first_line_skiped_flag = 1;
+		for(size_t r = 0; r < rows.size(); ++r){
 
-			} else{
+			// Node type
+			type_found = atof(rows[r].Field(IX_NODE_TYPE));
 
-				// Node type
-				tmp_nodes = strdup(line_nodes);
-				type_found = atof(GetField(tmp_nodes, IX_NODE_TYPE));
-				free(tmp_nodes);
-
-				// WLAN code
-				tmp_nodes = strdup(line_nodes);
-				wlan_code_found = ToString(GetField(tmp_nodes, IX_WLAN_CODE));
-				free(tmp_nodes);
+			// WLAN code
+			wlan_code_found = ToString(rows[r].Field(IX_WLAN_CODE));
 
-				if(wlan_code.compare(ToString("")) > 0){
-					if(type_found == node_type && strcmp(wlan_code_found.c_str(), wlan_code.c_str()) == 0) ++num_nodes;
-				} else {
-					if(type_found == node_type) ++num_nodes;
-				}
+			if(wlan_code.compare(ToString("")) > 0){
+				if(type_found == node_type && strcmp(wlan_code_found.c_str(), wlan_code.c_str()) == 0) ++num_nodes;
+			} else {
+				if(type_found == node_type) ++num_nodes;
 			}
 		}
 	}
 
-	fclose(stream_nodes);
 	return num_nodes;
 }
 
 /**
- * Return TRUE if there is a Central Controller declared. FALSE, otherwise.
+ * Return TRUE if there is a Central Controller declared in the agents input file. FALSE, otherwise.
  * The CC is declared in any line by setting the WLAN_CODE field to "NULL"
- * @param "nodes_filename" [type char*]: nodes configuration filename
  * @return "presence_central_cotnroller" [type bool]: flag indicating whether a CC is present or not
  */
-int Komondor :: CheckCentralController(const char *agents_filename){
+int Komondor :: CheckCentralController(){
 	int presence_central_cotnroller(FALSE);
-	FILE* stream_agents = fopen(agents_filename, "r");
-	char line_agents[CHAR_BUFFER_SIZE];
-	first_line_skiped_flag = 0;	// Flag for skipping first informative line of input file
-	while (fgets(line_agents, CHAR_BUFFER_SIZE, stream_agents)){
-		if(!first_line_skiped_flag){	// Skip the first line of the .csv file
-			first_line_skiped_flag = 1;
-		} else{
-			// WLAN code
-			char* tmp_agents (strdup(line_agents));
-			const char *wlan_code_aux (GetField(tmp_agents, IX_AGENT_WLAN_CODE));
-			std::string wlan_code;
-			wlan_code.append(ToString(wlan_code_aux));
-			// Skip the line in case we find a Central Controller (CC). Otherwise, read it and initialize the agent
-			if (strcmp(wlan_code.c_str(), "NULL") == 0) {
-				presence_central_cotnroller = TRUE;
-			}
+	const std::vector<InputRow> &rows (input_scenario->agents.rows);
+	for(size_t r = 0; r < rows.size(); ++r){
+		// WLAN code
+		const char *wlan_code_aux (rows[r].Field(IX_AGENT_WLAN_CODE));
+		std::string wlan_code;
+		wlan_code.append(ToString(wlan_code_aux));
+		// Skip the line in case we find a Central Controller (CC). Otherwise, read it and initialize the agent
+		if (strcmp(wlan_code.c_str(), "NULL") == 0) {
+			presence_central_cotnroller = TRUE;
 		}
 	}
 	return presence_central_cotnroller;
@@ -1334,6 +1636,77 @@ int Komondor :: CheckCentralController(const char *agents_filename){
 /**********/
 /* main() */
 /**********/
+/* Settings of a batch of replications run in the same process (one engine per replication) */
+struct ReplicationPool {
+	const char *nodes_input_filename;	///> Filename of the nodes input CSV
+	const char *agents_input_filename;	///> Filename of the agents input CSV
+	const InputScenario *input_scenario;	///> Contents of the input files (read once, shared by all the replications)
+	const char *script_output_filename;	///> Filename of the script output (shared by all the replications)
+	std::string simulation_code;		///> Simulation code (the replication index is appended)
+	const char *event_queue;			///> Event queue backend of every engine
+	int save_node_logs;					///> Flag for activating the log writting of nodes
+	int save_agent_logs;				///> Flag for activating the log writting of agents
+	int print_system_logs;				///> Flag for activating the printing of system logs
+	int print_node_logs;				///> Flag for activating the printing of node logs
+	int print_agent_logs;				///> Flag for activating the printing of agent logs
+	int agents_enabled;					///> Flag for activating agents
+	double sim_time;					///> Simulation time [s]
+	double connection_margin_db;		///> Margin below the noise under which transmissions are not delivered [dB]
+	double interference_radius;			///> Only the nodes closer than this (or in the same WLAN) compute their links (0: all) [m]
+	double shadowing_decorrelation;		///> Size of the cells sharing their random losses (0: independent per link) [m]
+	int first_seed;						///> Seed of the first replication (replication r uses first_seed + r)
+	int num_replications;				///> Total number of replications
+	int next_replication;				///> Next replication to be picked by a worker
+	pthread_mutex_t mutex;				///> Protects next_replication
+};
+
+/**
+ * Worker thread: picks replications from the pool until all of them are done. Each replication
+ * builds its own Komondor engine on this thread, so that its components, allocators and random
+ * number generator are not shared with the other replications. The input files are not read
+ * again: every replication copies its nodes and agents from the shared input scenario.
+ * @param "pool_ptr" [type ReplicationPool*]: shared settings of the replications
+ */
+void *RunReplications(void *pool_ptr){
+
+	ReplicationPool *pool = (ReplicationPool *) pool_ptr;
+
+	while(TRUE) {
+		pthread_mutex_lock(&pool->mutex);
+		int replication_ix (pool->next_replication);
+		++pool->next_replication;
+		pthread_mutex_unlock(&pool->mutex);
+		if(replication_ix >= pool->num_replications) break;
+
+		int seed (pool->first_seed + replication_ix);
+		std::string simulation_code (pool->simulation_code);
+		simulation_code.append("_rep").append(ToString(replication_ix));
+
+		// The engine becomes the current one of this thread: the components created by Setup() attach to it
+		Komondor *komondor_simulation = new Komondor;
+		if(!komondor_simulation->EventQueue(pool->event_queue)) {
+			printf("%sERROR: Unknown event queue '%s' (use simple, heap, dary, calendar or ladder)\n", LOG_LVL1, pool->event_queue);
+			exit(-1);
+		}
+		komondor_simulation->Seed = seed;
+		komondor_simulation->StopTime(pool->sim_time);
+		komondor_simulation->num_island_threads = 1;	// Replications already fill the cores
+		komondor_simulation->connection_margin_db = pool->connection_margin_db;
+		komondor_simulation->interference_radius = pool->interference_radius;
+		komondor_simulation->shadowing_decorrelation = pool->shadowing_decorrelation;
+		komondor_simulation->Setup(pool->sim_time, pool->save_node_logs, pool->save_agent_logs,
+			pool->print_system_logs, pool->print_node_logs, pool->print_agent_logs, pool->nodes_input_filename,
+			pool->script_output_filename, simulation_code.c_str(), seed, pool->agents_enabled,
+			pool->agents_input_filename, pool->input_scenario);
+
+		printf("%s REPLICATION %d (seed %d) STARTED\n", LOG_LVL1, replication_ix, seed);
+		komondor_simulation->Run();
+		delete komondor_simulation;
+	}
+
+	return NULL;
+}
+
 int main(int argc, char *argv[]){
 
 	printf("\n");
@@ -1346,7 +1719,7 @@ int main(int argc, char *argv[]){
 
 	// Input variables
 	char *nodes_input_filename;
-	char *agents_input_filename;
+	char *agents_input_filename = NULL;
 	std::string script_output_filename;
 	std::string simulation_code;
 	int save_node_logs;
@@ -1357,8 +1730,60 @@ int main(int argc, char *argv[]){
 	double sim_time;
 	int seed;
 	int agents_enabled;
-
-	total_nodes_number = 0;
+	const char *event_queue = "simple";	// Event queue backend of the simulation engine
+	int num_replications (1);			// Number of replications (seeds seed, seed+1, ...) run in this process
+	int num_threads (0);				// Number of worker threads for the replications (0: one per core)
+	int num_island_threads (1);			// Number of threads running the interference islands of a simulation
+	const char *save_snapshot = NULL;	// Snapshot to be written at snapshot_time (e.g., after the warm-up)
+	double snapshot_time (0);			// Time at which the snapshot is written [s]
+	const char *load_snapshot = NULL;	// Snapshot to resume the simulation from (same inputs required)
+	const char *sweep = NULL;			// Sweep of the form parameter:value,value,... (one variant per value)
+	double sweep_time (0);				// Time at which the variants are forked and the statistics cleared [s]
+	int num_sweep_processes (0);		// Number of variants running at the same time (0: one per core)
+	double connection_margin_db (CONNECTION_MARGIN_DB);	// Margin below the noise under which transmissions are not delivered [dB]
+	double interference_radius (0);		// Only the nodes closer than this (or in the same WLAN) compute their links (0: all) [m]
+	double shadowing_decorrelation (0);	// Size of the cells sharing their random losses (0: independent per link) [m]
+
+	// Options of the form --name=value may appear anywhere: strip them before parsing positional arguments
+	int num_positional_args (1);
+	for(int i = 1; i < argc; ++i) {
+		if(strncmp(argv[i], "--event_queue=", strlen("--event_queue=")) == 0) {
+			event_queue = argv[i] + strlen("--event_queue=");
+		} else if(strncmp(argv[i], "--replications=", strlen("--replications=")) == 0) {
+			num_replications = atoi(argv[i] + strlen("--replications="));
+		} else if(strncmp(argv[i], "--threads=", strlen("--threads=")) == 0) {
+			num_threads = atoi(argv[i] + strlen("--threads="));
+		} else if(strncmp(argv[i], "--island_threads=", strlen("--island_threads=")) == 0) {
+			num_island_threads = atoi(argv[i] + strlen("--island_threads="));
+		} else if(strncmp(argv[i], "--save_snapshot=", strlen("--save_snapshot=")) == 0) {
+			save_snapshot = argv[i] + strlen("--save_snapshot=");
+		} else if(strncmp(argv[i], "--snapshot_time=", strlen("--snapshot_time=")) == 0) {
+			snapshot_time = atof(argv[i] + strlen("--snapshot_time="));
+		} else if(strncmp(argv[i], "--load_snapshot=", strlen("--load_snapshot=")) == 0) {
+			load_snapshot = argv[i] + strlen("--load_snapshot=");
+		} else if(strncmp(argv[i], "--sweep=", strlen("--sweep=")) == 0) {
+			sweep = argv[i] + strlen("--sweep=");
+		} else if(strncmp(argv[i], "--sweep_time=", strlen("--sweep_time=")) == 0) {
+			sweep_time = atof(argv[i] + strlen("--sweep_time="));
+		} else if(strncmp(argv[i], "--sweep_processes=", strlen("--sweep_processes=")) == 0) {
+			num_sweep_processes = atoi(argv[i] + strlen("--sweep_processes="));
+		} else if(strncmp(argv[i], "--connection_margin=", strlen("--connection_margin=")) == 0) {
+			connection_margin_db = atof(argv[i] + strlen("--connection_margin="));
+		} else if(strncmp(argv[i], "--interference_radius=", strlen("--interference_radius=")) == 0) {
+			interference_radius = atof(argv[i] + strlen("--interference_radius="));
+		} else if(strncmp(argv[i], "--shadowing_decorrelation=", strlen("--shadowing_decorrelation=")) == 0) {
+			shadowing_decorrelation = atof(argv[i] + strlen("--shadowing_decorrelation="));
+		} else if(strncmp(argv[i], "--fast_power_conversion=", strlen("--fast_power_conversion=")) == 0) {
+			fast_power_conversion = atoi(argv[i] + strlen("--fast_power_conversion="));
+		} else if(strncmp(argv[i], "--", 2) == 0) {
+			printf("%sERROR: Unknown option '%s'!\n", LOG_LVL1, argv[i]);
+			return(-1);
+		} else {
+			argv[num_positional_args] = argv[i];
+			++num_positional_args;
+		}
+	}
+	argc = num_positional_args;
 
 	// Get input variables per console
 	if(argc == NUM_FULL_ARGUMENTS_CONSOLE){	// Full configuration entered per console
@@ -1429,7 +1854,19 @@ int main(int argc, char *argv[]){
 			" + For PARTIAL configuration setting, execute\n"
 			"    ./KomondorSimulation -system_input_filename -nodes_input_filename -sim_time -seed\n"
 			" + For PARTIAL configuration setting (SCRIPTS), execute\n"
-			"    ./KomondorSimulation -system_input_filename -nodes_input_filename -simulation_code -sim_time -seed\n", LOG_LVL1);
+			"    ./KomondorSimulation -system_input_filename -nodes_input_filename -simulation_code -sim_time -seed\n"
+			" + Optional flags (any position)\n"
+			"    --event_queue=simple|heap|dary|calendar|ladder\n"
+			"    --replications=N (seeds seed...seed+N-1 run in this process) --threads=T\n"
+			"    --island_threads=P (interference islands run in parallel)\n"
+			"    --save_snapshot=FILE --snapshot_time=T (state at T, e.g. after the warm-up)\n"
+			"    --load_snapshot=FILE (resume a snapshot of the same scenario, traffic and DCB inputs may change)\n"
+			"    --sweep=traffic_load|dcb_policy|agent_strategy:V1,V2,... --sweep_time=T --sweep_processes=N\n"
+			"      (the warm-up until T is shared, then one process per value)\n"
+			"    --connection_margin=DB (transmissions received this far below the noise are not delivered)\n"
+			"    --interference_radius=R (only the nodes closer than R meters or in the same WLAN are linked)\n"
+			"    --shadowing_decorrelation=D (links between the same cells of D meters share their random losses)\n"
+			"    --fast_power_conversion=1 (approximate dB/linear conversions in the hot paths, error below 1e-7 dB)\n", LOG_LVL1);
 		return(-1);
 	}
 
@@ -1445,6 +1882,59 @@ int main(int argc, char *argv[]){
 		printf("%s print_node_logs: %d\n", LOG_LVL2, print_node_logs);
 		printf("%s sim_time: %f s\n", LOG_LVL2, sim_time);
 		printf("%s seed: %d\n", LOG_LVL2, seed);
+		printf("%s event_queue: %s\n", LOG_LVL2, event_queue);
+		printf("%s replications: %d\n", LOG_LVL2, num_replications);
+		printf("%s island_threads: %d\n", LOG_LVL2, num_island_threads);
+		if (save_snapshot != NULL) printf("%s save_snapshot: %s at %f s\n", LOG_LVL2, save_snapshot, snapshot_time);
+		if (load_snapshot != NULL) printf("%s load_snapshot: %s\n", LOG_LVL2, load_snapshot);
+		if (sweep != NULL) printf("%s sweep: %s from %f s\n", LOG_LVL2, sweep, sweep_time);
+		printf("%s connection_margin: %.1f dB\n", LOG_LVL2, connection_margin_db);
+		if (interference_radius > 0) printf("%s interference_radius: %.1f m\n", LOG_LVL2, interference_radius);
+		if (shadowing_decorrelation > 0) printf("%s shadowing_decorrelation: %.1f m\n", LOG_LVL2, shadowing_decorrelation);
+	}
+
+	if((save_snapshot != NULL || load_snapshot != NULL) && num_replications > 1) {
+		printf("%sERROR: Snapshots cannot be combined with replications!\n", LOG_LVL1);
+		return(-1);
+	}
+
+	// Parse the sweep: parameter name and list of values
+	int sweep_parameter (SWEEP_TRAFFIC_LOAD);
+	std::vector<double> sweep_values;
+	if(sweep != NULL) {
+		const char *values = strchr(sweep, ':');
+		std::string parameter_name (sweep, values != NULL ? values - sweep : strlen(sweep));
+		if(parameter_name == "traffic_load") {
+			sweep_parameter = SWEEP_TRAFFIC_LOAD;
+		} else if(parameter_name == "dcb_policy") {
+			sweep_parameter = SWEEP_DCB_POLICY;
+		} else if(parameter_name == "agent_strategy") {
+			sweep_parameter = SWEEP_AGENT_STRATEGY;
+		} else {
+			printf("%sERROR: Unknown sweep parameter '%s' (use traffic_load, dcb_policy or agent_strategy)\n",
+				LOG_LVL1, parameter_name.c_str());
+			return(-1);
+		}
+		while(values != NULL) {
+			sweep_values.push_back(atof(values + 1));
+			values = strchr(values + 1, ',');
+		}
+		if(sweep_values.empty()) {
+			printf("%sERROR: The sweep '%s' has no values!\n", LOG_LVL1, sweep);
+			return(-1);
+		}
+		if(sweep_time <= 0 || sweep_time >= sim_time) {
+			printf("%sERROR: The sweep time must be in (0, sim_time)!\n", LOG_LVL1);
+			return(-1);
+		}
+		if(num_replications > 1 || num_island_threads > 1 || save_snapshot != NULL) {
+			printf("%sERROR: Sweeps cannot be combined with replications, island threads or saving snapshots!\n", LOG_LVL1);
+			return(-1);
+		}
+		if(sweep_parameter == SWEEP_AGENT_STRATEGY && !agents_enabled) {
+			printf("%sERROR: Sweeping the agent strategy requires agents!\n", LOG_LVL1);
+			return(-1);
+		}
 	}
 
 
@@ -1464,14 +1954,73 @@ int main(int argc, char *argv[]){
 	}
 
 
+	// Read the input files once (the replications and the variants of a sweep share them)
+	InputScenario input_scenario;
+	input_scenario.ReadInputScenario("../config_models", nodes_input_filename,
+		agents_enabled ? agents_input_filename : NULL, print_system_logs);
+
+	// Run several replications in parallel, each one with its own engine
+	if(num_replications > 1) {
+		ReplicationPool pool;
+		pool.nodes_input_filename = nodes_input_filename;
+		pool.agents_input_filename = agents_input_filename;
+		pool.input_scenario = &input_scenario;
+		pool.script_output_filename = script_output_filename.c_str();
+		pool.simulation_code = simulation_code;
+		pool.event_queue = event_queue;
+		pool.save_node_logs = save_node_logs;
+		pool.save_agent_logs = save_agent_logs;
+		pool.print_system_logs = print_system_logs;
+		pool.print_node_logs = print_node_logs;
+		pool.print_agent_logs = print_agent_logs;
+		pool.agents_enabled = agents_enabled;
+		pool.sim_time = sim_time;
+		pool.connection_margin_db = connection_margin_db;
+		pool.interference_radius = interference_radius;
+		pool.shadowing_decorrelation = shadowing_decorrelation;
+		pool.first_seed = seed;
+		pool.num_replications = num_replications;
+		pool.next_replication = 0;
+		pthread_mutex_init(&pool.mutex, NULL);
+		if(num_threads <= 0) num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+		if(num_threads > num_replications) num_threads = num_replications;
+		printf("------------------------------------------\n");
+		printf("%s SIMULATION '%s' STARTED (%d replications on %d threads)\n", LOG_LVL1,
+			simulation_code.c_str(), num_replications, num_threads);
+		std::vector<pthread_t> workers(num_threads);
+		for(int t = 0; t < num_threads; ++t) {
+			pthread_create(&workers[t], NULL, RunReplications, &pool);
+		}
+		for(int t = 0; t < num_threads; ++t) {
+			pthread_join(workers[t], NULL);
+		}
+		pthread_mutex_destroy(&pool.mutex);
+		return(0);
+	}
+
 	// Generate a Komondor component to start the simulation
 	Komondor komondor_simulation;
-	komondor_simulation.Seed = seed;
-	srand(seed); // Needed for ensuring randomness dependency on seed
+	if(!komondor_simulation.EventQueue(event_queue)) {
+		printf("%sERROR: Unknown event queue '%s' (use simple, heap, dary, calendar or ladder)\n", LOG_LVL1, event_queue);
+		exit(-1);
+	}
+	komondor_simulation.Seed = seed;	// Seeds the random number generator owned by the engine
 	komondor_simulation.StopTime(sim_time);
+	komondor_simulation.num_island_threads = num_island_threads;
+	komondor_simulation.connection_margin_db = connection_margin_db;
+	komondor_simulation.interference_radius = interference_radius;
+	komondor_simulation.shadowing_decorrelation = shadowing_decorrelation;
+	if(save_snapshot != NULL) komondor_simulation.SaveSnapshot(snapshot_time, save_snapshot);
+	if(load_snapshot != NULL) komondor_simulation.LoadSnapshot(load_snapshot);
+	komondor_simulation.sweep_parameter = sweep_parameter;
+	komondor_simulation.sweep_values = sweep_values;
+	if(!sweep_values.empty()) {
+		komondor_simulation.ClearStatsTime(sweep_time);
+		komondor_simulation.Branches((int) sweep_values.size(), num_sweep_processes);
+	}
 	komondor_simulation.Setup(sim_time, save_node_logs, save_agent_logs, print_system_logs,
 		print_node_logs, print_agent_logs, nodes_input_filename, script_output_filename.c_str(),
-		simulation_code.c_str(), seed, agents_enabled, agents_input_filename);
+		simulation_code.c_str(), seed, agents_enabled, agents_input_filename, &input_scenario);
 
 	printf("------------------------------------------\n");
 	printf("%s SIMULATION '%s' STARTED\n", LOG_LVL1, simulation_code.c_str());
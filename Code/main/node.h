@@ -67,8 +67,10 @@
 #include "../structures/wlan.h"
 #include "../structures/logger.h"
 #include "../structures/FIFO.h"
+#include "../structures/medium.h"
 #include "../structures/node_configuration.h"
 #include "../structures/performance.h"
+#include "../structures/random_stream.h"
 
 #define __SAVELOGS__
 
@@ -88,6 +90,7 @@ component Node : public TypeII{
 		void Setup();
 		void Start();
 		void Stop();
+		void Checkpoint(CostSnapshot &snapshot);
 
 		// Generic
 		void InitializeVariables();
@@ -102,11 +105,16 @@ component Node : public TypeII{
 		void PrintOrWriteNodeStatistics(int write_or_print);
 		void HandleSlottedBackoffCollision();
 		void StartSavingLogs();
+		void WriteNodesTransmitting();
 		void RecoverFromCtsTimeout();
 		void MeasureRho();
 		void SaveSimulationPerformance();
+		void ClearStatistics();
 
 		// Packets
+		void SenseTransmissionStart(const Notification &notification);
+		void RecomputeChannelPower();
+		void RefreshPowerReceived(const Notification &notification);
 		Notification GenerateNotification(int packet_type, int destination_id,
 			int packet_id, int num_packets_aggregated, double timestamp_generated, double tx_duration);
 		void SelectDestination();
@@ -129,6 +137,7 @@ component Node : public TypeII{
 		// Configuration (to be sent to the agent)
 		void GenerateConfiguration();
 		void ApplyNewConfiguration(Configuration &received_configuration);
+		void SubscribeToChannels();
 		void BroadcastNewConfigurationToStas(Configuration &received_configuration);
 		void UpdatePerformanceMeasurements();
 
@@ -154,7 +163,7 @@ component Node : public TypeII{
 		int current_dcb_policy;			///> Channel bonding model (definition of models in function GetTxChannelsByChannelBonding())
 										///> - If set, this parameter determines the min and max channel allowed
 		int current_max_bandwidth;		///> Maximum bandwidth allowed [no. of 20-MHz channels]
-		FIFO buffer;					///> FIFO buffer (contains Notifications)
+		FIFO buffer;					///> FIFO buffer (ring of Packet descriptors: id and generation timestamp)
 		int last_packet_generated_id;	///> ID of the last packet generated by the source
 
 		// Spatial Reuse operation
@@ -178,12 +187,14 @@ component Node : public TypeII{
 		int save_node_logs;					///> Flag for activating the log writting of nodes
 		int print_node_logs;				///> Flag for activating the printing of node logs
 		std::string simulation_code;		///> Simulation code
+		int seed;							///> Simulation seed (key of the node's random streams)
 		int capture_effect_model;			///> Capture Effect model
 		int nack_activated;					///> Flag for activating the utilization of NACKs
 
 		// Channel
 		int adjacent_channel_model;			///> Adjacent channel interference model (definition of models in function UpdateChannelsPower())
 		int pifs_activated;					///> PIFS mechanism activation
+		Medium *medium;						///> Medium shared by the nodes (delivers the transmissions to the nodes subscribed to their channels)
 
 		// Transmissions
 		int current_modulation;				///> Current_modulation used by nodes
@@ -207,8 +218,7 @@ component Node : public TypeII{
 		int backoff_type;					///> Type of Backoff (0: Slotted 1: Continuous)
 		int cw_adaptation;					///> CW adaptation (0: constant, 1: bineary exponential backoff)
 
-		double *distances_array;					///> Distance with respect to other nodes
-		double *received_power_array;				///> Power received from the other nodes
+		LinkBudgetView links;						///> Distance and power received with respect to other nodes
 		double *max_received_power_in_ap_per_wlan;	///> Maximum power received from each WLAN
 
 		double *rssi_per_sta;	///> RSSI per STA in the WLAN
@@ -260,6 +270,8 @@ component Node : public TypeII{
 		double time_in_nav;				///> Variable to store the time spent in NAV state
 		int times_went_to_nav;			///> Variable to store the number of times the node passes to NAV state
 
+		double time_statistics_cleared;	///> Time at which the statistics were cleared (start of the observation)
+
 		// Statistics of each STA
 		double *throughput_per_sta;			///> Stores the throughput assigned to each STA (Downlink mode)
 		int *data_packets_sent_per_sta;		///> Stores the data packets sent to each STA (Downlink mode)
@@ -287,9 +299,18 @@ component Node : public TypeII{
 
 		// Komondor environment
 		double *channel_power;				///> Channel power detected in each sub-channel [pW] (Pico watts for resolution issues)
+		double *channel_power_compensation;	///> Rounding errors of the updates of channel_power (compensated summation) [pW]
+		int num_channel_power_updates;		///> Updates of channel_power since it was last recomputed from the transmissions sensed
 		int *channels_free;					///> Channels that are found free for the beginning TX (i.e. power sensed < pd)
 		int *channels_for_tx;				///> Channels that are used in the beginning TX (depend on the channel bonding model)
 
+		// Random streams (keyed by seed, node id and purpose)
+		RandomStream rng_backoff;			///> Backoff slots
+		RandomStream rng_packet_loss;		///> Packet error rate draws
+		RandomStream rng_channel_bonding;	///> Probabilistic channel bonding
+		RandomStream rng_destination;		///> Destination STA of each transmission
+		RandomStream rng_start;				///> Random offset of the first backoff
+
 		// File for writting node logs
 		FILE *output_log_file;				///> File for logs in which the node is involved
 		char own_file_path[32];				///> Name of the file for node logs
@@ -322,7 +343,7 @@ component Node : public TypeII{
 		Notification data_notification;			///> DATA notification to be filled before sending it
 		Notification ack_notification;			///> ACK to be filled before sending it
 		Notification incoming_notification; 	///> Notification of interest being received
-		Notification new_packet;				///> Auxiliar notification object for new packets
+		Packet new_packet;						///> Auxiliar descriptor for new packets
 		Notification null_notification;			///> Auxiliar notification object for null packets
 		Notification nav_notification;			///> Last notification that made the node change state or remain in NAV. It is used for detecting simultaneous events.
 		Notification outrange_nav_notification; ///> NAV notification sent in a different primary channel. Store it for detecting BO collisions when using CB.
@@ -349,9 +370,8 @@ component Node : public TypeII{
 		LogicalNack logical_nack;					///> NACK to be filled in case node is the destination of tx loss
 		double max_pw_interference;					///> Maximum interference detected in range of interest [pW]
 		int channel_max_interference;				///> Channel of maximum interference detected in range of interest [pW]
-		int *nodes_transmitting;					///> IDs of the nodes which are transmitting to any destination
-		std::map<int, double>
-			power_received_per_node;				///> Map containing the power received from each other node
+		ActiveTransmitters
+			power_received_per_node;				///> Set of active nodes sensed and the power received from each one
 		double power_rx_interest;					///> Power received from a TX destined to the node [pW]
 		int receiving_from_node_id;					///> ID of the node that is transmitting to the node (-1 if node is not receiving)
 		int receiving_packet_id;					///> ID of the notification that is being transmitted to me
@@ -403,8 +423,8 @@ component Node : public TypeII{
 	public:
 
 		// INPORT connections for receiving notifications
-		inport void inline InportSomeNodeStartTX(Notification &notification);
-		inport void inline InportSomeNodeFinishTX(Notification &notification);
+		inport void inline InportSomeNodeStartTX(const Notification &notification);
+		inport void inline InportSomeNodeFinishTX(const Notification &notification);
 		inport void inline InportNackReceived(LogicalNack &logical_nack_info);
 
 		inport void inline InportMCSRequestReceived(Notification &notification);
@@ -538,7 +558,6 @@ void Node :: Start(){
 		if (TRAFFIC_FULL_BUFFER_NO_DIFFERENTIATION) {
 
 			for(int i = 0; i < max_num_packets_aggregated; ++i){
-				new_packet = null_notification;
 				new_packet.timestamp_generated = SimTime();
 				new_packet.packet_id = last_packet_generated_id;
 				buffer.PutPacket(new_packet);
@@ -547,7 +566,7 @@ void Node :: Start(){
 
 			time_to_trigger = SimTime() + DIFS;
 
-			trigger_start_backoff.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_start_backoff.Set(time_to_trigger);
 
 		}
 
@@ -600,11 +619,216 @@ void Node :: Stop(){
 	// LOGS(save_node_logs, node_logger.file, "%.15f;N%d;S%d;%s;%s Node info:\n", SimTime(), node_id, node_state, LOG_C01, LOG_LVL1);
 };
 
+/**
+ * Checkpoint(): save or load the state of the node. The input parameters and the arrays
+ * are set by Setup() and Start(), so only their contents are saved. Fields that are only
+ * read from the input (DCB policy, frame length, aggregation, traffic model) are not
+ * saved, so that a snapshot can be loaded under a modified input or sweep override.
+ * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+ */
+void Node :: Checkpoint(CostSnapshot &snapshot){
+
+	snapshot.Check(node_id, "node id");
+	snapshot.Check(wlan.num_stas, "STAs of the node's WLAN");
+
+	// Configuration changed at runtime (by agents, or by the AP for the SR parameters of its STAs)
+	snapshot.Value(current_primary_channel);
+	snapshot.Value(min_channel_allowed);
+	snapshot.Value(max_channel_allowed);
+	snapshot.Value(num_channels_allowed);
+	snapshot.Value(current_max_bandwidth);
+	snapshot.Value(bss_color);
+	snapshot.Value(srg);
+	snapshot.Value(non_srg_obss_pd);
+	snapshot.Value(srg_obss_pd);
+
+	// Buffer
+	buffer.Checkpoint(snapshot);
+	snapshot.Value(last_packet_generated_id);
+
+	// Received power (the power received from each node is saved by the link budget)
+	if(node_type == NODE_TYPE_AP) {
+		snapshot.Array(max_received_power_in_ap_per_wlan, total_wlans_number);
+		snapshot.Array(rssi_per_sta, wlan.num_stas);
+	}
+
+	// Statistics
+	snapshot.Value(data_packets_sent);
+	snapshot.Value(rts_cts_sent);
+	snapshot.Value(num_packets_generated);
+	snapshot.Value(num_packets_dropped);
+	snapshot.Value(throughput);
+	snapshot.Value(throughput_loss);
+	snapshot.Value(data_packets_acked);
+	snapshot.Value(data_frames_acked);
+	snapshot.Value(data_packets_lost);
+	snapshot.Value(rts_cts_lost);
+	snapshot.Value(num_tx_init_tried);
+	snapshot.Value(num_tx_init_not_possible);
+	snapshot.Value(rts_lost_slotted_bo);
+	snapshot.Value(prob_slotted_bo_collision);
+	snapshot.Value(average_waiting_time);
+	snapshot.Value(bandwidth_used_txing);
+	snapshot.Value(num_delay_measurements);
+	snapshot.Value(sum_delays);
+	snapshot.Value(average_delay);
+	snapshot.Value(average_rho);
+	snapshot.Value(average_utilization);
+	snapshot.Value(generation_drop_ratio);
+	snapshot.Value(expected_backoff);
+	snapshot.Value(num_new_backoff_computations);
+	snapshot.Value(sum_time_channel_idle);
+	snapshot.Value(last_time_channel_is_idle);
+	snapshot.Value(channel_idle);
+	snapshot.Value(last_time_not_in_nav);
+	snapshot.Value(time_in_nav);
+	snapshot.Value(times_went_to_nav);
+	snapshot.Value(time_statistics_cleared);
+	snapshot.Array(total_time_transmitting_per_channel, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(total_time_transmitting_in_num_channels, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(total_time_lost_per_channel, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(total_time_lost_in_num_channels, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(total_time_spectrum_per_channel, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(num_trials_tx_per_num_channels, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(nacks_received, NUM_PACKET_LOST_REASONS);
+	snapshot.Array(throughput_per_sta, wlan.num_stas);
+	snapshot.Array(data_packets_sent_per_sta, wlan.num_stas);
+	snapshot.Array(rts_cts_sent_per_sta, wlan.num_stas);
+	snapshot.Array(data_packets_lost_per_sta, wlan.num_stas);
+	snapshot.Array(rts_cts_lost_per_sta, wlan.num_stas);
+	snapshot.Array(data_packets_acked_per_sta, wlan.num_stas);
+	snapshot.Array(data_frames_acked_per_sta, wlan.num_stas);
+
+	// Configurations and reports
+	configuration.Checkpoint(snapshot);
+	if(snapshot.Loading()) {
+		// Keep the input fields of the current run in the configuration reported to agents
+		configuration.frame_length = frame_length;
+		configuration.max_num_packets_aggregated = max_num_packets_aggregated;
+	}
+	new_configuration.Checkpoint(snapshot);
+	spatial_reuse_configuration.Checkpoint(snapshot);
+	performance_report.Checkpoint(snapshot);
+	snapshot.Array(performance_report.num_trials_tx_per_num_channels, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(performance_report.total_time_transmitting_per_channel, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(performance_report.total_time_transmitting_in_num_channels, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(performance_report.total_time_lost_per_channel, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(performance_report.total_time_lost_in_num_channels, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(performance_report.total_time_spectrum_per_channel, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(performance_report.rssi_list, total_wlans_number);
+	snapshot.Array(performance_report.max_received_power_in_ap_per_wlan, total_wlans_number);
+	snapshot.Array(performance_report.rssi_list_per_sta, wlan.num_stas);
+
+	// Channel sensing
+	snapshot.Array(channel_power, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(channel_power_compensation, NUM_CHANNELS_KOMONDOR);
+	snapshot.Value(num_channel_power_updates);
+	snapshot.Array(channels_free, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(channels_for_tx, NUM_CHANNELS_KOMONDOR);
+	snapshot.Array(timestampt_channel_becomes_free, NUM_CHANNELS_KOMONDOR);
+
+	// Random streams
+	snapshot.Value(rng_backoff);
+	snapshot.Value(rng_packet_loss);
+	snapshot.Value(rng_channel_bonding);
+	snapshot.Value(rng_destination);
+	snapshot.Value(rng_start);
+
+	// State and current transmission
+	snapshot.Value(node_state);
+	snapshot.Value(remaining_backoff);
+	snapshot.Value(progress_bar_counter);
+	snapshot.Value(node_is_transmitter);
+	snapshot.Value(current_left_channel);
+	snapshot.Value(current_right_channel);
+	snapshot.Value(current_tx_power);
+	snapshot.Value(current_pd);
+	snapshot.Value(current_destination_id);
+	snapshot.Value(current_tx_duration);
+	snapshot.Value(current_nav_time);
+	snapshot.Value(packet_id);
+	snapshot.Value(current_sinr);
+	snapshot.Value(loss_reason);
+	snapshot.Value(current_num_packets_aggregated);
+	snapshot.Value(limited_num_packets_aggregated);
+	snapshot.Value(num_channels_tx);
+	snapshot.Value(time_to_trigger);
+	snapshot.Value(flag_apply_new_configuration);
+	snapshot.Value(channel_aggregation_cca_model);
+
+	// Notifications
+	rts_notification.Checkpoint(snapshot);
+	cts_notification.Checkpoint(snapshot);
+	data_notification.Checkpoint(snapshot);
+	ack_notification.Checkpoint(snapshot);
+	incoming_notification.Checkpoint(snapshot);
+	new_packet.Checkpoint(snapshot);
+	null_notification.Checkpoint(snapshot);
+	nav_notification.Checkpoint(snapshot);
+	outrange_nav_notification.Checkpoint(snapshot);
+	current_tx_info.Checkpoint(snapshot);
+
+	// Modulations, CW and packet durations
+	snapshot.Value(current_modulation);
+	snapshot.Value(channel_max_intereference);
+	snapshot.Value(first_time_requesting_mcs);
+	snapshot.Value(default_modulation);
+	snapshot.Value(bits_ofdm_sym);
+	snapshot.Value(cw_current);
+	snapshot.Value(cw_stage_current);
+	snapshot.Value(data_duration);
+	snapshot.Value(ack_duration);
+	snapshot.Value(rts_duration);
+	snapshot.Value(cts_duration);
+	for(int i = 0; i < wlan.num_stas; ++i) snapshot.Array(mcs_per_node[i], NUM_OPTIONS_CHANNEL_LENGTH);
+	snapshot.Array(change_modulation_flag, wlan.num_stas);
+	snapshot.Array(mcs_response, 4);
+
+	// Sensing and reception
+	snapshot.Value(logical_nack);
+	snapshot.Value(max_pw_interference);
+	snapshot.Value(channel_max_interference);
+	snapshot.Value(power_rx_interest);
+	snapshot.Value(receiving_from_node_id);
+	snapshot.Value(receiving_packet_id);
+	snapshot.Value(BER);
+	snapshot.Value(PER);
+	power_received_per_node.Checkpoint(snapshot);
+
+	// Rho, bursts and waiting time
+	snapshot.Value(flag_measure_rho);
+	snapshot.Value(delta_measure_rho);
+	snapshot.Value(num_measures_rho);
+	snapshot.Value(num_measures_rho_accomplished);
+	snapshot.Value(num_measures_utilization);
+	snapshot.Value(num_measures_buffer_with_packets);
+	snapshot.Value(num_bursts);
+	snapshot.Value(sum_waiting_time);
+	snapshot.Value(timestamp_new_trial_started);
+	snapshot.Value(num_average_waiting_time_measurements);
+	snapshot.Value(time_rand_value);
+
+	// Spatial Reuse
+	snapshot.Value(spatial_reuse_enabled);
+	snapshot.Value(type_last_sensed_packet);
+	snapshot.Value(pd_spatial_reuse);
+	snapshot.Value(tx_power_sr);
+	snapshot.Value(txop_sr_identified);
+	snapshot.Value(next_pd_spatial_reuse);
+	snapshot.Value(flag_change_in_tx_power);
+	snapshot.Value(potential_obss_pd_threshold);
+	snapshot.Value(current_obss_pd_threshold);
+	snapshot.Value(next_tx_power_limit);
+	snapshot.Value(current_tx_power_sr);
+	snapshot.Array(type_ongoing_transmissions_sr, 3);
+
+};
+
 /**
  * Called when some node (this one included) starts a transmission
  * @param "notification" [type Notification]: notification containing the information of the transmission start perceived
  */
-void Node :: InportSomeNodeStartTX(Notification &notification){
+void Node :: InportSomeNodeStartTX(const Notification &notification){
 
 	LOGS(save_node_logs, node_logger.file,
 			"%.15f;N%d;S%d;%s;%s InportSomeNodeStartTX(): N%d to N%d sends packet type %d in range %d-%d at power %.2f dBm\n",
@@ -617,10 +841,8 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 	        "%.15f;N%d;S%d;%s;%s Nodes transmitting: ",
 			SimTime(), node_id, node_state, LOG_D00, LOG_LVL3);
 
-	// Identify node that has started the transmission as transmitting node in the array
-	nodes_transmitting[notification.source_id] = TRUE;
-	if(save_node_logs) PrintOrWriteNodesTransmitting(WRITE_LOG, save_node_logs,
-		print_node_logs, node_logger, total_nodes_number, nodes_transmitting);
+	// The medium has already counted the transmission as sensed by this node
+	if(save_node_logs) WriteNodesTransmitting();
 
 	if(notification.source_id == node_id){ // If OWN NODE IS THE TRANSMITTER, do nothing
 
@@ -646,45 +868,8 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 		PrintOrWriteChannelPower(WRITE_LOG, save_node_logs, node_logger, print_node_logs,
 					&channel_power);
 
-        // Update 'power received' array in case a new tx power is used
-//        if(node_id == 0) printf("notification.tx_info.flag_change_in_tx_power = %d\n", notification.tx_info.flag_change_in_tx_power);
-        if (notification.tx_info.flag_change_in_tx_power) {
-            received_power_array[notification.source_id] =
-                ComputePowerReceived(distances_array[notification.source_id],
-                notification.tx_info.tx_power, central_frequency, path_loss_model);
-        }
-
-		// Update 'power received' array in case a new tx power is used
-//		if (notification.tx_info.flag_change_in_tx_power) {
-//			received_power_array[notification.source_id] =
-//				ComputePowerReceived(distances_array[notification.source_id],
-//				notification.tx_info.tx_power, notification.tx_info.tx_gain, rx_gain,
-//				central_frequency, path_loss_model);
-//		}
-
-		if (notification.tx_info.flag_change_in_tx_power) {
-			received_power_array[notification.source_id] =
-				ComputePowerReceived(distances_array[notification.source_id],
-				notification.tx_info.tx_power, central_frequency, path_loss_model);
-		}
-
-		// Update the power sensed at each channel
-		UpdateChannelsPower(&channel_power, notification, TX_INITIATED,
-			central_frequency, path_loss_model, adjacent_channel_model, received_power_array[notification.source_id], node_id);
-
-		LOGS(save_node_logs,node_logger.file,
-			"%.15f;N%d;S%d;%s;%s Power sensed per channel [dBm]: ",
-			SimTime(), node_id, node_state, LOG_E18, LOG_LVL3);
-
-		PrintOrWriteChannelPower(WRITE_LOG, save_node_logs, node_logger, print_node_logs,
-			&channel_power);
-
-		// Call UpdatePowerSensedPerNode() ONLY for adding power (some node started)
-		UpdatePowerSensedPerNode(current_primary_channel, power_received_per_node, notification,
-			central_frequency, path_loss_model, received_power_array[notification.source_id], TX_INITIATED);
-
-		UpdateTimestamptChannelFreeAgain(timestampt_channel_becomes_free, &channel_power,
-			current_pd, SimTime());
+		// Update the power sensed from the new transmission
+		SenseTransmissionStart(notification);
 
 //		if(save_node_logs) {
 //			LOGS(save_node_logs,node_logger.file, "%.15f;N%d;S%d;%s;%s timestampt_channel_becomes_frees: ",
@@ -714,7 +899,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 			type_last_sensed_packet = CheckPacketOrigin(notification, bss_color, srg);
 			// Obtain the CST to be used
 			potential_obss_pd_threshold = GetSensitivitySpatialReuse(type_last_sensed_packet,
-				srg_obss_pd, non_srg_obss_pd, current_pd, power_received_per_node[notification.source_id]);
+				srg_obss_pd, non_srg_obss_pd, current_pd, power_received_per_node.Power(notification.source_id));
 			// In case of detecting an inter-BSS frame, print the information
 			if (type_last_sensed_packet != INTRA_BSS_FRAME) {
 				LOGS(save_node_logs, node_logger.file, "%.15f;N%d;S%d;%s;%s SPATIAL REUSE OPERATION: \n",
@@ -747,7 +932,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 				if(notification.destination_id == node_id){	// Node IS THE DESTINATION
 
 					// Update power received of interest
-					power_rx_interest = power_received_per_node[notification.source_id];
+					power_rx_interest = power_received_per_node.Power(notification.source_id);
 
 					current_left_channel = notification.left_channel;
 					current_right_channel = notification.right_channel;
@@ -769,7 +954,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 
 						// max_pw_interference is interference in primary
 						max_pw_interference = channel_power[current_primary_channel]
-							- power_received_per_node[notification.source_id];
+							- power_received_per_node.Power(notification.source_id);
 
 					} else {
 
@@ -798,7 +983,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 						// Check if notification has been lost due to interferences or weak signal strength
 						loss_reason = IsPacketLost(current_primary_channel, notification, notification,
 								current_sinr, capture_effect, current_pd,
-								power_rx_interest, constant_per, node_id, capture_effect_model);
+								power_rx_interest, constant_per, node_id, capture_effect_model, rng_packet_loss);
 
 						if(loss_reason != PACKET_NOT_LOST) {	// If RTS IS LOST, send logical Nack
 
@@ -883,7 +1068,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 
 						/** Can the packet be decoded? **/
 						// 1 - Compute the power of interest (RSSI)
-						power_rx_interest = power_received_per_node[notification.source_id];
+						power_rx_interest = power_received_per_node.Power(notification.source_id);
 						// 2 - Compute max interference (the highest one perceived in the reception channel range)
 						ComputeMaxInterference(&max_pw_interference, &channel_max_intereference,
 							notification, node_state, power_received_per_node, &channel_power);
@@ -891,7 +1076,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 						current_sinr = UpdateSINR(power_rx_interest, max_pw_interference);
 						// 4 - Check if the packet is lost or not
 						loss_reason = IsPacketLost(current_primary_channel, notification, notification, current_sinr,
-							capture_effect, current_pd, power_rx_interest, constant_per, node_id, capture_effect_model);
+							capture_effect, current_pd, power_rx_interest, constant_per, node_id, capture_effect_model, rng_packet_loss);
 
 						LOGS(save_node_logs,node_logger.file,
 							"%.15f;N%d;S%d;%s;%s Pmax_intf[%d] = %f dBm - P_st = %f dBm - P_if = %f dBm, sinr = %f dB\n",
@@ -931,7 +1116,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 								next_tx_power_limit = ApplyTxPowerRestriction(current_obss_pd_threshold, current_tx_power);
 								// Start (update) the trigger that indicates the end of the SR-based opportunity
 								time_to_trigger = SimTime() + notification.tx_info.nav_time;
-								txop_sr_end.Set(FixTimeOffset(time_to_trigger,13,12));
+								txop_sr_end.Set(time_to_trigger);
 								LOGS(save_node_logs, node_logger.file,
 									"%.15f;N%d;S%d;%s;%s An SR TXOP was detected for OBSS_PD = %f dBm "
 									"(received RTS/CTS while being in SENSING state.)\n",
@@ -968,9 +1153,9 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 							// SERGIO_TRIGGER
 							// Differentiate between Intra-BSS and Inter-BSS NAV triggers
 							if (spatial_reuse_enabled && type_last_sensed_packet != INTRA_BSS_FRAME) {
-								trigger_inter_bss_NAV_timeout.Set(FixTimeOffset(time_to_trigger,13,12));
+								trigger_inter_bss_NAV_timeout.Set(time_to_trigger);
 							} else {
-								trigger_NAV_timeout.Set(FixTimeOffset(time_to_trigger,13,12));
+								trigger_NAV_timeout.Set(time_to_trigger);
 							}
 
 							LOGS(save_node_logs,node_logger.file,
@@ -1089,7 +1274,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 								notification.source_id);
 
 							// Update power received of interest
-							power_rx_interest = power_received_per_node[notification.source_id];
+							power_rx_interest = power_received_per_node.Power(notification.source_id);
 
 							// Compute max interference (the highest one perceived in the reception channel range)
 							ComputeMaxInterference(&max_pw_interference, &channel_max_intereference,
@@ -1108,7 +1293,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 							// TODO: method for checking whether the detected transmission can be decoded or not
 							loss_reason = IsPacketLost(current_primary_channel, notification, notification,
 								current_sinr, capture_effect, current_pd,
-								power_rx_interest, constant_per, node_id, capture_effect_model);
+								power_rx_interest, constant_per, node_id, capture_effect_model, rng_packet_loss);
 
 							if(loss_reason != PACKET_NOT_LOST) {	// If RTS IS LOST, send logical Nack
 
@@ -1129,8 +1314,8 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 									trigger_NAV_timeout.Cancel();
 									time_to_trigger = SimTime() + MAX_DIFFERENCE_SAME_TIME;
 
-									// trigger_NAV_timeout.Set(FixTimeOffset(time_to_trigger,13,12));
-									trigger_restart_sta.Set(FixTimeOffset(time_to_trigger,13,12));
+									// trigger_NAV_timeout.Set(time_to_trigger);
+									trigger_restart_sta.Set(time_to_trigger);
 
 								} else {
 
@@ -1218,7 +1403,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 						// TODO: determine if can be decoded!
 
 						// Update power received of interest
-						power_rx_interest = power_received_per_node[notification.source_id];
+						power_rx_interest = power_received_per_node.Power(notification.source_id);
 						// Compute max interference (the highest one perceived in the reception channel range)
 						ComputeMaxInterference(&max_pw_interference, &channel_max_intereference,
 							notification, node_state, power_received_per_node, &channel_power);
@@ -1234,7 +1419,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 						// TODO: method for checking whether the detected transmission can be decoded or not
 						int loss_reason (IsPacketLost(current_primary_channel, notification, notification,
 							current_sinr, capture_effect, current_pd, power_rx_interest, constant_per,
-							node_id, capture_effect_model));
+							node_id, capture_effect_model, rng_packet_loss));
 
 						// NAV collision detected
 						if((nav_collision || inter_bss_nav_collision) && loss_reason == PACKET_NOT_LOST)  {
@@ -1249,13 +1434,13 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 								time_to_trigger = SimTime() + MAX_DIFFERENCE_SAME_TIME;
 								if (spatial_reuse_enabled && inter_bss_nav_collision) {
 									trigger_inter_bss_NAV_timeout.Cancel(); // Cancel inter-BSS NAV
-									trigger_inter_bss_NAV_timeout.Set(FixTimeOffset(time_to_trigger,13,12));
+									trigger_inter_bss_NAV_timeout.Set(time_to_trigger);
 									LOGS(save_node_logs, node_logger.file,
 										"%.15f;N%d;S%d;%s;%s (workaround) setting inter-BSS NAV trigger to %.12f\n",
 										SimTime(), node_id, node_state, LOG_D07, LOG_LVL3, time_to_trigger);
 								} else {
 									trigger_NAV_timeout.Cancel();			// Cancel intra-BSS NAV (legacy)
-									trigger_NAV_timeout.Set(FixTimeOffset(time_to_trigger,13,12));
+									trigger_NAV_timeout.Set(time_to_trigger);
 									LOGS(save_node_logs, node_logger.file,
 										"%.15f;N%d;S%d;%s;%s (workaround) setting NAV trigger to %.12f\n",
 										SimTime(), node_id, node_state, LOG_D07, LOG_LVL3, time_to_trigger);
@@ -1286,7 +1471,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 										+ SIFS + notification.tx_info.cts_duration
 										- notification.tx_info.preoccupancy_duration;
 
-									trigger_wait_collisions.Set(FixTimeOffset(time_to_trigger,13,12));
+									trigger_wait_collisions.Set(time_to_trigger);
 
 									LOGS(save_node_logs, node_logger.file,
 										"%.15f;N%d;S%d;%s;%s Recovering from EIFS at %.12f (preoc. = %.12f)\n",
@@ -1308,7 +1493,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 
 							// Check if it can be decoded to update NAV time if required
 							// Can RTS or CTS packet be decoded?
-							power_rx_interest = power_received_per_node[notification.source_id];
+							power_rx_interest = power_received_per_node.Power(notification.source_id);
 
 							// Compute max interference (the highest one perceived in the reception channel range)
 							ComputeMaxInterference(&max_pw_interference, &channel_max_intereference,
@@ -1327,9 +1512,9 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 							// TODO: method for checking whether the detected transmission can be decoded or not
 							loss_reason = IsPacketLost(current_primary_channel, notification, notification,
 								current_sinr, capture_effect, current_pd, power_rx_interest, constant_per,
-								node_id, capture_effect_model);
+								node_id, capture_effect_model, rng_packet_loss);
 
-							int power_condition (ConvertPower(PW_TO_DBM, channel_power[current_primary_channel]) > sensitivity_default);
+							int power_condition (PwToDbm(channel_power[current_primary_channel]) > sensitivity_default);
 
 							if (loss_reason == PACKET_NOT_LOST && power_condition) {	// Packet IS NOT LOST
 
@@ -1341,12 +1526,12 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 								int loss_reason_sr (1);
 								int power_condition_sr (1);
 								if (spatial_reuse_enabled && type_last_sensed_packet != INTRA_BSS_FRAME && node_is_transmitter) { 	// Check for TXOP
-									double power_interference (power_received_per_node[notification.source_id]);
+									double power_interference (power_received_per_node.Power(notification.source_id));
 									// TODO: method for checking whether the detected transmission can be decoded or not
 									loss_reason_sr = IsPacketLost(current_primary_channel, notification, notification,
 										current_sinr, capture_effect, potential_obss_pd_threshold, power_interference, constant_per,
-										node_id, capture_effect_model);
-									power_condition_sr = ConvertPower(PW_TO_DBM, channel_power[current_primary_channel]) > potential_obss_pd_threshold;
+										node_id, capture_effect_model, rng_packet_loss);
+									power_condition_sr = PwToDbm(channel_power[current_primary_channel]) > potential_obss_pd_threshold;
 								}
 								if (loss_reason_sr != PACKET_NOT_LOST && power_condition_sr) {
 									txop_sr_identified = TRUE;	// TXOP identified!
@@ -1361,7 +1546,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 										nav_notification = notification;
 										if(trigger_inter_bss_NAV_timeout.GetTime() < notification.tx_info.nav_time) {
 											time_to_trigger = SimTime() +  notification.tx_info.nav_time + TIME_OUT_EXTRA_TIME;
-											trigger_inter_bss_NAV_timeout.Set(FixTimeOffset(time_to_trigger,13,12));
+											trigger_inter_bss_NAV_timeout.Set(time_to_trigger);
 											LOGS(save_node_logs, node_logger.file,
 												"%.15f;N%d;S%d;%s;%s Updating inter-BSS NAV timeout to the more restrictive one: From %.12f to %.12f\n",
 												SimTime(), node_id, node_state, LOG_D07, LOG_LVL4,
@@ -1371,7 +1556,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 										nav_notification = notification;
 										if(trigger_NAV_timeout.GetTime() < notification.tx_info.nav_time) {
 											time_to_trigger = SimTime() +  notification.tx_info.nav_time + TIME_OUT_EXTRA_TIME;
-											trigger_NAV_timeout.Set(FixTimeOffset(time_to_trigger,13,12));
+											trigger_NAV_timeout.Set(time_to_trigger);
 											LOGS(save_node_logs, node_logger.file,
 												"%.15f;N%d;S%d;%s;%s Updating NAV timeout to the more restrictive one: From %.12f to %.12f\n",
 												SimTime(), node_id, node_state, LOG_D07, LOG_LVL4,
@@ -1458,19 +1643,19 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 					// Check if new TXOP are detected when transmitting (in order to transmit again when restarting)
 					if (spatial_reuse_enabled && type_last_sensed_packet != INTRA_BSS_FRAME && node_is_transmitter) {
 
-						double power_interference (power_received_per_node[notification.source_id]);
+						double power_interference (power_received_per_node.Power(notification.source_id));
 						double sinr_interference (UpdateSINR(power_interference, max_pw_interference));
 
 						// Is packet lost with the default pd?
 						// TODO: method for checking whether the detected transmission can be decoded or not
 						int loss_reason_legacy (IsPacketLost(current_primary_channel, notification, notification,
 							sinr_interference, capture_effect, sensitivity_default, power_interference, constant_per,
-							node_id, capture_effect_model));
+							node_id, capture_effect_model, rng_packet_loss));
 						// Is packet lost with the SR pd?
 						// TODO: method for checking whether the detected transmission can be decoded or not
 						int loss_reason_sr (IsPacketLost(current_primary_channel, notification, notification,
 							sinr_interference, capture_effect, potential_obss_pd_threshold, power_interference, constant_per,
-							node_id, capture_effect_model));
+							node_id, capture_effect_model, rng_packet_loss));
 
 						if(save_node_logs && node_id == 0) LOGS(save_node_logs, node_logger.file,
 							"%.15f;N%d;S%d;%s;%s sinr_interference = %f - capture_effect = %f - pd_spatial_reuse = %f"
@@ -1492,7 +1677,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 							next_tx_power_limit = ApplyTxPowerRestriction(current_obss_pd_threshold, current_tx_power);
 							// Start (update) the trigger that indicates the end of the SR-based opportunity
 							time_to_trigger = SimTime() + notification.tx_info.nav_time;
-							txop_sr_end.Set(FixTimeOffset(time_to_trigger,13,12));
+							txop_sr_end.Set(time_to_trigger);
 							LOGS(save_node_logs, node_logger.file,
 								"%.15f;N%d;S%d;%s;%s TXOP detected while being in TX state\n",
 								SimTime(), node_id, node_state, LOG_D08, LOG_LVL3);
@@ -1533,7 +1718,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 					// Check if ongoing notification has been lost due to interferences caused by new transmission
 					loss_reason = IsPacketLost(current_primary_channel, incoming_notification, notification,
 						current_sinr, capture_effect, current_pd,
-						power_rx_interest, constant_per, node_id, capture_effect_model);
+						power_rx_interest, constant_per, node_id, capture_effect_model, rng_packet_loss);
 
 					// TODO: method for checking whether the detected transmission can be decoded or not
 					// ...
@@ -1554,7 +1739,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 										loss_reason = PACKET_LOST_BO_COLLISION;
 										if(!node_is_transmitter) {
 											time_to_trigger = SimTime() + MAX_DIFFERENCE_SAME_TIME;
-											trigger_NAV_timeout.Set(FixTimeOffset(time_to_trigger,13,12));
+											trigger_NAV_timeout.Set(time_to_trigger);
 										} else {
 											printf("ALARM! Should not happen in downlink traffic\n");
 										}
@@ -1585,8 +1770,8 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 						}
 
 						case CE_IEEE_802_11:{
-							int capture_effect_condition (power_received_per_node[notification.source_id] >
-								power_received_per_node[receiving_from_node_id] + capture_effect);
+							int capture_effect_condition (power_received_per_node.Power(notification.source_id) >
+								power_received_per_node.Power(receiving_from_node_id) + capture_effect);
 
 							if (loss_reason == PACKET_NOT_LOST && capture_effect_condition) {
 								if (notification.packet_type == PACKET_TYPE_RTS) {
@@ -1621,7 +1806,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 										loss_reason = PACKET_LOST_BO_COLLISION;
 										if(!node_is_transmitter) {
 											time_to_trigger = SimTime() + MAX_DIFFERENCE_SAME_TIME;
-											trigger_NAV_timeout.Set(FixTimeOffset(time_to_trigger,13,12));
+											trigger_NAV_timeout.Set(time_to_trigger);
 										} else {
 											printf("ALARM! Should not happen in downlink traffic\n");
 										}
@@ -1673,11 +1858,11 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 					if (spatial_reuse_enabled && txop_sr_identified) {
 						loss_reason = IsPacketLost(current_primary_channel, incoming_notification, notification,
 							current_sinr, capture_effect, current_obss_pd_threshold,
-							power_rx_interest, constant_per, node_id, capture_effect_model);
+							power_rx_interest, constant_per, node_id, capture_effect_model, rng_packet_loss);
 					} else {
 						loss_reason = IsPacketLost(current_primary_channel, incoming_notification, notification,
 							current_sinr, capture_effect, current_pd,
-							power_rx_interest, constant_per, node_id, capture_effect_model);
+							power_rx_interest, constant_per, node_id, capture_effect_model, rng_packet_loss);
 					}
 
 					// TODO: method for checking whether the detected transmission can be decoded or not
@@ -1714,13 +1899,13 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 							}
 
 							case CE_IEEE_802_11:{
-								int capture_effect_condition = power_received_per_node[notification.source_id] >
-									power_received_per_node[receiving_from_node_id] + capture_effect;
+								int capture_effect_condition = power_received_per_node.Power(notification.source_id) >
+									power_received_per_node.Power(receiving_from_node_id) + capture_effect;
 								if (capture_effect_condition) {
 									loss_reason = PACKET_LOST_CAPTURE_EFFECT;
 									printf("Node %d was in state RX (from %d), and a new notification arrived from %d:\n", node_id, receiving_from_node_id, notification.source_id);
-									printf("	* New RSSI: %f\n", power_received_per_node[notification.source_id]);
-									printf("	* Old RSSI: %f:\n", power_received_per_node[receiving_from_node_id]);
+									printf("	* New RSSI: %f\n", power_received_per_node.Power(notification.source_id));
+									printf("	* Old RSSI: %f:\n", power_received_per_node.Power(receiving_from_node_id));
 									printf("	* CE: %f:\n", capture_effect);
 									printf("	* loss_reason: %d:\n", loss_reason);
 									if(nack_activated){
@@ -1743,7 +1928,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 //				// Check if new TXOP are detected when transmitting (in order to transmit again when restarting)
 //				if (spatial_reuse_enabled && type_last_sensed_packet != INTRA_BSS_FRAME && node_is_transmitter) {
 //
-//					double power_interference (power_received_per_node[notification.source_id]);
+//					double power_interference (power_received_per_node.Power(notification.source_id));
 //					double sinr_interference (UpdateSINR(power_interference, max_pw_interference));
 //
 //					// Is packet lost with the default pd?
@@ -1785,7 +1970,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 
 				if(notification.destination_id == node_id){	// Node is the destination
 
-					power_rx_interest = power_received_per_node[notification.source_id];
+					power_rx_interest = power_received_per_node.Power(notification.source_id);
 
 					incoming_notification = notification;
 
@@ -1805,7 +1990,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 						// TODO: method for checking whether the detected transmission can be decoded or not
 						loss_reason = IsPacketLost(current_primary_channel, incoming_notification, notification,
 								current_sinr, capture_effect, current_pd,
-								power_rx_interest, constant_per, node_id, capture_effect_model);
+								power_rx_interest, constant_per, node_id, capture_effect_model, rng_packet_loss);
 
 						if(loss_reason != PACKET_NOT_LOST
 								&& loss_reason != PACKET_LOST_OUTSIDE_CH_RANGE) {	// If ACK packet IS LOST, send logical Nack
@@ -1910,7 +2095,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 
 					if(notification.packet_type == PACKET_TYPE_CTS){	// CTS packet transmission started
 
-						power_rx_interest = power_received_per_node[notification.source_id];
+						power_rx_interest = power_received_per_node.Power(notification.source_id);
 
 						// Compute max interference (the highest one perceived in the reception channel range)
 						ComputeMaxInterference(&max_pw_interference, &channel_max_intereference,
@@ -1930,7 +2115,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 						// TODO: method for checking whether the detected transmission can be decoded or not
 						loss_reason = IsPacketLost(current_primary_channel, incoming_notification, notification,
 							current_sinr, capture_effect, current_pd,
-							power_rx_interest, constant_per, node_id, capture_effect_model);
+							power_rx_interest, constant_per, node_id, capture_effect_model, rng_packet_loss);
 
 						if(loss_reason != PACKET_NOT_LOST
 								&& loss_reason != PACKET_LOST_OUTSIDE_CH_RANGE)  {	// If CTS packet IS LOST, send logical Nack
@@ -2036,7 +2221,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 
 				if(notification.destination_id == node_id){	// Node is the destination
 
-					power_rx_interest = power_received_per_node[notification.source_id];
+					power_rx_interest = power_received_per_node.Power(notification.source_id);
 					incoming_notification = notification;
 
 //					LOGS(save_node_logs, node_logger.file,
@@ -2063,7 +2248,7 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 						// TODO: method for checking whether the detected transmission can be decoded or not
 						loss_reason = IsPacketLost(current_primary_channel, incoming_notification, notification,
 							current_sinr, capture_effect, current_pd,
-							power_rx_interest, constant_per, node_id, capture_effect_model);
+							power_rx_interest, constant_per, node_id, capture_effect_model, rng_packet_loss);
 
 						if(loss_reason != PACKET_NOT_LOST
 							&& loss_reason != PACKET_LOST_OUTSIDE_CH_RANGE)  {	// If DATA packet IS LOST, send logical Nack
@@ -2168,11 +2353,71 @@ void Node :: InportSomeNodeStartTX(Notification &notification){
 	// LOGS(save_node_logs, node_logger.file, "%.15f;N%d;S%d;%s;%s InportSomeNodeStartTX() END\n", SimTime(), node_id, node_state, LOG_D01, LOG_LVL1);
 };
 
+/**
+ * Update the power received from a node that has changed its transmission power (the path loss of the
+ * link is fixed, so the power received is scaled)
+ * @param "notification" [type Notification]: notification carrying the new transmission power
+ */
+void Node :: RefreshPowerReceived(const Notification &notification){
+	links.SetTxPower(notification.source_id, notification.tx_info.tx_power);
+}
+
+/**
+ * Update the power sensed per channel (and per node) with a transmission of another node that has started
+ * @param "notification" [type Notification]: notification containing the information of the transmission
+ */
+void Node :: SenseTransmissionStart(const Notification &notification){
+
+	// Update 'power received' array in case a new tx power is used
+//        if(node_id == 0) printf("notification.tx_info.flag_change_in_tx_power = %d\n", notification.tx_info.flag_change_in_tx_power);
+	if (notification.tx_info.flag_change_in_tx_power) RefreshPowerReceived(notification);
+
+	// Update the power sensed at each channel
+	double power_received (links.ReceivedPower(notification.source_id));
+	UpdateChannelsPower(&channel_power, channel_power_compensation, notification, TX_INITIATED,
+		central_frequency, path_loss_model, adjacent_channel_model, power_received, node_id);
+	++num_channel_power_updates;
+
+	LOGS(save_node_logs,node_logger.file,
+		"%.15f;N%d;S%d;%s;%s Power sensed per channel [dBm]: ",
+		SimTime(), node_id, node_state, LOG_E18, LOG_LVL3);
+
+	PrintOrWriteChannelPower(WRITE_LOG, save_node_logs, node_logger, print_node_logs,
+		&channel_power);
+
+	// Call UpdatePowerSensedPerNode() ONLY for adding power (some node started)
+	UpdatePowerSensedPerNode(current_primary_channel, power_received_per_node, notification,
+		central_frequency, path_loss_model, power_received, TX_INITIATED);
+
+	UpdateTimestamptChannelFreeAgain(timestampt_channel_becomes_free, &channel_power,
+		current_pd, SimTime());
+}
+
+/**
+ * Recompute the power sensed at each channel from the transmissions currently sensed (kept by the medium),
+ * dropping the rounding errors left by the updates of the transmissions that have finished
+ */
+void Node :: RecomputeChannelPower(){
+	for(int i = 0; i < NUM_CHANNELS_KOMONDOR; ++i){
+		channel_power[i] = 0;
+		channel_power_compensation[i] = 0;
+	}
+	const std::vector<int> &senders (medium->senders_per_node[node_id]);
+	for(size_t i = 0; i < senders.size(); ++i){
+		if(senders[i] != node_id) {
+			UpdateChannelsPower(&channel_power, channel_power_compensation, medium->ongoing_notification[senders[i]],
+				TX_INITIATED, central_frequency, path_loss_model, adjacent_channel_model,
+				links.ReceivedPower(senders[i]), node_id);
+		}
+	}
+	num_channel_power_updates = 0;
+}
+
 /**
  * Called when some node (this one included) finishes a packet TX (RTS, CTS, Data, or ACK)
  * @param "notification" [type Notification]: notification containing the information of the transmission that has finished
  */
-void Node :: InportSomeNodeFinishTX(Notification &notification){
+void Node :: InportSomeNodeFinishTX(const Notification &notification){
 
 	LOGS(save_node_logs,node_logger.file, "%.15f;N%d;S%d;%s;%s InportSomeNodeFinishTX(): N%d to N%d (type %d)"
 			" at range %d-%d "
@@ -2181,10 +2426,8 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 		notification.source_id, notification.destination_id, notification.packet_type,
 		notification.left_channel, notification.right_channel);
 
-	// Identify node that has finished the transmission as non-transmitting node in the array
-	nodes_transmitting[notification.source_id] = FALSE;
-	if(save_node_logs) PrintOrWriteNodesTransmitting(WRITE_LOG, save_node_logs,
-			print_node_logs, node_logger, total_nodes_number, nodes_transmitting);
+	// The medium has already discounted the transmission from the ones sensed by this node
+	if(save_node_logs) WriteNodesTransmitting();
 
 	if(notification.source_id == node_id){	// Node is the TX source: do nothing
 
@@ -2210,21 +2453,22 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 					&channel_power);
 
 		// Update the power sensed at each channel
-		UpdateChannelsPower(&channel_power, notification, TX_FINISHED,
-			central_frequency, path_loss_model, adjacent_channel_model, received_power_array[notification.source_id], node_id);
+		double power_received (links.ReceivedPower(notification.source_id));
+		UpdateChannelsPower(&channel_power, channel_power_compensation, notification, TX_FINISHED,
+			central_frequency, path_loss_model, adjacent_channel_model, power_received, node_id);
+		++num_channel_power_updates;
 
 		// -------------------------
-		// Safety condtion. Empty the channel when no node is transmitting
-		int num_nodes_transmitting = 0;
-		for(int i = 0; i < total_nodes_number; ++i){
-			if(nodes_transmitting[i] == TRUE){
-				++num_nodes_transmitting;
-			}
-		}
-		if(num_nodes_transmitting == 0){
+		// Safety condtion. Empty the channel when no node is transmitting (exactly, with no rounding error left)
+		if(medium->NumTransmissionsSensed(node_id) == 0){
 			for(int i = 0; i < NUM_CHANNELS_KOMONDOR; ++i){
 				channel_power[i] = 0;
+				channel_power_compensation[i] = 0;
 			}
+			num_channel_power_updates = 0;
+		} else if(num_channel_power_updates >= CHANNEL_POWER_RECOMPUTE_UPDATES) {
+			// Under constant load the channel never empties: bound the rounding errors left by the updates
+			RecomputeChannelPower();
 		}
 		// End of safety condition
 		// -------------------------
@@ -2248,7 +2492,7 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 
 		// Call UpdatePowerSensedPerNode() ONLY for adding power (some node started)
 		UpdatePowerSensedPerNode(current_primary_channel, power_received_per_node, notification,
-			central_frequency, path_loss_model, received_power_array[notification.source_id], TX_FINISHED);
+			central_frequency, path_loss_model, power_received, TX_FINISHED);
 
 		UpdateTimestamptChannelFreeAgain(timestampt_channel_becomes_free, &channel_power,
 			current_pd, SimTime());
@@ -2297,7 +2541,7 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 							// - If not, just resume the backoff
 							time_to_trigger = SimTime() + DIFS;
 							// time_to_trigger = SimTime() + SIFS + notification.tx_info.cts_duration + DIFS;
-							trigger_start_backoff.Set(FixTimeOffset(time_to_trigger,13,12));
+							trigger_start_backoff.Set(time_to_trigger);
 							LOGS(save_node_logs,node_logger.file, "%.15f;N%d;S%d;%s;%s BO will be resumed after DIFS at %.12f.\n",
 								SimTime(), node_id, node_state, LOG_E11, LOG_LVL4,
 								trigger_start_backoff.GetTime());
@@ -2337,7 +2581,7 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 
 						// Compute the NAV time
 						current_nav_time = ComputeNavTime(node_state, rts_duration, cts_duration, data_duration, ack_duration, SIFS);
-						current_nav_time = FixTimeOffset(current_nav_time,13,12); // Update the NAV time according to the time offsets
+						current_nav_time = RoundToSimTime(current_nav_time); // Update the NAV time according to the time offsets
 
 						current_tx_duration = ack_duration;
 						current_destination_id = notification.source_id;
@@ -2371,7 +2615,7 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 
 						// triggers the SendResponsePacket() function after SIFS
 						time_to_trigger = SimTime() + SIFS;
-						trigger_SIFS.Set(FixTimeOffset(time_to_trigger,13,12));
+						trigger_SIFS.Set(time_to_trigger);
 
 						LOGS(save_node_logs,node_logger.file,
 							"%.15f;N%d;S%d;%s;%s SIFS will be triggered in %.12f\n",
@@ -2454,7 +2698,6 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 						if(traffic_model == TRAFFIC_FULL_BUFFER_NO_DIFFERENTIATION) {
 
 							for(int i = 0; i < max_num_packets_aggregated; ++i){
-								new_packet = null_notification;
 								new_packet.timestamp_generated = SimTime();
 								new_packet.packet_id = last_packet_generated_id;
 								buffer.PutPacket(new_packet);
@@ -2559,7 +2802,7 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 
 						GetTxChannels(channels_for_tx, current_dcb_policy, channels_free,
 								current_left_channel, current_right_channel, current_primary_channel,
-								NUM_CHANNELS_KOMONDOR, &channel_power, channel_aggregation_cca_model);
+								NUM_CHANNELS_KOMONDOR, &channel_power, channel_aggregation_cca_model, rng_channel_bonding);
 
 						LOGS(save_node_logs,node_logger.file, "%.15f;N%d;S%d;%s;%s Channels for transmitting after RTS: ",
 								SimTime(), node_id, node_state, LOG_F02, LOG_LVL2);
@@ -2606,7 +2849,7 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 								frame_length, bits_ofdm_sym);
 
 							current_nav_time = ComputeNavTime(node_state, rts_duration, cts_duration, data_duration, ack_duration, SIFS);
-							current_nav_time = FixTimeOffset(current_nav_time,13,12); // Update the NAV time according to the time offsets
+							current_nav_time = RoundToSimTime(current_nav_time); // Update the NAV time according to the time offsets
 
 							// ------------------------------------------------------------------------
 							// Sergio on 07 Dec 2017: add CTS transmission time to spectrum utilization
@@ -2616,7 +2859,7 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 							// ------------------------------------------------------------------------
 
 							time_to_trigger = SimTime() + SIFS;
-							trigger_SIFS.Set(FixTimeOffset(time_to_trigger,13,12)); // triggers the SendResponsePacket() function after SIFS
+							trigger_SIFS.Set(time_to_trigger); // triggers the SendResponsePacket() function after SIFS
 
 							LOGS(save_node_logs,node_logger.file,
 								"%.15f;N%d;S%d;%s;%s SIFS will be triggered in %.12f\n",
@@ -2664,7 +2907,7 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 							 */
 							if(!node_is_transmitter) {
 								time_to_trigger = SimTime() + MAX_DIFFERENCE_SAME_TIME;
-								trigger_restart_sta.Set(FixTimeOffset(time_to_trigger,13,12));
+								trigger_restart_sta.Set(time_to_trigger);
 							} else {
 								RestartNode(FALSE);
 							}
@@ -2723,7 +2966,7 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 
 						// Compute the NAV time
 						current_nav_time = ComputeNavTime(node_state, rts_duration, cts_duration, data_duration, ack_duration, SIFS);
-						current_nav_time = FixTimeOffset(current_nav_time,13,12); // Update the NAV time according to the time offsets
+						current_nav_time = RoundToSimTime(current_nav_time); // Update the NAV time according to the time offsets
 
 						// Generate and send DATA to transmitter after SIFS
 						current_destination_id = notification.source_id;
@@ -2738,7 +2981,7 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 						}
 						// ------------------------------------------------------------------------
 
-						trigger_SIFS.Set(FixTimeOffset(time_to_trigger,13,12));
+						trigger_SIFS.Set(time_to_trigger);
 
 						LOGS(save_node_logs,node_logger.file,
 							"%.15f;N%d;S%d;%s;%s SIFS will be triggered in %.12f\n",
@@ -2798,14 +3041,8 @@ void Node :: InportSomeNodeFinishTX(Notification &notification){
 
 	// STATISTICS: compute the time the channel is idle (Node 0 is responsible to monitors this)
 	if (node_id == 0) {
-		int num_nodes_transmitting = 0;
-		for(int i = 0; i < total_nodes_number; ++i){
-			if(nodes_transmitting[i] == TRUE){
-				++ num_nodes_transmitting;
-			}
-		}
 		// Check if nobody is transmitting
-		if (num_nodes_transmitting == 0) {
+		if (medium->NumTransmissionsSensed(node_id) == 0) {
 			// If no one is transmitting, set the current SimTime() as the last time the channel has been seen idle
 			last_time_channel_is_idle = SimTime();
 			channel_idle = true;
@@ -2839,7 +3076,7 @@ void Node :: InportNackReceived(LogicalNack &logical_nack){
 
 		// Process logical NACK for statistics purposes
 		nack_reason = ProcessNack(logical_nack, node_id, node_logger, node_state, save_node_logs,
-			SimTime(), nacks_received, total_nodes_number, nodes_transmitting);
+			SimTime(), nacks_received);
 
 		if(nack_reason == PACKET_LOST_BO_COLLISION){
 			++ rts_lost_slotted_bo;
@@ -2889,19 +3126,15 @@ void Node :: InportMCSRequestReceived(Notification &notification){
 //			central_frequency, path_loss_model));
 
 		// Update 'power received' array in case a new tx power is used
-		if (notification.tx_info.flag_change_in_tx_power) {
-			received_power_array[notification.source_id] =
-				ComputePowerReceived(distances_array[notification.source_id],
-				notification.tx_info.tx_power, central_frequency, path_loss_model);
-		}
+		if (notification.tx_info.flag_change_in_tx_power) RefreshPowerReceived(notification);
 
 		LOGS(save_node_logs,node_logger.file, "%.15f;N%d;S%d;%s;%s I am at distance: %.2f m (sensing P_rx = %.2f dBm)\n",
 			SimTime(), node_id, node_state, LOG_F00, LOG_LVL2,
-			distances_array[notification.source_id], ConvertPower(PW_TO_DBM,
-			received_power_array[notification.source_id]));
+			links.Distance(notification.source_id), ConvertPower(PW_TO_DBM,
+			links.ReceivedPower(notification.source_id)));
 
 		// Select the modulation according to the SINR perceived corresponding to incoming transmitter
-		SelectMCSResponse(mcs_response, received_power_array[notification.source_id]);
+		SelectMCSResponse(mcs_response, links.ReceivedPower(notification.source_id));
 
 		LOGS(save_node_logs,node_logger.file, "%.15f;N%d;S%d;%s;%s mcs_response for 1, 2, 4 and 8 channels: ",
 			SimTime(), node_id, node_state, LOG_F00, LOG_LVL3);
@@ -3019,7 +3252,6 @@ void Node :: InportNewPacketGenerated(){
 			if (buffer.QueueSize() < PACKET_BUFFER_SIZE) {
 
 				// Include new packet
-				new_packet = null_notification;
 				new_packet.timestamp_generated = SimTime();
 				new_packet.packet_id = last_packet_generated_id;
 				buffer.PutPacket(new_packet);
@@ -3040,7 +3272,7 @@ void Node :: InportNewPacketGenerated(){
 
 					if (resume) {
 						time_to_trigger = SimTime() + DIFS;
-						trigger_start_backoff.Set(FixTimeOffset(time_to_trigger,13,12));
+						trigger_start_backoff.Set(time_to_trigger);
 					}
 
 				}
@@ -3079,7 +3311,7 @@ void Node :: InportNewPacketGenerated(){
 				if (buffer.QueueSize() < PACKET_BUFFER_SIZE) {
 
 					// Include new packet
-					Notification new_packet;
+					Packet new_packet;
 					new_packet.timestamp_generated = SimTime();
 					new_packet.packet_id = last_packet_generated_id;
 					buffer.PutPacket(new_packet);
@@ -3103,7 +3335,7 @@ void Node :: InportNewPacketGenerated(){
 
 						if (resume) {
 							time_to_trigger = SimTime() + DIFS;
-							trigger_start_backoff.Set(FixTimeOffset(time_to_trigger,13,12));
+							trigger_start_backoff.Set(time_to_trigger);
 						}
 
 					}
@@ -3239,7 +3471,7 @@ void Node :: EndBackoff(trigger_t &){
 
 	GetTxChannels(channels_for_tx, current_dcb_policy, channels_free,
 			min_channel_allowed, max_channel_allowed, current_primary_channel,
-			NUM_CHANNELS_KOMONDOR, &channel_power, channel_aggregation_cca_model);
+			NUM_CHANNELS_KOMONDOR, &channel_power, channel_aggregation_cca_model, rng_channel_bonding);
 
 	LOGS(save_node_logs,node_logger.file, "%.15f;N%d;S%d;%s;%s Channels for transmitting: ",
 		SimTime(), node_id, node_state, LOG_F02, LOG_LVL2);
@@ -3338,7 +3570,7 @@ void Node :: EndBackoff(trigger_t &){
 
 		// Compute the NAV time
 		current_nav_time = ComputeNavTime(node_state, rts_duration, cts_duration, data_duration, ack_duration, SIFS);
-		current_nav_time = FixTimeOffset(current_nav_time,13,12); // Update the NAV time according to the time offsets
+		current_nav_time = RoundToSimTime(current_nav_time); // Update the NAV time according to the time offsets
 
 //		LOGS(save_node_logs,node_logger.file,
 //			"%.15f;N%d;S%d;%s;%s RTS duration: %.12f s - NAV duration = %.12f s\n",
@@ -3356,11 +3588,11 @@ void Node :: EndBackoff(trigger_t &){
 		 */
 		time_rand_value = 0;
 		if(backoff_type == BACKOFF_SLOTTED){
-			int rand_number (2 + rand() % (MAX_NUM_RAND_TIME-2));	// in [2, MAX_NUM_RAND_TIME]
+			int rand_number (2 + rng_start.Uniform(MAX_NUM_RAND_TIME-2));	// in [2, MAX_NUM_RAND_TIME]
 			time_rand_value = (double) rand_number * MAX_DIFFERENCE_SAME_TIME/MAX_NUM_RAND_TIME; // in [FEMTO_SECOND, MAX_DIFFERENCE_SAME_TIME]
 			// Sergio on 28/09/2017
 			// time_rand_value = RoundToDigits(time_rand_value, 15);
-			time_rand_value = FixTimeOffset(time_rand_value,13,12);
+			time_rand_value = RoundToSimTime(time_rand_value);
 			current_nav_time = current_nav_time - time_rand_value;
 //			LOGS(save_node_logs,node_logger.file,
 //				"%.15f;N%d;S%d;%s;%s time_rand_value = %.12f s - corrected NAV time = %.12f s\n",
@@ -3369,7 +3601,7 @@ void Node :: EndBackoff(trigger_t &){
 		}
 
 		// Generate the RTS notification
-		Notification first_packet_buffer = buffer.GetFirstPacket();
+		const Packet &first_packet_buffer (buffer.GetFirstPacket());
 
 		rts_notification = GenerateNotification(PACKET_TYPE_RTS, current_destination_id,
 			first_packet_buffer.packet_id, limited_num_packets_aggregated,
@@ -3403,7 +3635,7 @@ void Node :: EndBackoff(trigger_t &){
 		// Send RTS notification and trigger to finish transmission
 		if(backoff_type == BACKOFF_SLOTTED){
 			time_to_trigger = SimTime() + time_rand_value;
-			trigger_preoccupancy.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_preoccupancy.Set(time_to_trigger);
 			rts_notification.tx_info.preoccupancy_duration = time_rand_value;
 		} else {
 			outportSelfStartTX(rts_notification);
@@ -3412,11 +3644,11 @@ void Node :: EndBackoff(trigger_t &){
 		time_to_trigger = SimTime() + current_tx_duration;
 
 //		LOGS(save_node_logs,node_logger.file,
-//			"%.15f;N%d;S%d;%s;%s time_to_trigger = %.12f s - FixTimeOffset = %.12f s\n",
+//			"%.15f;N%d;S%d;%s;%s time_to_trigger = %.12f s - RoundToSimTime = %.12f s\n",
 //			SimTime(), node_id, node_state, LOG_F04, LOG_LVL5,
-//			time_to_trigger, FixTimeOffset(time_to_trigger,13,12));
+//			time_to_trigger, RoundToSimTime(time_to_trigger));
 
-		trigger_toFinishTX.Set(FixTimeOffset(time_to_trigger,13,12));
+		trigger_toFinishTX.Set(time_to_trigger);
 		++rts_cts_sent;
 		++rts_cts_sent_per_sta[current_destination_id-node_id-1];
 		trigger_start_backoff.Cancel();	// Safety instruction
@@ -3453,7 +3685,7 @@ void Node :: MyTxFinished(trigger_t &){
 			// time_to_trigger = SimTime() + SIFS + notification.tx_info.cts_duration + DIFS;
 			time_to_trigger = SimTime() + SIFS + notification.tx_info.cts_duration;
 
-			trigger_CTS_timeout.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_CTS_timeout.Set(time_to_trigger);
 
 			node_state = STATE_WAIT_CTS;
 
@@ -3474,7 +3706,7 @@ void Node :: MyTxFinished(trigger_t &){
 
 			// Set CTS timeout and change state to STATE_WAIT_DATA
 			time_to_trigger = SimTime() + SIFS + TIME_OUT_EXTRA_TIME;
-			trigger_DATA_timeout.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_DATA_timeout.Set(time_to_trigger);
 			node_state = STATE_WAIT_DATA;
 
 			LOGS(save_node_logs,node_logger.file, "%.15f;N%d;S%d;%s;%s CTS %d tx finished. Waiting for DATA...\n",
@@ -3493,7 +3725,7 @@ void Node :: MyTxFinished(trigger_t &){
 
 			// Set ACK timeout and change state to STATE_WAIT_ACK
 			time_to_trigger = SimTime() + SIFS + TIME_OUT_EXTRA_TIME;
-			trigger_ACK_timeout.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_ACK_timeout.Set(time_to_trigger);
 			node_state = STATE_WAIT_ACK;
 
 			LOGS(save_node_logs,node_logger.file, "%.15f;N%d;S%d;%s;%s DATA %d tx finished. Waiting for ACK...\n",
@@ -3567,7 +3799,7 @@ void Node :: SelectDestination(){
 //	LOGS(save_node_logs,node_logger.file, "%.15f;N%d;S%d;%s;%s SelectDestination()\n",
 //			SimTime(), node_id, node_state, LOG_G00, LOG_LVL1);
 
-	current_destination_id = PickRandomElementFromArray(wlan.list_sta_id, wlan.num_stas);
+	current_destination_id = PickRandomElementFromArray(wlan.list_sta_id, wlan.num_stas, rng_destination);
 	// LOGS(save_node_logs,node_logger.file, "%.15f;N%d;S%d;%s;%s SelectDestination() END\n", SimTime(), node_id, node_state, LOG_G00, LOG_LVL1);
 }
 
@@ -3713,14 +3945,13 @@ void Node :: SendResponsePacket(trigger_t &){
 			outportSelfStartTX(ack_notification);
 
 			// trigger_toFinishTX.Set(SimTime() + current_tx_duration);
-			// time_to_trigger = TruncateDouble(SimTime() + FEMTO_VALUE,12) + current_tx_duration;
 			time_to_trigger = SimTime() + current_tx_duration;
-			trigger_toFinishTX.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_toFinishTX.Set(time_to_trigger);
 
 			LOGS(save_node_logs,node_logger.file,
-				"%.15f;N%d;S%d;%s;%s TruncateDouble = %.12f - current_tx_duration = %.12f - trigger_toFinishTX = %.12f\n",
+				"%.15f;N%d;S%d;%s;%s current_tx_duration = %.12f - trigger_toFinishTX = %.12f\n",
 				SimTime(), node_id, node_state, LOG_I00, LOG_LVL3,
-				TruncateDouble(SimTime() + FEMTO_VALUE,12), current_tx_duration, trigger_toFinishTX.GetTime());
+				current_tx_duration, trigger_toFinishTX.GetTime());
 
 			break;
 		}
@@ -3732,7 +3963,7 @@ void Node :: SendResponsePacket(trigger_t &){
 			outportSelfStartTX(cts_notification);
 
 			time_to_trigger = SimTime() + current_tx_duration;
-			trigger_toFinishTX.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_toFinishTX.Set(time_to_trigger);
 			break;
 		}
 
@@ -3742,7 +3973,7 @@ void Node :: SendResponsePacket(trigger_t &){
 				SimTime(), node_id, node_state, LOG_I00, LOG_LVL3);
 			outportSelfStartTX(data_notification);
 			time_to_trigger = SimTime() + current_tx_duration;
-			trigger_toFinishTX.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_toFinishTX.Set(time_to_trigger);
 			++data_packets_sent;
 			++data_packets_sent_per_sta[current_destination_id-node_id-1];
 			// Update performance measurements
@@ -3763,7 +3994,7 @@ void Node :: AbortRtsTransmission(){
 
 	num_tx_init_not_possible ++;
 	// Compute a new backoff and trigger a new DIFS
-	remaining_backoff = ComputeBackoff(pdf_backoff, cw_current, backoff_type);
+	remaining_backoff = ComputeBackoff(pdf_backoff, cw_current, backoff_type, rng_backoff);
 	expected_backoff += remaining_backoff;
 	num_new_backoff_computations++;
 	node_state = STATE_SENSING;
@@ -3917,7 +4148,7 @@ void Node :: NavTimeout(trigger_t &){
 
 			time_to_trigger = SimTime() + DIFS - TIME_OUT_EXTRA_TIME;
 
-			trigger_start_backoff.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_start_backoff.Set(time_to_trigger);
 
 			LOGS(save_node_logs,node_logger.file,
 				"%.15f;N%d;S%d;%s;%s Starting new DIFS to finsih in %.12f\n",
@@ -4005,7 +4236,7 @@ void Node :: ResumeBackoff(trigger_t &){
 
 	time_to_trigger = SimTime() + remaining_backoff;
 
-	trigger_end_backoff.Set(FixTimeOffset(time_to_trigger,13,12));
+	trigger_end_backoff.Set(time_to_trigger);
 
 	LOGS(save_node_logs,node_logger.file, "%.15f;N%d;S%d;%s;%s Resuming backoff in %.9f us (%.2f slots)\n",
 		SimTime(), node_id, node_state, LOG_F00, LOG_LVL3,
@@ -4146,7 +4377,7 @@ void Node :: UpdatePerformanceMeasurements(){
 	}
 
 	// RSSI received from each STA
-	if(node_type == NODE_TYPE_AP) UpdateRssiPerSta(wlan, rssi_per_sta, received_power_array, total_nodes_number);
+	if(node_type == NODE_TYPE_AP) UpdateRssiPerSta(wlan, rssi_per_sta, links);
 	performance_report.rssi_list_per_sta = rssi_per_sta;
 
 	// -  Channel occupancy
@@ -4240,6 +4471,7 @@ void Node :: ApplyNewConfiguration(Configuration &new_configuration) {
 	// current_max_bandwidth determines the min and max allowed channels given a primary
 	GetMinAndMaxAllowedChannels(min_channel_allowed, max_channel_allowed,
 			current_primary_channel, current_max_bandwidth);
+	SubscribeToChannels();
 
 	non_srg_obss_pd = new_configuration.non_srg_obss_pd;
 	// Re-compute MCS according to the new configuration
@@ -4254,6 +4486,20 @@ void Node :: ApplyNewConfiguration(Configuration &new_configuration) {
 	if(save_node_logs) WriteNodeConfiguration(node_logger, header_str);
 }
 
+/**
+ * Subscribe to the allowed channels in the medium. The ongoing transmissions that were not delivered
+ * to the node but reach the new channels are sensed right away (their end will be delivered too)
+ */
+void Node :: SubscribeToChannels() {
+	std::vector<int> late_senders;
+	medium->Subscribe(node_id, min_channel_allowed, max_channel_allowed, late_senders);
+	for(size_t i = 0; i < late_senders.size(); ++i) {
+		LOGS(save_node_logs,node_logger.file, "%.15f;N%d;S%d;%s;%s Sensing the ongoing transmission of N%d in the new channels\n",
+			SimTime(), node_id, node_state, LOG_F02, LOG_LVL3, late_senders[i]);
+		SenseTransmissionStart(medium->ongoing_notification[late_senders[i]]);
+	}
+}
+
 /**
  * Broadcast a new configuration to be applied by all the STAs (only executed by AP nodes)
  * @param "new_configuration" [type Configuration]: struct containing the new configuration to be broadcasted
@@ -4381,7 +4627,7 @@ void Node :: RestartNode(int called_by_time_out){
 		++packet_id;
 
 		// In case of being an AP
-		remaining_backoff = ComputeBackoff(pdf_backoff, cw_current, backoff_type);
+		remaining_backoff = ComputeBackoff(pdf_backoff, cw_current, backoff_type, rng_backoff);
 		expected_backoff = expected_backoff + remaining_backoff;
 		++num_new_backoff_computations;
 
@@ -4418,7 +4664,7 @@ void Node :: RestartNode(int called_by_time_out){
 				SimTime(), node_id, node_state, LOG_Z00, LOG_LVL5);
 			// time_to_trigger = SimTime() + DIFS - TIME_OUT_EXTRA_TIME;
 			time_to_trigger = SimTime() + DIFS;
-			trigger_start_backoff.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_start_backoff.Set(time_to_trigger);
 		} else {
 			LOGS(save_node_logs,node_logger.file,
 				"%.15f;N%d;S%d;%s;%s BO cannot be resumed!\n",
@@ -4459,7 +4705,7 @@ void Node:: HandleSlottedBackoffCollision() {
 	if(!node_is_transmitter) {
 		node_state = STATE_SLEEP; // avoid listening to notifications until restart
 		time_to_trigger = SimTime() + MAX_DIFFERENCE_SAME_TIME;
-		trigger_restart_sta.Set(FixTimeOffset(time_to_trigger,13,12));
+		trigger_restart_sta.Set(time_to_trigger);
 	} else {
 		// In case STAs can send to AP
 		RestartNode(FALSE);
@@ -4528,7 +4774,7 @@ void Node:: CallSensing(trigger_t &){
 			SimTime(), node_id, node_state, LOG_Z00, LOG_LVL5);
 		// time_to_trigger = SimTime() + DIFS - TIME_OUT_EXTRA_TIME;
 		time_to_trigger = SimTime() + DIFS;
-		trigger_start_backoff.Set(FixTimeOffset(time_to_trigger,13,12));
+		trigger_start_backoff.Set(time_to_trigger);
 	} else {
 		/* ****************************************
 		/* SPATIAL REUSE OPERATION
@@ -4538,7 +4784,7 @@ void Node:: CallSensing(trigger_t &){
 		if (loss_reason == PACKET_NOT_LOST && spatial_reuse_enabled) {
 			// TODO: method for checking whether the detected transmission can be decoded or not
 			loss_reason_sr = IsPacketLost(current_primary_channel, nav_notification, nav_notification,
-				current_sinr, capture_effect, potential_obss_pd_threshold, power_rx_interest, constant_per, node_id, capture_effect_model);
+				current_sinr, capture_effect, potential_obss_pd_threshold, power_rx_interest, constant_per, node_id, capture_effect_model, rng_packet_loss);
 			if (loss_reason_sr != PACKET_NOT_LOST && node_is_transmitter) {
 				txop_sr_identified = TRUE;	// TXOP identified!
 				current_obss_pd_threshold = potential_obss_pd_threshold;	// Update the pd
@@ -4680,14 +4926,24 @@ void Node :: PrintNodeConfiguration(){
 void Node :: PrintProgressBar(trigger_t &){
 	// if(print_node_logs) printf("* %d %% *\n", progress_bar_counter * PROGRESS_BAR_DELTA);
 	printf("* %d %% *\n", progress_bar_counter * PROGRESS_BAR_DELTA);
-	trigger_sim_time.Set(RoundToDigits(SimTime() + simulation_time_komondor / (100/PROGRESS_BAR_DELTA),15));
+	trigger_sim_time.Set(SimTime() + simulation_time_komondor / (100/PROGRESS_BAR_DELTA));
 	// End progress bar
 	if(node_id == 0 && progress_bar_counter == (100/PROGRESS_BAR_DELTA)-1){
-		trigger_sim_time.Set(RoundToDigits(SimTime() + simulation_time_komondor/(100/PROGRESS_BAR_DELTA) - MIN_VALUE_C_LANGUAGE,15));
+		trigger_sim_time.Set(SimTime() + simulation_time_komondor/(100/PROGRESS_BAR_DELTA) - MIN_VALUE_C_LANGUAGE);
 	}
 	++progress_bar_counter;
 }
 
+/**
+ * Write the nodes whose ongoing transmission is sensed by this node (kept by the medium)
+ */
+void Node :: WriteNodesTransmitting(){
+	std::vector<int> nodes_transmitting(total_nodes_number);
+	medium->GetTransmittersSensed(node_id, &nodes_transmitting[0]);
+	PrintOrWriteNodesTransmitting(WRITE_LOG, save_node_logs,
+		print_node_logs, node_logger, total_nodes_number, &nodes_transmitting[0]);
+}
+
 /**
  * Print or write final statistics of the given node
  * @param "write_or_print" [type int]: variable indicating whether to print or write logs
@@ -4699,6 +4955,7 @@ void Node :: PrintOrWriteNodeStatistics(int write_or_print){
 	double rts_cts_lost_percentage (0);
 	double tx_init_failure_percentage (0);
 	double rts_lost_bo_percentage (0);
+	double observation_time (SimTime() - time_statistics_cleared);	// Time since the statistics were cleared
 
 	if (num_delay_measurements > 0) average_delay = sum_delays / (double) num_delay_measurements;
 	if (flag_measure_rho && num_measures_rho > 0) average_rho = (double) num_measures_rho_accomplished/(double) num_measures_rho;
@@ -4713,9 +4970,9 @@ void Node :: PrintOrWriteNodeStatistics(int write_or_print){
 	if (num_packets_generated > 1){
 		generation_drop_ratio = num_packets_dropped * 100/ num_packets_generated;
 	}
-	throughput = ((double) data_frames_acked * frame_length) / SimTime();
+	throughput = ((double) data_frames_acked * frame_length) / observation_time;
 	for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
-		bandwidth_used_txing += (total_time_spectrum_per_channel[c]/SimTime()) * 20;
+		bandwidth_used_txing += (total_time_spectrum_per_channel[c]/observation_time) * 20;
 	}
 //	int hidden_nodes_number = 0;
 //	for(int i = 0; i < total_nodes_number; ++i){
@@ -4760,7 +5017,7 @@ void Node :: PrintOrWriteNodeStatistics(int write_or_print){
 					LOG_LVL2, data_frames_acked, (double) data_frames_acked/data_packets_acked);
 				// Data packets sent and lost
 				printf("%s Buffer: packets generated = %.0f (%.2f pkt/s) - Packets dropped = %.0f  (%f %% drop ratio)\n",
-					LOG_LVL2, num_packets_generated, num_packets_generated / SimTime(), num_packets_dropped, generation_drop_ratio);
+					LOG_LVL2, num_packets_generated, num_packets_generated / observation_time, num_packets_dropped, generation_drop_ratio);
 				if(TRAFFIC_POISSON_BURST){
 					printf("%s Buffer: num bursts = %d\n",
 						LOG_LVL2,
@@ -4776,7 +5033,7 @@ void Node :: PrintOrWriteNodeStatistics(int write_or_print){
 							LOG_LVL3, (int) pow(2,n),
 							total_time_transmitting_in_num_channels[n] - total_time_lost_in_num_channels[n],
 							((total_time_transmitting_in_num_channels[n] -
-									total_time_lost_in_num_channels[n])) * 100 /SimTime());
+									total_time_lost_in_num_channels[n])) * 100 /observation_time);
 					if((int) pow(2,n) == NUM_CHANNELS_KOMONDOR) break;
 				}
 				printf("\n");
@@ -4788,7 +5045,7 @@ void Node :: PrintOrWriteNodeStatistics(int write_or_print){
 						total_time_lost_per_channel[c];
 					printf("\n%s - %d = %.2f s (%.2f %%)",
 						LOG_LVL3, c, time_effectively_txing,
-						(time_effectively_txing * 100 /SimTime()));
+						(time_effectively_txing * 100 /observation_time));
 				}
 				printf("\n");
 				// Spectrum utilization
@@ -4796,7 +5053,7 @@ void Node :: PrintOrWriteNodeStatistics(int write_or_print){
 				for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
 					printf("\n%s - %d = %.2f s (%.2f %%)",
 						LOG_LVL3, c, total_time_spectrum_per_channel[c],
-						(total_time_spectrum_per_channel[c] * 100 /SimTime()));
+						(total_time_spectrum_per_channel[c] * 100 /observation_time));
 				}
 				printf("\n%s - Average bandwidth used for transmitting = %.2f MHz / %d MHz (%.2f %%)\n",
 					LOG_LVL4,
@@ -4850,7 +5107,7 @@ void Node :: PrintOrWriteNodeStatistics(int write_or_print){
 
 				printf("%s times_went_to_nav = %d\n", LOG_LVL2, times_went_to_nav);
 				printf("%s time_in_nav = %f (%.2f %% of the total time)\n", LOG_LVL2,
-					time_in_nav, (time_in_nav/simulation_time_komondor*100));
+					time_in_nav, (time_in_nav/observation_time*100));
 
 				printf("%s average_waiting_time = %f (%f slots)\n", LOG_LVL2, average_waiting_time, average_waiting_time / SLOT_TIME);
 				printf("%s Expected BO = %f (%f slots)\n", LOG_LVL2, expected_backoff, expected_backoff / SLOT_TIME);
@@ -4860,7 +5117,7 @@ void Node :: PrintOrWriteNodeStatistics(int write_or_print){
 				// Throughput
 				printf("%s Throughput: {", LOG_LVL3);
 				for(int n = 0; n < wlan.num_stas; ++n){
-					throughput_per_sta[n] = ((double)data_frames_acked_per_sta[n] * (double)frame_length) / SimTime();
+					throughput_per_sta[n] = ((double)data_frames_acked_per_sta[n] * (double)frame_length) / observation_time;
 					printf("%.2f Mbps",  throughput_per_sta[n] * pow(10,-6));
 					if(n<wlan.num_stas-1) printf(", ");
 				}
@@ -4947,7 +5204,7 @@ void Node :: PrintOrWriteNodeStatistics(int write_or_print){
 					for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
 						fprintf(node_logger.file,"\n%s - %d = %.2f s (%.2f %%)",
 							LOG_LVL3, c, total_time_spectrum_per_channel[c],
-							(total_time_spectrum_per_channel[c] * 100 /SimTime()));
+							(total_time_spectrum_per_channel[c] * 100 /observation_time));
 					}
 
 					fprintf(node_logger.file,"\n%s - Average bandwidth used for transmitting = %.2f MHz / %d MHz (%.2f %%)\n",
@@ -5037,7 +5294,7 @@ void Node :: SaveSimulationPerformance() {
 //			printf("simulation_performance.rssi_list[%d] = %f dBm\n",i,ConvertPower(PW_TO_DBM,simulation_performance.rssi_list[i]));
 //		}
 	}
-	simulation_performance.received_power_array = received_power_array;
+	simulation_performance.links = links;
 
 	// Other
 	simulation_performance.num_tx_init_tried = num_tx_init_tried;
@@ -5048,6 +5305,75 @@ void Node :: SaveSimulationPerformance() {
 
 }
 
+/**
+ * Clear the statistics (e.g., at the end of the warm-up). The state of the node is kept and
+ * the rates computed at the end of the simulation only consider the time elapsed from now on.
+ */
+void Node :: ClearStatistics() {
+
+	time_statistics_cleared = SimTime();
+
+	data_packets_sent = 0;
+	rts_cts_sent = 0;
+	num_packets_generated = 0;
+	num_packets_dropped = 0;
+	throughput = 0;
+	throughput_loss = 0;
+	data_packets_acked = 0;
+	data_frames_acked = 0;
+	data_packets_lost = 0;
+	rts_cts_lost = 0;
+	num_tx_init_tried = 0;
+	num_tx_init_not_possible = 0;
+	rts_lost_slotted_bo = 0;
+	prob_slotted_bo_collision = 0;
+	average_waiting_time = 0;
+	bandwidth_used_txing = 0;
+	num_delay_measurements = 0;
+	sum_delays = 0;
+	average_delay = 0;
+	average_rho = 0;
+	average_utilization = 0;
+	generation_drop_ratio = 0;
+	expected_backoff = 0;
+	num_new_backoff_computations = 0;
+	num_measures_rho = 0;
+	num_measures_rho_accomplished = 0;
+	num_measures_utilization = 0;
+	num_measures_buffer_with_packets = 0;
+	sum_waiting_time = 0;
+	num_average_waiting_time_measurements = 0;
+
+	// Ongoing periods only count from now on
+	sum_time_channel_idle = 0;
+	if (channel_idle) last_time_channel_is_idle = SimTime();
+	time_in_nav = 0;
+	times_went_to_nav = 0;
+	if (node_state == STATE_NAV) last_time_not_in_nav = SimTime();
+
+	for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
+		total_time_transmitting_per_channel[c] = 0;
+		total_time_transmitting_in_num_channels[c] = 0;
+		total_time_lost_per_channel[c] = 0;
+		total_time_lost_in_num_channels[c] = 0;
+		total_time_spectrum_per_channel[c] = 0;
+		num_trials_tx_per_num_channels[c] = 0;
+	}
+	for(int i = 0; i < NUM_PACKET_LOST_REASONS; ++i){
+		nacks_received[i] = 0;
+	}
+	for(int i = 0; i < wlan.num_stas; ++i){
+		throughput_per_sta[i] = 0;
+		data_packets_sent_per_sta[i] = 0;
+		rts_cts_sent_per_sta[i] = 0;
+		data_packets_lost_per_sta[i] = 0;
+		rts_cts_lost_per_sta[i] = 0;
+		data_packets_acked_per_sta[i] = 0;
+		data_frames_acked_per_sta[i] = 0;
+	}
+
+}
+
 /*****************************/
 /*****************************/
 /*  VARIABLE INITIALISATION  */
@@ -5072,6 +5398,13 @@ void Node :: InitializeVariables() {
 	 * END OF HARDCODED INITIALIZATION
 	 */
 
+	// Random streams
+	rng_backoff.Initialize(seed, node_id, RNG_STREAM_BACKOFF);
+	rng_packet_loss.Initialize(seed, node_id, RNG_STREAM_PACKET_LOSS);
+	rng_channel_bonding.Initialize(seed, node_id, RNG_STREAM_CHANNEL_BONDING);
+	rng_destination.Initialize(seed, node_id, RNG_STREAM_DESTINATION);
+	rng_start.Initialize(seed, node_id, RNG_STREAM_START);
+
 	current_max_bandwidth = max_channel_allowed - min_channel_allowed + 1;
 
 	current_sinr = 0;
@@ -5104,14 +5437,16 @@ void Node :: InitializeVariables() {
 	node_logger.file = node_logger.file;
 
 	// Arrays and other
-	channel_power = new double[NUM_CHANNELS_KOMONDOR];
+	channel_power = medium->ChannelPower(node_id);
+	channel_power_compensation = medium->ChannelPowerCompensation(node_id);
+	num_channel_power_updates = 0;
 	num_channels_allowed = (max_channel_allowed - min_channel_allowed + 1);
 	total_time_transmitting_per_channel = new double[NUM_CHANNELS_KOMONDOR];
 	channels_free = new int[NUM_CHANNELS_KOMONDOR];
 	channels_for_tx = new int[NUM_CHANNELS_KOMONDOR];
 	total_time_lost_per_channel = new double[NUM_CHANNELS_KOMONDOR];
 	total_time_spectrum_per_channel = new double[NUM_CHANNELS_KOMONDOR];
-	timestampt_channel_becomes_free = new double[NUM_CHANNELS_KOMONDOR];
+	timestampt_channel_becomes_free = medium->TimestampsChannelFree(node_id);
 	num_trials_tx_per_num_channels = new int[NUM_CHANNELS_KOMONDOR];
 
 	for(int i = 0; i < NUM_CHANNELS_KOMONDOR; ++i){
@@ -5132,18 +5467,12 @@ void Node :: InitializeVariables() {
 		total_time_lost_in_num_channels[i] = 0;
 	}
 
-	nodes_transmitting = new int[total_nodes_number];
 //	// List of hidden nodes (1 indicates hidden nodes, 0 indicates the opposite)
 //	hidden_nodes_list = new int[total_nodes_number];
 //	// Counter for the times a node was implied in a collision by hidden node
 //	potential_hidden_nodes = new int[total_nodes_number];
-	for(int n = 0; n < total_nodes_number; ++n){
-		nodes_transmitting[n] = FALSE;
-//		hidden_nodes_list[n] = FALSE;
-//		potential_hidden_nodes[n] = 0;
-	}
 
-	power_received_per_node.clear();
+	power_received_per_node.InitializeActiveTransmitters();
 
 //	potential_hidden_nodes[node_id] = -1; // To indicate that the node cannot be hidden from itself
 	nacks_received = new int[NUM_PACKET_LOST_REASONS];
@@ -5174,7 +5503,7 @@ void Node :: InitializeVariables() {
 
 	if(node_type == NODE_TYPE_AP) {
 		node_is_transmitter = TRUE;
-		remaining_backoff = ComputeBackoff(pdf_backoff, cw_current, backoff_type);
+		remaining_backoff = ComputeBackoff(pdf_backoff, cw_current, backoff_type, rng_backoff);
 		expected_backoff += remaining_backoff;
 		num_new_backoff_computations++;
 	} else {
@@ -5244,9 +5573,11 @@ void Node :: InitializeVariables() {
 	incoming_notification = null_notification;
 	rts_notification = null_notification;
 	cts_notification = null_notification;
-	new_packet = null_notification;
+	new_packet.packet_id = 0;
+	new_packet.timestamp_generated = 0;
 
 	// Statistics
+	time_statistics_cleared = 0;
 	data_packets_sent = 0;
 	rts_cts_sent = 0;
 	throughput = 0;
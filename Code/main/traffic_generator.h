@@ -55,6 +55,7 @@
 
 #include "../list_of_macros.h"
 #include "../methods/auxiliary_methods.h"
+#include "../structures/random_stream.h"
 
 // Agent component: "TypeII" represents components that are aware of the existence of the simulated time.
 component TrafficGenerator : public TypeII{
@@ -65,6 +66,7 @@ component TrafficGenerator : public TypeII{
 		void Setup();
 		void Start();
 		void Stop();
+		void Checkpoint(CostSnapshot &snapshot);
 		// Generic
 		void InitializeTrafficGenerator();
 		void GenerateTraffic();
@@ -75,6 +77,7 @@ component TrafficGenerator : public TypeII{
 
 		int node_type;			///> Type of node associated to the traffic generator
 		int node_id; 			///> Node identifier associated to the traffic generator
+		int seed;				///> Simulation seed (key of the random stream)
 		int traffic_model;		///> Traffic model
 		double traffic_load;	///> Average traffic load of the AP [packets/s]
 		// Burst traffic
@@ -84,6 +87,8 @@ component TrafficGenerator : public TypeII{
 	// Private items (just for node operation)
 	private:
 
+		RandomStream rng_traffic;	///> Packet generation times (keyed by seed and node id)
+
 	// Connections and timers
 	public:
 
@@ -125,6 +130,16 @@ void TrafficGenerator :: Stop(){
 
 };
 
+/**
+ * Checkpoint(): save or load the state of the traffic generator. The traffic model, load
+ * and burst rate come from the input, so a loaded snapshot keeps the values of the new run.
+ * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+ */
+void TrafficGenerator :: Checkpoint(CostSnapshot &snapshot){
+	snapshot.Value(num_bursts);
+	snapshot.Value(rng_traffic);
+};
+
 /**
  * Main method for generating traffic
  */
@@ -153,9 +168,9 @@ void TrafficGenerator :: GenerateTraffic() {
 			traffic_model = TRAFFIC_POISSON;
 			traffic_load = 1000;
 			// --- Poisson ---
-			time_for_next_packet = Exponential(1/traffic_load);
+			time_for_next_packet = rng_traffic.Exponential(1/traffic_load);
 			time_to_trigger = SimTime() + time_for_next_packet;
-			trigger_new_packet_generated.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_new_packet_generated.Set(time_to_trigger);
 			break;
 		}
 
@@ -166,9 +181,9 @@ void TrafficGenerator :: GenerateTraffic() {
 			//   with BO generation exponentially distributed.
 			// time_for_next_packet = Exponential(1/lambda);
 			// Generates new packet when the trigger expires
-			time_for_next_packet = Exponential(1/traffic_load);
+			time_for_next_packet = rng_traffic.Exponential(1/traffic_load);
 			time_to_trigger = SimTime() + time_for_next_packet;
-			trigger_new_packet_generated.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_new_packet_generated.Set(time_to_trigger);
 			break;
 		}
 
@@ -177,7 +192,7 @@ void TrafficGenerator :: GenerateTraffic() {
 			int lambda = 10000;
 			time_for_next_packet = 1/lambda;
 			time_to_trigger = SimTime() + time_for_next_packet;
-			trigger_new_packet_generated.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_new_packet_generated.Set(time_to_trigger);
 			break;
 		}
 
@@ -185,12 +200,12 @@ void TrafficGenerator :: GenerateTraffic() {
 		case TRAFFIC_POISSON_BURST:{
 			// Sergio on 2nd February 2018
 			// - Input: traffic load and average time between bursts
-			time_for_next_packet = Exponential(burst_rate/traffic_load);
+			time_for_next_packet = rng_traffic.Exponential(burst_rate/traffic_load);
 			time_to_trigger = SimTime() + time_for_next_packet;
 //			if(save_node_logs) fprintf(node_logger.file, "%.15f;N%d;S%d;%s;%s New generation burst will be triggered in %f ms\n",
 //				SimTime(), node_id, node_state, LOG_F00, LOG_LVL3,
 //				time_for_next_packet * 1000);
-			trigger_new_packet_generated.Set(FixTimeOffset(time_to_trigger,13,12));
+			trigger_new_packet_generated.Set(time_to_trigger);
 			break;
 		}
 
@@ -222,5 +237,6 @@ void TrafficGenerator :: InitializeTrafficGenerator() {
 	 */
 	burst_rate = 10;
 	num_bursts = 0;
+	rng_traffic.Initialize(seed, node_id, RNG_STREAM_TRAFFIC);
 	GenerateTraffic();
 }
@@ -56,6 +56,7 @@
 #include <sstream>
 
 #include "../list_of_macros.h"
+#include "../structures/random_stream.h"
 
 #ifndef _AUX_METHODS_
 #define _AUX_METHODS_
@@ -72,13 +73,14 @@ std::string ToString(T val)
 * Pick uniformly random an element of an array
 * @param "array" [type int*]: array of integers
 * @param "array_size" [type int]: size of the introduced array
+* @param "stream" [type RandomStream]: random stream used for picking the element
 * @return "element" [type int]: random element from the input array of integers
 */
-int PickRandomElementFromArray(int *array, int array_size){
+int PickRandomElementFromArray(int *array, int array_size, RandomStream &stream){
 	int element (0);
 	// Pick one of the STAs in the WLAN uniformly
 	if(array_size > 0){
-		int rand_ix (rand()%(array_size));
+		int rand_ix (stream.Uniform(array_size));
 		element = array[rand_ix];
 	} else {
 		element = NODE_ID_NONE;
@@ -107,6 +109,36 @@ int PickElementFromArrayRR(int *array, int array_size){
 	return element;
 }
 
+/**
+* Find the representative of the set containing an element (disjoint-set forest with path halving)
+* @param "parent" [type int*]: parent of each element (roots point to themselves)
+* @param "ix" [type int]: element
+* @return "root" [type int]: representative of the set
+*/
+int FindSet(int *parent, int ix){
+	while(parent[ix] != ix){
+		parent[ix] = parent[parent[ix]];
+		ix = parent[ix];
+	}
+	return ix;
+}
+
+/**
+* Join the sets containing two elements (the smallest representative is kept)
+* @param "parent" [type int*]: parent of each element (roots point to themselves)
+* @param "a" [type int]: first element
+* @param "b" [type int]: second element
+*/
+void JoinSets(int *parent, int a, int b){
+	int root_a (FindSet(parent, a));
+	int root_b (FindSet(parent, b));
+	if(root_a < root_b) {
+		parent[root_b] = root_a;
+	} else if(root_b < root_a) {
+		parent[root_a] = root_b;
+	}
+}
+
 /**
 * Print per console or write to a given file the elements of an array of integers
 * @param "list" [type int*]: array of integers to be printed or written
@@ -230,30 +262,6 @@ int GetNumberOfSpecificElementInArray(int value, int* array, int list_size){
 	return num;
 }
 
-/**
-* Return a random value between min and max
-* @param "min" [type double]: minimum value to be provided
-* @param "max" [type double]: maximum value to be provided
-* @return "num" [type double]: random double number
-*/
-double RandomDouble(double min, double max)
-{
-    double f ((double)rand() / RAND_MAX);
-    return min + f * (max - min);
-}
-
-/**
-* Truncate a double value in order to avoid issues with long decimals
-* @param "number" [type double]: number to be truncated
-* @param "floating_position" [type int]: maximum precision of the truncate
-* @return "y" [type double]: truncated double number
-*/
-double TruncateDouble(double number, int floating_position){
-    double x (pow(10,floating_position) * number);
-    double y (x / pow(10,floating_position));
-    return y;
-}
-
 /**
 * Round a double to the specific amount of decimals
 * @param "value" [type double]: double value to be rounded
@@ -272,35 +280,4 @@ double RoundToDigits(double value, int digits)
     return rounded_value;
 }
 
-/**
-* Fix the time offset generated by long decimal values (allows keeping the synchronism of the simulation)
-* @param "time_value" [type double]: time value to be fixed
-* @param "trunc_pos" [type int]: maximum decimal number to be truncated
-* @param "round_pos" [type int]: maximum decimal position to be rounded
-* @return "fixed_time_value" [type double]: fixed time value
-*/
-double FixTimeOffset(double time_value, int trunc_pos, int round_pos){
-
-	double truncated_value (0);
-	double rounded_value (0);
-	double fixed_time_value (0);
-	// double diff = 0;
-	if (trunc_pos != 0) {
-		truncated_value = TruncateDouble(time_value, trunc_pos);
-		rounded_value = RoundToDigits(truncated_value,round_pos);
-		fixed_time_value = rounded_value;
-//		printf("---------------------------------\n");
-//		printf("- time_value = %.15f \n- truncated_value = %.15f \n- rounded_value = %.15f"
-//				"\n- diff = %.15f\n- fixed_time_value = %.15f\n",
-//				time_value, truncated_value, rounded_value, diff, fixed_time_value);
-	} else {
-		rounded_value = RoundToDigits(time_value,round_pos);
-		fixed_time_value = rounded_value;
-	}
-//	printf("---------------------------------\n");
-//	printf("- time_value = %.15f \n- truncated_value = %.15f -\n -diff = %.15f\n- fixed_time_value = %.15f\n",
-//			time_value, truncated_value, diff, fixed_time_value);
-	return fixed_time_value;
-}
-
 #endif
@@ -53,20 +53,17 @@
 #include <algorithm>
 #include <stddef.h>
 #include "../list_of_macros.h"
-
-// Exponential redefinition for convenience
-double	Random2( double v=1.0)	{ return v*drand48();}
-int		Random2( int v)		{ return (int)(v*drand48()); }
-double	Exponential2(double mean)	{ return -mean*log(Random2());}
+#include "../structures/random_stream.h"
 
 /**
 * Compute a new backoff value
 * @param "pdf_backoff" [type int]: type of backoff distribution (PDF_DETERMINISTIC or PDF_EXPONENTIAL)
 * @param "cw" [type int]: current contention window
 * @param "backoff_type" [type int]: type of backoff used (BACKOFF_SLOTTED or BACKOFF_CONTINUOUS) ---> BACKOFF_SLOTTED is highly recommended
+* @param "stream" [type RandomStream]: backoff random stream of the node
 * @return "backoff_time" [type double]: new generated backoff
 */
-double ComputeBackoff(int pdf_backoff, int cw, int backoff_type){
+double ComputeBackoff(int pdf_backoff, int cw, int backoff_type, RandomStream &stream){
 
 	double backoff_time;
 	double expected_backoff ((double) (cw-1)/2);	// [slots]
@@ -76,7 +73,7 @@ double ComputeBackoff(int pdf_backoff, int cw, int backoff_type){
 
 		case PDF_DETERMINISTIC:{
 			if(backoff_type == BACKOFF_SLOTTED) {
-				int num_slots (rand() % cw); // Num slots in [0, CW-1]
+				int num_slots (stream.Uniform(cw)); // Num slots in [0, CW-1]
 				backoff_time = num_slots * SLOT_TIME;
 				// printf("num_slots = %d\n", num_slots);
 			} else if(backoff_type == BACKOFF_CONTINUOUS) {
@@ -87,9 +84,9 @@ double ComputeBackoff(int pdf_backoff, int cw, int backoff_type){
 
 		case PDF_EXPONENTIAL:{
 			if(backoff_type == BACKOFF_SLOTTED) {
-				backoff_time = round(Exponential2(expected_backoff)) * SLOT_TIME;
+				backoff_time = round(stream.Exponential(expected_backoff)) * SLOT_TIME;
 			} else if(backoff_type == BACKOFF_CONTINUOUS) {
-				backoff_time = Exponential2(1/lambda_backoff);
+				backoff_time = stream.Exponential(1/lambda_backoff);
 			}
 			break;
 		}
@@ -55,6 +55,7 @@
 #include <stddef.h>
 
 #include "../list_of_macros.h"
+#include "power_conversion_methods.h"
 
 /**
 * Select the proper MCS per each number of channels based on the power received from transmitter
@@ -63,7 +64,7 @@
 */
 void SelectMCSResponse(int *mcs_response, double power_rx_interest) {
 
-	double pw_rx_intereset_dbm (ConvertPower(PW_TO_DBM, power_rx_interest));
+	double pw_rx_intereset_dbm (PwToDbm(power_rx_interest));
 
 	for ( int ch_num_ix = 0; ch_num_ix < 4; ++ ch_num_ix ){	// For 1, 2, 4 and 8 channels
 
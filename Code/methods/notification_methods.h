@@ -53,6 +53,7 @@
 #include <algorithm>
 #include <stddef.h>
 #include "../list_of_macros.h"
+#include "../structures/random_stream.h"
 
 /**
 * Generates a logical NACK
@@ -93,13 +94,10 @@ LogicalNack GenerateLogicalNack(int packet_type, int packet_id, int node_id,
 * @param "save_node_logs" [type int]: variable to indicate whether to save node logs or not
 * @param "sim_time" [type double]: current simulation time
 * @param "nacks_received" [type int*]: list containing the number of NACKs received for each time of loss reason
-* @param "total_nodes_number" [type int]: total number of nodes in the network
-* @param "nodes_transmitting" [type int*]: list of nodes transmitting
 * @return "reason" [type int]: potential reason for the packet loss
 */
 int ProcessNack(LogicalNack logical_nack, int node_id, Logger node_logger, int node_state,
-		int save_node_logs,	double sim_time, int *nacks_received,
-		int total_nodes_number, int *nodes_transmitting) {
+		int save_node_logs,	double sim_time, int *nacks_received) {
 
 	int reason (PACKET_NOT_LOST);
 
@@ -335,11 +333,12 @@ void handlePacketLoss(int type, double *total_time_lost_in_num_channels, double
 * @param "node_id" [type int]: node id
 * @param "packet_type" [type int]: type of packet being decoded
 * @param "destination_id" [type int]: destination id
+* @param "stream" [type RandomStream]: packet loss random stream of the receiver
 * @return "packet_lost" [type int]: boolean indicating whether the packet can be decoded or not
 */
 int AttemptToDecodePacket(double sinr, double capture_effect, double pd,
 		double power_rx_interest, double constant_per, int node_id, int packet_type,
-		int destination_id){
+		int destination_id, RandomStream &stream){
 
 	int packet_lost;
 	double per (0);
@@ -354,7 +353,7 @@ int AttemptToDecodePacket(double sinr, double capture_effect, double pd,
 		}
 	}
 
-	packet_lost = ((double) rand() / (RAND_MAX)) < per;
+	packet_lost = stream.Uniform() < per;
 
 	return packet_lost;
 }
@@ -371,11 +370,12 @@ int AttemptToDecodePacket(double sinr, double capture_effect, double pd,
 * @param "constant_per" [type int]: constant packet error rate (PER)
 * @param "node_id" [type int]: node id
 * @param "capture_effect_model" [type int]: capture effect model
+* @param "stream" [type RandomStream]: packet loss random stream of the receiver
 * @return "loss_reason" [type int]: loss reason
 */
-int IsPacketLost(int primary_channel, Notification incoming_notification, Notification new_notification,
+int IsPacketLost(int primary_channel, const Notification &incoming_notification, const Notification &new_notification,
 		double sinr, double capture_effect, double pd, double power_rx_interest, double constant_per,
-		int node_id, int capture_effect_model){
+		int node_id, int capture_effect_model, RandomStream &stream){
 
 	int loss_reason (PACKET_NOT_LOST);
 	int is_packet_lost;	// Determines if the current notification has been lost (1) or not (0)
@@ -394,7 +394,7 @@ int IsPacketLost(int primary_channel, Notification incoming_notification, Notifi
 
 				// Attempt to decode (or continue decoding) the notification of interest
 				is_packet_lost = AttemptToDecodePacket(sinr, capture_effect, pd, power_rx_interest, constant_per, node_id,
-					new_notification.packet_type, new_notification.destination_id);
+					new_notification.packet_type, new_notification.destination_id, stream);
 
 				if (is_packet_lost) {	// Incoming packet is lost
 					if (power_rx_interest < pd) {	// Signal strength is not enough (< pd) to be decoded
@@ -429,7 +429,7 @@ void GenerateScriptOutput(int simulation_index, Performance *performance_report,
                                 // Array to store all details of STA
                                 char sta_details[250] = "";
                                 // RSSI received from the AP
-                                sprintf(aux_rssi_per_device, "%.2f", ConvertPower(PW_TO_DBM, performance_report[counter_nodes_visited].received_power_array[i]));
+                                sprintf(aux_rssi_per_device, "%.2f", ConvertPower(PW_TO_DBM, performance_report[counter_nodes_visited].links.ReceivedPower(i)));
                                 strcat(rssi_per_device, aux_rssi_per_device);
                                 strcat(sta_details, aux_rssi_per_device);
                                 strcat(sta_details, ";");
@@ -624,7 +624,7 @@ void GenerateScriptOutput(int simulation_index, Performance *performance_report,
 								strcat(sta_details, ";");
 								// RSSI received from the AP
 								sprintf(aux_rssi_per_device, "%.2f", ConvertPower(PW_TO_DBM,
-									performance_report[counter_nodes_visited].received_power_array[i]));
+									performance_report[counter_nodes_visited].links.ReceivedPower(i)));
 								strcat(rssi_per_device, aux_rssi_per_device);
 								strcat(sta_details, aux_rssi_per_device);
 								strcat(sta_details, ";");
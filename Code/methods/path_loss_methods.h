@@ -0,0 +1,395 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+
+ /**
+ * path_loss_methods.h: this file contains functions related to the main Komondor's operation
+ *
+ * - This file contains the path loss models, as policy classes. Each one computes its terms that only
+ *   depend on the central frequency (wavelength, gains, frequency terms) once, in Initialize().
+ * - PathLossKernel is the link budget kernel of a model and a frequency: it is created once per
+ *   frequency from the model of the configuration (CreatePathLossKernel), and its row method computes
+ *   the power received from a set of transmitters with the model inlined (a single dispatch per row).
+ * - The models with random losses take them from the shadowing field (the losses of each link are
+ *   fixed per seed), so computing the power received never draws random numbers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../list_of_macros.h"
+#include "../structures/shadowing_field.h"
+#include "power_conversion_methods.h"
+
+#ifndef _PATH_LOSS_METHODS_
+#define _PATH_LOSS_METHODS_
+
+// Free space - Calculator: https://www.pasternack.com/t-calculator-fspl.aspx (UNITS ARE NOT IN SI!)
+struct PathLossFreeSpace
+{
+	double gain_at_1m;	///> Antenna gains times (wavelength / 4 pi)^2: power received at 1 m per unit of power
+
+	void Initialize(double central_frequency){
+		double wavelength_over_4pi ((double) SPEED_LIGHT / (4 * M_PI * central_frequency));
+		gain_at_1m = ExactDbToLinear(ANTENNA_TX_GAIN_DB) * ExactDbToLinear(ANTENNA_RX_GAIN_DB)
+			* wavelength_over_4pi * wavelength_over_4pi;
+	}
+
+	double PowerReceived(double distance, double tx_power, const LinkShadowing &) const {
+		return tx_power * gain_at_1m / (distance * distance);
+	}
+};
+
+// Okumura-Hata model - Urban areas (transmitter and receiver 10 m high)
+struct PathLossOkumuraHata
+{
+	double loss_at_1km;	///> A - E terms of the model (frequency and heights) [dB]
+	double path_loss_B;	///> B term of the model: loss per decade of distance [dB]
+
+	void Initialize(double central_frequency){
+		double wavelength ((double) SPEED_LIGHT / central_frequency);
+		double tx_heigth (10);    // Transmitter height [m]
+		double rx_heigth (10);    // Receiver height [m]
+		double path_loss_A (69.55 + 26.16 * log10(3*pow(10,8)/wavelength) - 13.82 * log10(tx_heigth));
+		double path_loss_E (3.2 * pow(log10(11.7554 * rx_heigth),2) - 4.97);
+		loss_at_1km = path_loss_A - path_loss_E;
+		path_loss_B = 44.9 - 6.55 * log10(tx_heigth);
+	}
+
+	double PowerReceived(double distance, double tx_power, const LinkShadowing &) const {
+		double path_loss (loss_at_1km + path_loss_B * log10(distance/1000));
+		return DbmToPw(PwToDbm(tx_power) + ANTENNA_TX_GAIN_DB + ANTENNA_RX_GAIN_DB - path_loss);
+	}
+};
+
+// Indoor model (could suite an apartments building scenario): random shadowing [0, 9.5) dB and obstacles [0, 30) dB per wall
+struct PathLossIndoor
+{
+	void Initialize(double){}
+
+	double PowerReceived(double distance, double tx_power, const LinkShadowing &shadowing) const {
+		double path_loss_factor (5);
+		double walls_frequency (5); //  One wall each 5 meters on average
+		double alpha (4.4); // Propagation model
+		double shadowing_at_wlan (9.5 * shadowing.shadowing);
+		double obstacles_at_wlan (30 * shadowing.obstacles);
+		double path_loss (path_loss_factor + 10*alpha*log10(distance) + shadowing_at_wlan +
+		  (distance/walls_frequency)*obstacles_at_wlan);
+		return DbmToPw(PwToDbm(tx_power) + ANTENNA_TX_GAIN_DB - path_loss);
+	}
+};
+
+// Indoor model without variability (the shadowing and obstacles terms are 1/2 * x in integer arithmetic, i.e., 0)
+struct PathLossIndoor2
+{
+	void Initialize(double){}
+
+	double PowerReceived(double distance, double tx_power, const LinkShadowing &) const {
+		double path_loss_factor (5);
+		double alpha (4.4); // Propagation model
+		double path_loss (path_loss_factor + 10*alpha*log10(distance));
+		return DbmToPw(PwToDbm(tx_power) + ANTENNA_TX_GAIN_DB - path_loss);
+	}
+};
+
+// Residential - 5 dB/wall and 18.3 dB per floor, and 4 dB shadow
+// Retrieved from: https://mentor.ieee.org/802.11/dcn/14/11-14-0882-04-00ax-tgax-channel-model-document.docx
+// IEEE 802.11ax uses the TGn channel B path loss model for performance evaluation of simulation scenario #1
+// with extra indoor wall and floor penetration loss.
+struct PathLossScenario1TGax
+{
+	double frequency_loss;	///> 40.05 + 20 log10(fc/2.4) [dB]
+
+	void Initialize(double central_frequency){
+		double central_frequency_ghz(central_frequency / pow(10,9));
+		frequency_loss = 40.05 + 20*log10(central_frequency_ghz/2.4);
+	}
+
+	double PowerReceived(double distance, double tx_power, const LinkShadowing &) const {
+		int n_walls(10);   // Wall frequency (n_walls walls each m)
+		int n_floors(3);   // Floor frequency (n_floors floors each m)
+		int L_iw(5);     // Penetration for a single wall (dB)
+		double d_BP (5);    // Break-point distance (m)
+		double min_d((distance > 5) ? 5 : distance);
+		double LFS (frequency_loss + 20*log10(min_d) +
+			  18.3*pow((distance/n_floors),(((distance/n_floors)+2)/((distance/n_floors)+1))
+					  - 0.46) + L_iw*(distance/n_walls));
+		double loss ((distance >= d_BP) ? LFS + 35*log10(distance/double(5)) : LFS);
+		return DbmToPw(PwToDbm(tx_power) + ANTENNA_TX_GAIN_DB + ANTENNA_RX_GAIN_DB - loss);
+	}
+};
+
+// Enterprise - 5 dB/wall and 18.3 dB per floor, and 4 dB shadow
+// Retrieved from: https://mentor.ieee.org/802.11/dcn/14/11-14-0882-04-00ax-tgax-channel-model-document.docx
+// IEEE 802.11ax uses the TGn channel D path loss model for performance evaluation of simulation scenario #2
+// with extra indoor wall and floor penetration loss (the walls term is 7 * d * (12/20), i.e., 0 in
+// integer arithmetic). Shadowing: uniform in [0, 5) dB per link.
+//	  PL(d) = 40.05 + 20*log10(fc/2.4) + 20*log10(min(d,10)) + (d>10) * 35*log10(d/10) + 7*W
+//	  W = number of office walls traversed in x-direction plus number of office walls traversed in y-direction
+struct PathLossScenario2TGax
+{
+	double frequency_loss;	///> 40.05 + 20 log10(fc/2.4) [dB]
+
+	void Initialize(double central_frequency){
+		double central_frequency_ghz(central_frequency / pow(10,9));
+		frequency_loss = 40.05 + 20*log10(central_frequency_ghz/2.4);
+	}
+
+	double PowerReceived(double distance, double tx_power, const LinkShadowing &shadowing) const {
+		int d_BP (1);    // Break-point distance (m)
+		double min_d((distance > 10) ? 1 : distance);
+		double shadowing_at_wlan (5 * shadowing.shadowing);
+		double LFS (frequency_loss + 20*log10(min_d) + shadowing_at_wlan);
+		double loss ((distance >= d_BP) ? LFS + 35*log10(distance/10) : LFS);
+		return DbmToPw(PwToDbm(tx_power) + ANTENNA_TX_GAIN_DB + ANTENNA_RX_GAIN_DB - loss);
+	}
+};
+
+// Indoor small BSSs
+// Retrieved from: https://mentor.ieee.org/802.11/dcn/14/11-14-0882-04-00ax-tgax-channel-model-document.docx
+// IEEE 802.11ax uses the TGn channel D path loss model for performance evaluation
+// of simulation scenario #3.
+struct PathLossScenario3TGax
+{
+	double frequency_loss;	///> 32.4 + 20 log10(2400) [dB]
+
+	void Initialize(double){
+		frequency_loss = 32.4 + 20*log10(2.4*pow(10,3));
+	}
+
+	double PowerReceived(double distance, double tx_power, const LinkShadowing &) const {
+		int d_BP (10);    // Break-point distance (m)
+		double LFS (frequency_loss + 20*log10(distance/1000));
+		double loss ((distance >= d_BP) ? LFS + 35*log10(distance/d_BP) : LFS);
+		return DbmToPw(PwToDbm(tx_power) + ANTENNA_TX_GAIN_DB + ANTENNA_RX_GAIN_DB - loss);
+	}
+};
+
+// Outdoor large BSS scenario (AP 10 m high, STA 1.5 m high)
+// Retrieved from: https://mentor.ieee.org/802.11/dcn/14/11-14-0882-04-00ax-tgax-channel-model-document.docx
+struct PathLossScenario4TGax
+{
+	double d_BP;				///> Break-point distance [m]
+	double loss_below_d_BP;		///> 28 + 20 log10(fc in GHz) [dB]
+	double loss_above_d_BP;		///> 7.8 + 18 log10(h_AP - 1) - 18 log10(h_STA - 1) + 20 log10(fc in GHz) [dB]
+
+	void Initialize(double central_frequency){
+		double h_AP (10);    // Height of the AP in m
+		double h_STA (1.5);   // Height of the STA in m
+		d_BP = (4 * (h_AP - 1) * (h_STA - 1) * central_frequency) / SPEED_LIGHT;
+		loss_below_d_BP = 28 + 20 * log10(central_frequency * pow(10,-9));
+		loss_above_d_BP = 7.8 + 18 * log10(h_AP - 1) - 18 * log10(h_STA - 1) + 20 * log10(central_frequency * pow(10,-9));
+	}
+
+	double PowerReceived(double distance, double tx_power, const LinkShadowing &) const {
+		// Out of the ranges of the model (closer than 10 m or farther than 5 km) no loss is applied
+		double loss (0);
+		if (distance < d_BP && distance >= 10) {
+			loss = 22 * log10(distance) + loss_below_d_BP;
+		} else if (distance >= d_BP && distance < 5000) {
+			loss = 40 * log10(distance) + loss_above_d_BP;
+		}
+		return DbmToPw(PwToDbm(tx_power) + ANTENNA_TX_GAIN_DB - loss);
+	}
+};
+
+// Outdoor large BSS scenario + Residential
+// Retrieved from: https://mentor.ieee.org/802.11/dcn/14/11-14-0882-04-00ax-tgax-channel-model-document.docx
+// TODO: important to consider specifying d_outdoor and d_indoor (both 0 for now, so the outdoor loss is
+// multiplied by 0 and only the building penetration loss remains)
+struct PathLossScenario4aTGax
+{
+	double loss;	///> Outdoor-to-Indoor building penetration loss [dB]
+
+	void Initialize(double){
+		double d_indoor (0);
+		loss = 20 + 0.5 * d_indoor;
+	}
+
+	double PowerReceived(double, double tx_power, const LinkShadowing &) const {
+		return DbmToPw(PwToDbm(tx_power) + ANTENNA_TX_GAIN_DB - loss);
+	}
+};
+
+/*
+ * Medbo, J., & Berg, J. E. (2000). Simple and accurate path loss modeling at 5 GHz in indoor environments
+ * with corridors. In Vehicular Technology Conference, 2000. IEEE-VTS Fall VTC 2000. 52nd (Vol. 1, pp. 30-36). IEEE.
+ * pl_overall = pl_free_space(d) + alpha * d
+ */
+struct PathLoss5GhzOfficeBuilding
+{
+	double frequency_loss;	///> Free space loss at 1 m minus the antenna gains [dB]
+
+	void Initialize(double central_frequency){
+		frequency_loss = 20 * log10(central_frequency) + 20 * log10((4*M_PI)/((double) SPEED_LIGHT)) -
+			ANTENNA_RX_GAIN_DB - ANTENNA_TX_GAIN_DB;
+	}
+
+	double PowerReceived(double distance, double tx_power, const LinkShadowing &) const {
+		double alpha (0.44);		// Constant attenuation per unit of path length [dB/m]
+		double pl_overall_db (20 * log10(distance) + frequency_loss + alpha * distance);
+		return DbmToPw(PwToDbm(tx_power) - pl_overall_db);
+	}
+};
+
+/*
+ * Xu et al. Indoor Office Propagation Measurements and Path Loss Models at 5.25 GHz“, IEEE VTC 2007.
+ * one-slope log-distance model in in-room LoS condition
+ */
+struct PathLossInroom5250Khz
+{
+	void Initialize(double){}
+
+	double PowerReceived(double distance, double tx_power, const LinkShadowing &) const {
+		double pl_overall_db (47.8 + 14.8 * log10(distance));		// Overall path loss
+		return DbmToPw(PwToDbm(tx_power) - pl_overall_db);
+	}
+};
+
+/*
+ * Xu et al. Indoor Office Propagation Measurements and Path Loss Models at 5.25 GHz“, IEEE VTC 2007.
+ * dual-slope log-distance model in room-corridor condition
+ */
+struct PathLossRoomCorridor5250Khz
+{
+	void Initialize(double){}
+
+	double PowerReceived(double distance, double tx_power, const LinkShadowing &) const {
+		double pl_overall_db ((distance <= 9) ? 53.2 + 25.8 * log10(distance) : 56.4 + 29.1 * log10(distance));
+		return DbmToPw(PwToDbm(tx_power) - pl_overall_db);
+	}
+};
+
+/*
+ * Adame, T., Carrascosa, M., & Bellalta, B. (2019, April). The TMB path loss model for 5 GHz indoor WiFi scenarios:
+ * On the empirical relationship between RSSI, MCS, and spatial streams. In 2019 Wireless Days (WD) (pp. 1-8). IEEE.
+ */
+struct PathLossTmb
+{
+	void Initialize(double){}
+
+	double PowerReceived(double distance, double tx_power, const LinkShadowing &) const {
+		double pl_overall_db (54.12 + 10 * 2.06067 * log10(distance) + 5.25 * 0.1467 * distance);
+		return DbmToPw(PwToDbm(tx_power) - pl_overall_db);
+	}
+};
+
+/*
+	Link budget kernel of a path loss model at a given central frequency
+*/
+struct PathLossKernel
+{
+	virtual ~PathLossKernel() {}
+
+	/**
+	* Compute the power received in a given distance from the transmitter
+	* @param "distance" [type double]: distance in meters
+	* @param "tx_power" [type double]: transmission power used [pW]
+	* @param "shadowing" [type LinkShadowing]: random losses of the link (models with random losses)
+	* @return "pw_received" [type double]: power received in pW
+	*/
+	virtual double PowerReceived(double distance, double tx_power, const LinkShadowing &shadowing) const = 0;
+
+	/**
+	* Compute the power received from a set of transmitters (e.g., the links of a node)
+	* @param "distance" [type double*]: distance to each transmitter in meters
+	* @param "tx_power" [type double*]: transmission power used by each transmitter [pW]
+	* @param "shadowing" [type LinkShadowing*]: random losses of the link with each transmitter
+	* @param "size" [type int]: number of transmitters
+	* @param "pw_received" [type double*]: power received from each transmitter in pW (to be filled by this method)
+	*/
+	virtual void PowerReceivedRow(const double *distance, const double *tx_power, const LinkShadowing *shadowing,
+		int size, double *pw_received) const = 0;
+};
+
+template <class PathLoss>
+struct PathLossKernelOf : PathLossKernel
+{
+	PathLoss model;	///> Path loss model, with the terms of the central frequency computed
+
+	PathLossKernelOf(double central_frequency){
+		model.Initialize(central_frequency);
+	}
+
+	double PowerReceived(double distance, double tx_power, const LinkShadowing &shadowing) const {
+		return model.PowerReceived(distance, tx_power, shadowing);
+	}
+
+	void PowerReceivedRow(const double *distance, const double *tx_power, const LinkShadowing *shadowing,
+		int size, double *pw_received) const {
+		for(int i = 0; i < size; ++i) pw_received[i] = model.PowerReceived(distance[i], tx_power[i], shadowing[i]);
+	}
+};
+
+/**
+* Create the link budget kernel of a path loss model
+* @param "path_loss_model" [type int]: path-loss model used
+* @param "central_frequency" [type double]: central frequency
+* @return "kernel" [type PathLossKernel*]: kernel of the model at the frequency
+*/
+PathLossKernel *CreatePathLossKernel(int path_loss_model, double central_frequency){
+	switch(path_loss_model){
+		case PATH_LOSS_LFS: return new PathLossKernelOf<PathLossFreeSpace>(central_frequency);
+		case PATH_LOSS_OKUMURA_HATA: return new PathLossKernelOf<PathLossOkumuraHata>(central_frequency);
+		case PATH_LOSS_INDOOR: return new PathLossKernelOf<PathLossIndoor>(central_frequency);
+		case PATH_LOSS_INDOOR_2: return new PathLossKernelOf<PathLossIndoor2>(central_frequency);
+		case PATH_LOSS_SCENARIO_1_TGax: return new PathLossKernelOf<PathLossScenario1TGax>(central_frequency);
+		case PATH_LOSS_SCENARIO_2_TGax: return new PathLossKernelOf<PathLossScenario2TGax>(central_frequency);
+		case PATH_LOSS_SCENARIO_3_TGax: return new PathLossKernelOf<PathLossScenario3TGax>(central_frequency);
+		case PATH_LOSS_SCENARIO_4_TGax: return new PathLossKernelOf<PathLossScenario4TGax>(central_frequency);
+		case PATH_LOSS_SCENARIO_4a_TGax: return new PathLossKernelOf<PathLossScenario4aTGax>(central_frequency);
+		case PATHLOSS_5GHZ_OFFICE_BUILDING: return new PathLossKernelOf<PathLoss5GhzOfficeBuilding>(central_frequency);
+		case PATHLOSS_INROOM_LOSS_5250KHZ: return new PathLossKernelOf<PathLossInroom5250Khz>(central_frequency);
+		case PATHLOSS_ROOM_CORRIDOR_5250KHZ: return new PathLossKernelOf<PathLossRoomCorridor5250Khz>(central_frequency);
+		case PATHLOSS_TMB: return new PathLossKernelOf<PathLossTmb>(central_frequency);
+		default:{
+			printf("ERROR: Path loss model %d not found!\n", path_loss_model);
+			exit(-1);
+		}
+	}
+}
+
+#endif
@@ -52,10 +52,17 @@
 #include <stddef.h>
 #include <math.h>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 
 #include "../list_of_macros.h"
 #include "../structures/modulations.h"
+#include "../structures/random_stream.h"
+#include "../structures/link_budget.h"
+#include "../structures/active_transmitters.h"
 #include "auxiliary_methods.h"
+#include "power_conversion_methods.h"
+#include "path_loss_methods.h"
 
 #ifndef _POWER_METHODS_
 #define _POWER_METHODS_
@@ -73,30 +80,30 @@ double ConvertPower(int conversion_type, double power_magnitude_in){
   switch(conversion_type){
     // pW to dBm
     case PW_TO_DBM:{
-      converted_power = 10 * log10(power_magnitude_in * pow(10,-9));
+      converted_power = ExactPwToDbm(power_magnitude_in);
       break;
     }
     // dBm to pW
     case DBM_TO_PW:{
-      converted_power = pow(10,(power_magnitude_in + 90)/10);
+      converted_power = ExactDbmToPw(power_magnitude_in);
       break;
     }
     // mW to dBm
     case MW_TO_DBM:{
-      converted_power = 10 * log10(power_magnitude_in * pow(10,-6));
+      converted_power = 10 * log10(power_magnitude_in * 1e-6);
       break;
     }
     // dBm to mW (dB to linear)
     case DBM_TO_MW:
     case DB_TO_LINEAR:
     case DBW_TO_W: {
-      converted_power = pow(10,power_magnitude_in/10);
+      converted_power = ExactDbToLinear(power_magnitude_in);
       break;
     }
     // W to dBW
     case W_TO_DBW:
     case LINEAR_TO_DB: {
-      converted_power = 10 * log10(power_magnitude_in);
+      converted_power = ExactLinearToDb(power_magnitude_in);
       break;
     }
     default:{
@@ -118,257 +125,10 @@ double ConvertPower(int conversion_type, double power_magnitude_in){
 * @return "distance" [type double]: distance in meters
 */
 double ComputeDistance(double x1, double y1, double z1, double x2, double y2, double z2){
-  double distance (sqrt(pow(x1 - x2, 2) + pow(y1 - y2, 2) + pow(z1 - z2, 2)));
+  double distance (sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2) + (z1 - z2) * (z1 - z2)));
   return distance;
 }
 
-/**
-* Compute the power received in a given distance from the transmitter depending on the path loss model
-* @param "distance" [type double]: distance in meters
-* @param "tx_power" [type double]: transmission power used
-* @param "central_frequency" [type double]: central frequency
-* @param "path_loss_model" [type int]: path-loss model used
-* @return "pw_received" [type double]: power received in pW
-*/
-double ComputePowerReceived(double distance, double tx_power, double central_frequency, int path_loss_model) {
-
-//	printf("    - distance = %f\n", distance);
-//	printf("    - tx_power = %f\n", ConvertPower(PW_TO_DBM,tx_power));
-//	printf("    - central_frequency = %f\n", central_frequency);
-//	printf("    - path_loss_model = %d\n", path_loss_model);
-
-	double tx_power_dbm (ConvertPower(PW_TO_DBM, tx_power));
-	double tx_gain (ConvertPower(DB_TO_LINEAR, ANTENNA_TX_GAIN_DB));
-	double rx_gain (ConvertPower(DB_TO_LINEAR, ANTENNA_RX_GAIN_DB));
-	double pw_received_dbm;
-	double wavelength ((double) SPEED_LIGHT/central_frequency);
-	double loss;
-
-	double pw_received;	// Power received [pW]
-
-	switch(path_loss_model){
-		// Free space - Calculator: https://www.pasternack.com/t-calculator-fspl.aspx (UNITS ARE NOT IN SI!)
-		case PATH_LOSS_LFS:{
-			pw_received = tx_power * tx_gain * rx_gain * pow(((double) SPEED_LIGHT/(4*M_PI*distance*central_frequency)),2);
-			break;
-		}
-		// Okumura-Hata model - Urban areas
-		case PATH_LOSS_OKUMURA_HATA:{
-			double tx_heigth (10);    // Transmitter height [m]
-			double rx_heigth (10);    // Receiver height [m]
-			double path_loss_A (69.55 + 26.16 * log10(3*pow(10,8)/wavelength) - 13.82 * log10(tx_heigth));
-			double path_loss_B (44.9 - 6.55 * log10(tx_heigth));
-			double path_loss_E (3.2 * pow(log10(11.7554 * rx_heigth),2) - 4.97);
-			double path_loss (path_loss_A + path_loss_B * log10(distance/1000) - path_loss_E);
-			pw_received_dbm = tx_power_dbm + ANTENNA_TX_GAIN_DB + ANTENNA_RX_GAIN_DB - path_loss;
-			pw_received = ConvertPower(DBM_TO_PW, pw_received_dbm);
-			break;
-		}
-		// Indoor model (could suite an apartments building scenario)
-		case PATH_LOSS_INDOOR: {
-			double path_loss_factor (5);
-			double shadowing (9.5);
-			double obstacles (30);
-			double walls_frequency (5); //  One wall each 5 meters on average
-			double shadowing_at_wlan ((((double) rand())/RAND_MAX)*shadowing);
-			double obstacles_at_wlan ((((double) rand())/RAND_MAX)*obstacles);
-			double alpha (4.4); // Propagation model
-			double path_loss (path_loss_factor + 10*alpha*log10(distance) + shadowing_at_wlan +
-			  (distance/walls_frequency)*obstacles_at_wlan);
-			pw_received_dbm = tx_power_dbm + ANTENNA_TX_GAIN_DB - path_loss; // Power in dBm
-			pw_received = ConvertPower(DBM_TO_PW, pw_received_dbm);
-			break;
-		}
-		// Indoor model without variability
-		case PATH_LOSS_INDOOR_2: {
-			double path_loss_factor (5);
-			double shadowing (9.5);
-			double obstacles (30);
-			double walls_frequency (5); //  One wall each 5 meters on average
-			double shadowing_at_wlan (1/2*shadowing);
-			double obstacles_at_wlan (1/2*obstacles);
-			double alpha (4.4); // Propagation model
-			double path_loss (path_loss_factor + 10*alpha*log10(distance) + shadowing_at_wlan +
-			  (distance/walls_frequency)*obstacles_at_wlan);
-			pw_received_dbm = tx_power_dbm + ANTENNA_TX_GAIN_DB - path_loss; // Power in dBm
-			pw_received = ConvertPower(DBM_TO_PW, pw_received_dbm);
-			break;
-		}
-
-		// Residential - 5 dB/wall and 18.3 dB per floor, and 4 dB shadow
-		// Retrieved from: https://mentor.ieee.org/802.11/dcn/14/11-14-0882-04-00ax-tgax-channel-model-document.docx
-		// IEEE 802.11ax uses the TGn channel B path loss model for performance evaluation of simulation scenario #1
-		// with extra indoor wall and floor penetration loss.
-		case PATH_LOSS_SCENARIO_1_TGax: {
-			int n_walls(10);   // Wall frequency (n_walls walls each m)
-			int n_floors(3);   // Floor frequency (n_floors floors each m)
-			int L_iw(5);     // Penetration for a single wall (dB)
-			double min_d(distance);
-			if (distance > 5) { min_d = 5; }
-			double central_frequency_ghz(central_frequency / pow(10,9));
-			double LFS (40.05 + 20*log10(central_frequency_ghz/2.4) + 20*log10(min_d) +
-				  18.3*pow((distance/n_floors),(((distance/n_floors)+2)/((distance/n_floors)+1))
-						  - 0.46) + L_iw*(distance/n_walls));
-			double d_BP (5);    // Break-point distance (m)
-			if (distance >= d_BP) {
-			loss = LFS + 35*log10(distance/double(5));
-			} else {
-			loss = LFS;
-			}
-			pw_received_dbm = tx_power_dbm + ANTENNA_TX_GAIN_DB + ANTENNA_RX_GAIN_DB - loss;
-			pw_received = ConvertPower(DBM_TO_PW, pw_received_dbm);
-			break;
-		}
-
-		// Enterprise - 5 dB/wall and 18.3 dB per floor, and 4 dB shadow
-		// Retrieved from: https://mentor.ieee.org/802.11/dcn/14/11-14-0882-04-00ax-tgax-channel-model-document.docx
-		// IEEE 802.11ax uses the TGn channel D path loss model for performance evaluation of simulation scenario #2
-		// with extra indoor wall and floor penetration loss.
-		case PATH_LOSS_SCENARIO_2_TGax: {
-			int f_walls(12/20);   // Wall frequency (n_walls walls each m)
-			double min_d(distance);
-			if (distance > 10) { min_d = 1; }
-			double central_frequency_ghz(central_frequency / pow(10,9));
-			double shadowing (5);
-			double shadowing_at_wlan ((((double) rand())/RAND_MAX)*shadowing);
-			double LFS (40.05 + 20*log10(central_frequency_ghz/2.4) + 20*log10(min_d)
-				+ 7*(distance*f_walls) + shadowing_at_wlan);
-			int d_BP (1);    // Break-point distance (m)
-			if (distance >= d_BP) {
-				loss = LFS + 35*log10(distance/10);
-			} else {
-				loss = LFS;
-			}
-			pw_received_dbm = tx_power_dbm + ANTENNA_TX_GAIN_DB + ANTENNA_RX_GAIN_DB - loss;
-			pw_received = ConvertPower(DBM_TO_PW, pw_received_dbm);
-			//	  Shadowing: Log-normal with 5 dB standard deviation, iid across all links
-			break;
-	//	  PL(d) = 40.05 + 20*log10(fc/2.4) + 20*log10(min(d,10)) + (d>10) * 35*log10(d/10) + 7*W
-	//	  W = number of office walls traversed in x-direction plus number of office walls traversed in y-direction
-	//	  use MCS0 or MCS7 for all transmissions
-	//	  APs have 4 rx and tx antennas
-		}
-
-		// Indoor small BSSs
-		// Retrieved from: https://mentor.ieee.org/802.11/dcn/14/11-14-0882-04-00ax-tgax-channel-model-document.docx
-		// IEEE 802.11ax uses the TGn channel D path loss model for performance evaluation
-		// of simulation scenario #3.
-		case PATH_LOSS_SCENARIO_3_TGax: {
-		  double LFS (32.4 + 20*log10(2.4*pow(10,3))+ 20*log10(distance/1000));
-		  int d_BP (10);    // Break-point distance (m)
-		  if (distance >= d_BP) {
-			loss = LFS + 35*log10(distance/d_BP);
-		  } else {
-			loss = LFS;
-		  }
-		  pw_received_dbm = tx_power_dbm + ANTENNA_TX_GAIN_DB + ANTENNA_RX_GAIN_DB - loss;
-		  pw_received = ConvertPower(DBM_TO_PW, pw_received_dbm);
-		  break;
-		}
-
-		// Outdoor large BSS scenario
-		// Retrieved from: https://mentor.ieee.org/802.11/dcn/14/11-14-0882-04-00ax-tgax-channel-model-document.docx
-		case PATH_LOSS_SCENARIO_4_TGax: {
-		  double h_AP (10);    // Height of the AP in m
-		  double h_STA (1.5);   // Height of the STA in m
-		  double d_BP ((4 * (h_AP - 1) * (h_STA - 1) * central_frequency) / SPEED_LIGHT);
-		  if (distance < d_BP && distance >= 10) {
-			loss = 22 * log10(distance) + 28 + 20  *log10(central_frequency * pow(10,-9));
-		  } else if (distance >= d_BP && distance < 5000) {
-			loss = 40 * log10(distance) + 7.8 + 18 * log10(h_AP - 1) -
-				18 * log10(h_STA - 1)  + 20 * log10(central_frequency * pow(10,-9));
-		  }
-		  pw_received_dbm = tx_power_dbm + ANTENNA_TX_GAIN_DB - loss; // Power in dBm
-		  pw_received = ConvertPower(DBM_TO_PW, pw_received_dbm);
-		  break;
-		}
-
-		// Outdoor large BSS scenario + Residential
-		// Retrieved from: https://mentor.ieee.org/802.11/dcn/14/11-14-0882-04-00ax-tgax-channel-model-document.docx
-		case PATH_LOSS_SCENARIO_4a_TGax: {
-		//      double h_AP = 10;    // Height of the AP in m
-		//      double h_STA = 1.5;   // Height of the STA in m
-		  if (distance < 2000 && distance >= 10) {
-			loss = 36.7 * log10(distance) + 22.7 + 26  * log10(central_frequency * pow(10,-9));
-		  }
-		  // Outdoor-to-Indoor building penetration loss
-		  // TODO: important to consider specifying d_outdoor and d_indoor
-		  double d_outdoor (0);
-		  double d_indoor (0);
-		  loss = loss * (d_outdoor + d_indoor) + 20 + 0.5 * d_indoor;
-		  pw_received_dbm = tx_power_dbm + ANTENNA_TX_GAIN_DB - loss; // Power in dBm
-		  pw_received = ConvertPower(DBM_TO_PW, pw_received_dbm);
-		  break;
-		}
-
-		/*
-		 * Medbo, J., & Berg, J. E. (2000). Simple and accurate path loss modeling at 5 GHz in indoor environments
-		 * with corridors. In Vehicular Technology Conference, 2000. IEEE-VTS Fall VTC 2000. 52nd (Vol. 1, pp. 30-36). IEEE.
-		 */
-		case PATHLOSS_5GHZ_OFFICE_BUILDING:{
-			// pl_overall = pl_free_space(d) + alpha * d
-			double pl_overall_db;		// Overall path loss
-			double pl_free_space_db;	// Pathloss free space
-			double alpha (0.44);		// Constant attenuation per unit of path length [dB/m]
-			pl_free_space_db = 20 * log10(distance) + 20 * log10(central_frequency) +
-					20 * log10((4*M_PI)/((double) SPEED_LIGHT)) -
-					ANTENNA_RX_GAIN_DB - ANTENNA_TX_GAIN_DB;
-			pl_overall_db = pl_free_space_db + alpha * distance;
-			double pw_received_dbm (ConvertPower(PW_TO_DBM, tx_power) - pl_overall_db);
-			pw_received = ConvertPower(DBM_TO_PW, pw_received_dbm);
-			break;
-		}
-
-		/*
-		 * Xu et al. Indoor Office Propagation Measurements and Path Loss Models at 5.25 GHz“, IEEE VTC 2007.
-		 * one-slope log-distance model in in-room LoS condition
-		 */
-		case PATHLOSS_INROOM_LOSS_5250KHZ:{
-			double pl_overall_db (47.8 + 14.8 * log10(distance));		// Overall path loss
-			double pw_received_dbm (ConvertPower(PW_TO_DBM, tx_power) - pl_overall_db);
-			pw_received = ConvertPower(DBM_TO_PW, pw_received_dbm);
-			break;
-		}
-
-		/*
-		 * Xu et al. Indoor Office Propagation Measurements and Path Loss Models at 5.25 GHz“, IEEE VTC 2007.
-		 * dual-slope log-distance model in room-corridor condition
-		 */
-		case PATHLOSS_ROOM_CORRIDOR_5250KHZ:{
-			double pl_overall_db;
-			if(distance <=  9){
-				pl_overall_db = 53.2 + 25.8 * log10(distance);		// Overall path loss
-			} else {
-				pl_overall_db = 56.4 + 29.1 * log10(distance);		// Overall path loss
-			}
-			double pw_received_dbm (ConvertPower(PW_TO_DBM, tx_power) - pl_overall_db);
-			pw_received = ConvertPower(DBM_TO_PW, pw_received_dbm);
-			break;
-		}
-
-		/*
-		 * Adame, T., Carrascosa, M., & Bellalta, B. (2019, April). The TMB path loss model for 5 GHz indoor WiFi scenarios:
-		 * On the empirical relationship between RSSI, MCS, and spatial streams. In 2019 Wireless Days (WD) (pp. 1-8). IEEE.
-		 */
-		case PATHLOSS_TMB:{
-			double pl_overall_db;
-			pl_overall_db = 54.12 + 10 * 2.06067 * log10(distance) + 5.25 * 0.1467 * distance;
-			double pw_received_dbm = ConvertPower(PW_TO_DBM, tx_power) - pl_overall_db;
-			pw_received = ConvertPower(DBM_TO_PW, pw_received_dbm);
-			break;
-		}
-
-		default:{
-		  printf("Path loss model not found!\n");
-		  break;
-		}
-
-	}
-
-	return pw_received;
-
-}
-
 /**
 * Compute power sent per channel
 * @param "current_tx_power" [type double]: transmission power used
@@ -442,15 +202,15 @@ void GetChannelOccupancyByCCA(int primary_channel, int pifs_activated, int *chan
 /**
 * Update the power sensed coming from each node in the primary channel (power of interest counted only if transmission implies the primary channel)
 * @param "primary_channel" [type int]: primary channel
-* @param "power_received_per_node" [type std::map<int,double>]: dynamic map providing the power received by each active node (to be updated by this method)
+* @param "power_received_per_node" [type ActiveTransmitters]: set of active nodes and the power received from each one (to be updated by this method)
 * @param "notification" [type Notification]: last detected notification
 * @param "central_frequency" [type double]: central frequency
 * @param "path_loss_model" [type int]: path-loss model used
 * @param "pw_received" [type double]: power received in pW
 * @param "start_or_finish" [type int]: indicated whether the transmission has started or finishes
 */
-void UpdatePowerSensedPerNode(int primary_channel, std::map<int,double> &power_received_per_node,
-	Notification notification, double central_frequency, int path_loss_model,
+void UpdatePowerSensedPerNode(int primary_channel, ActiveTransmitters &power_received_per_node,
+	const Notification &notification, double central_frequency, int path_loss_model,
 	double pw_received, int start_or_finish) {
 
 	if(primary_channel >= notification.left_channel && primary_channel <= notification.right_channel){
@@ -458,12 +218,12 @@ void UpdatePowerSensedPerNode(int primary_channel, std::map<int,double> &power_r
 		switch(start_or_finish){
 
 			case TX_INITIATED:{
-				power_received_per_node[notification.source_id] = pw_received;
+				power_received_per_node.Set(notification.source_id, pw_received);
 				break;
 			}
 
 			case TX_FINISHED:{
-				power_received_per_node.erase(notification.source_id);
+				power_received_per_node.Erase(notification.source_id);
 				break;
 			}
 
@@ -476,25 +236,40 @@ void UpdatePowerSensedPerNode(int primary_channel, std::map<int,double> &power_r
 
 	} else {
 
-		power_received_per_node.erase(notification.source_id);
+		power_received_per_node.Erase(notification.source_id);
 
 	}
 
 }
 
-void UpdateRssiPerSta(Wlan wlan, double *rssi_per_sta,
-		double *received_power_array, int total_nodes_number){
+void UpdateRssiPerSta(const Wlan &wlan, double *rssi_per_sta, const LinkBudgetView &links){
 
-	int id(0);
-	for (int i = 0; i < total_nodes_number; ++i) {
-		if (wlan.FindStaInList(i)){
-			rssi_per_sta[id] = received_power_array[i];
-			++id;
-		}
+	// STAs are visited in increasing identifier order
+	std::vector<int> stas (wlan.list_sta_id, wlan.list_sta_id + wlan.num_stas);
+	std::sort(stas.begin(), stas.end());
+	for (int id = 0; id < wlan.num_stas; ++id) {
+		rssi_per_sta[id] = links.ReceivedPower(stas[id]);
 	}
 
 }
 
+/**
+* Linear leakage of the adjacent channel interference: fraction of the power of a channel sensed at each
+* channel distance (ADJACENT_CHANNEL_LOSS_DB per channel). Computed once, before the simulation starts
+*/
+struct AdjacentChannelLeakage
+{
+	double coefficient[NUM_CHANNELS_KOMONDOR];	///> Fraction of the power sensed at each channel distance
+
+	AdjacentChannelLeakage(){
+		for(int k = 0; k < NUM_CHANNELS_KOMONDOR; ++k){
+			coefficient[k] = ConvertPower(DB_TO_LINEAR, - (double) ADJACENT_CHANNEL_LOSS_DB * k);
+		}
+	}
+};
+
+static const AdjacentChannelLeakage adjacent_channel_leakage;
+
 /**
 * Apply a co-channel interference model
 * @param "adjacent_channel_model" [type int]: adjacent channel model
@@ -505,16 +280,15 @@ void UpdateRssiPerSta(Wlan wlan, double *rssi_per_sta,
 * @param "path_loss_model" [type int]: path-loss model used
 */
 void ApplyAdjacentChannelInterferenceModel(int adjacent_channel_model, double total_power[],
-	Notification notification, double central_frequency, double pw_received, int path_loss_model){
+	const Notification &notification, double central_frequency, double pw_received, int path_loss_model){
+
+	const double *leakage (adjacent_channel_leakage.coefficient);
 
 	// Direct power (power of the channels used for transmitting)
 	for(int i = notification.left_channel; i <= notification.right_channel; ++i){
 		(total_power)[i] = pw_received;
 	}
 
-	double pw_loss_db;
-	double total_power_dbm;
-
 	// Co-channel interference power
 	switch(adjacent_channel_model){
 
@@ -525,33 +299,13 @@ void ApplyAdjacentChannelInterferenceModel(int adjacent_channel_model, double to
 
 		// (RECOMMENDED) Boundary co-channel interference: only boundary channels (left and right) used in the TX affect the rest of channels
 		case ADJACENT_CHANNEL_BOUNDARY:{
-			for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c) {
-
-				if(c < notification.left_channel || c > notification.right_channel){
-
-					if(c < notification.left_channel) {
-
-						pw_loss_db = 20 * abs(c-notification.left_channel);
-						total_power_dbm = ConvertPower(PW_TO_DBM, pw_received) - pw_loss_db;
-						(total_power)[c] = (total_power)[c] + ConvertPower(DBM_TO_PW, total_power_dbm);
-
-					} else if(c > notification.right_channel) {
-
-						pw_loss_db = 20 * abs(c-notification.right_channel);
-						total_power_dbm = ConvertPower(PW_TO_DBM, pw_received) - pw_loss_db;
-						(total_power)[c] = (total_power)[c] + ConvertPower(DBM_TO_PW, total_power_dbm);
-
-					}
-
-					if((total_power)[c] < MIN_VALUE_C_LANGUAGE){
-
-						(total_power)[c] = 0;
-
-					}
-
-				} else {
-					// Inside TX range --> do nothing
-				}
+			for(int c = 0; c < notification.left_channel; ++c) {
+				(total_power)[c] = (total_power)[c] + pw_received * leakage[notification.left_channel - c];
+				if((total_power)[c] < MIN_VALUE_C_LANGUAGE) (total_power)[c] = 0;
+			}
+			for(int c = notification.right_channel + 1; c < NUM_CHANNELS_KOMONDOR; ++c) {
+				(total_power)[c] = (total_power)[c] + pw_received * leakage[c - notification.right_channel];
+				if((total_power)[c] < MIN_VALUE_C_LANGUAGE) (total_power)[c] = 0;
 			}
 			break;
 		}
@@ -564,9 +318,7 @@ void ApplyAdjacentChannelInterferenceModel(int adjacent_channel_model, double to
 
 					if(c != j) {
 
-						pw_loss_db = 20 * abs(c-j);
-						total_power_dbm = ConvertPower(PW_TO_DBM, pw_received) - pw_loss_db;
-						(total_power)[c] = (total_power)[c] + ConvertPower(DBM_TO_PW, total_power_dbm);
+						(total_power)[c] = (total_power)[c] + pw_received * leakage[abs(c-j)];
 						if((total_power)[c] < MIN_DOUBLE_VALUE_KOMONDOR) (total_power)[c] = 0;
 
 					}
@@ -585,8 +337,10 @@ void ApplyAdjacentChannelInterferenceModel(int adjacent_channel_model, double to
 }
 
 /**
-* Update the aggregated power sensed by the node in every channel
+* Update the aggregated power sensed by the node in every channel. The rounding error of each update is
+* computed exactly (TwoSum) and kept, so the power does not drift as transmissions start and finish
 * @param "channel_power" [type double*]: array containing the power sensed per channel (to be updated by this method)
+* @param "channel_power_compensation" [type double*]: rounding errors of the updates per channel (to be updated by this method)
 * @param "notification" [type Notification]: last detected notification
 * @param "update_type" [type int]: type of update (TX_INITIATED or TX_FINISHED)
 * @param "central_frequency" [type double]: central frequency
@@ -595,7 +349,7 @@ void ApplyAdjacentChannelInterferenceModel(int adjacent_channel_model, double to
 * @param "pw_received" [type double]: power received in pW
 * @param "node_id" [type int]: identifier of the node
 */
-void UpdateChannelsPower(double **channel_power, Notification notification,
+void UpdateChannelsPower(double **channel_power, double *channel_power_compensation, const Notification &notification,
     int update_type, double central_frequency, int path_loss_model,
 	int adjacent_channel_model, double pw_received, int node_id){
 
@@ -606,28 +360,43 @@ void UpdateChannelsPower(double **channel_power, Notification notification,
 	ApplyAdjacentChannelInterferenceModel(adjacent_channel_model, total_power,
 		notification, central_frequency, pw_received, path_loss_model);
 
-	// Increase/decrease power sensed if TX started/finished
-	for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
-
-		switch(update_type){
-
-			case TX_FINISHED:{
-
-				(*channel_power)[c] = (*channel_power)[c] - total_power[c];
-
-				// Avoid near-zero negative values
-				if ((*channel_power)[c] < 0.000001) (*channel_power)[c] = 0;
-				break;
-			}
+	// Increase/decrease power sensed if TX started/finished (branch-free loops over the channels)
+	double *power (*channel_power);
+	double *compensation (channel_power_compensation);
+	double sign;
+	switch(update_type){
+		case TX_FINISHED:{
+			sign = -1;
+			break;
+		}
+		case TX_INITIATED:{
+			sign = 1;
+			break;
+		}
+		default:{
+			return;
+		}
+	}
 
-			case TX_INITIATED:{
-				(*channel_power)[c] = (*channel_power)[c] + total_power[c];
-				break;
-			}
+	// The power and its compensation form a double-double: the rounding error of each update is added to the
+	// compensation, and the pair is renormalized so that the power sensed is always the best rounding of both
+	for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
+		double update (sign * total_power[c]);
+		double sum (power[c] + update);
+		double update_rounded (sum - power[c]);
+		double error ((power[c] - (sum - update_rounded)) + (update - update_rounded));
+		double low (compensation[c] + error);
+		power[c] = sum + low;
+		compensation[c] = low - (power[c] - sum);
+	}
 
-			default:{}
+	// Avoid near-zero negative values
+	if(update_type == TX_FINISHED) {
+		for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
+			int empty (power[c] < 0.000001);
+			power[c] = empty ? 0 : power[c];
+			compensation[c] = empty ? 0 : compensation[c];
 		}
-
 	}
 }
 
@@ -639,7 +408,7 @@ void UpdateChannelsPower(double **channel_power, Notification notification,
 * @return "sinr" [type double]: SINR in dB
 */
 double UpdateSINR(double pw_received_interest, double max_pw_interference){
-	double sinr (pw_received_interest / (max_pw_interference + ConvertPower(DBM_TO_PW, NOISE_LEVEL_DBM)));
+	double sinr (pw_received_interest / (max_pw_interference + NOISE_LEVEL_PW));
 	return sinr;
 }
 
@@ -649,24 +418,27 @@ double UpdateSINR(double pw_received_interest, double max_pw_interference){
 * @param "channel_max_intereference" [type int*]: number of channel with the highest interference (to be updated by this method)
 * @param "notification_interest" [type Notification]: last detected notification
 * @param "node_state" [type int]: state of the node
-* @param "power_received_per_node" [type std::map<int,double>]: dynamic map providing the power received by each active node
+* @param "power_received_per_node" [type ActiveTransmitters]: set of active nodes and the power received from each one
 * @param "channel_power" [type double*]: array with the power detected per channel
 */
 void ComputeMaxInterference(double *max_pw_interference, int *channel_max_intereference,
-	Notification notification_interest, int node_state, std::map<int,double> &power_received_per_node,
+	const Notification &notification_interest, int node_state, const ActiveTransmitters &power_received_per_node,
 	double **channel_power) {
 
 	*max_pw_interference = 0;
 
-	for(int c = notification_interest.left_channel; c <= notification_interest.right_channel; ++c){
+	if((node_state == STATE_RX_DATA || node_state == STATE_RX_ACK || node_state == STATE_NAV
+		|| node_state == STATE_RX_RTS || node_state == STATE_RX_CTS || node_state == STATE_SENSING)
+		&& notification_interest.left_channel <= notification_interest.right_channel){
+
+		// Power of interest, looked up once for all the channels
+		double pw_interest (power_received_per_node.Power(notification_interest.source_id));
 
-		if(node_state == STATE_RX_DATA || node_state == STATE_RX_ACK || node_state == STATE_NAV
-			|| node_state == STATE_RX_RTS || node_state == STATE_RX_CTS || node_state == STATE_SENSING){
+		for(int c = notification_interest.left_channel; c <= notification_interest.right_channel; ++c){
 
-			if(*max_pw_interference <
-					((*channel_power)[c] - power_received_per_node[notification_interest.source_id])){
+			if(*max_pw_interference < ((*channel_power)[c] - pw_interest)){
 
-				*max_pw_interference = (*channel_power)[c] - power_received_per_node[notification_interest.source_id];
+				*max_pw_interference = (*channel_power)[c] - pw_interest;
 
 				*channel_max_intereference = c;
 
@@ -692,7 +464,7 @@ void GetTxChannelsByChannelBondingCCA11ax(int *channels_for_tx, int channel_bond
 
 		// Only Primary Channel used if FREE
 		case CB_ONLY_PRIMARY:{
-			if((*channel_power)[primary_channel] < ConvertPower(DBM_TO_PW,-82)) channels_for_tx[primary_channel] = TRUE;
+			if((*channel_power)[primary_channel] < CCA_PRIMARY_20MHZ_PW) channels_for_tx[primary_channel] = TRUE;
 			break;
 		}
 
@@ -709,21 +481,21 @@ void GetTxChannelsByChannelBondingCCA11ax(int *channels_for_tx, int channel_bond
 					if(primary_channel <=3){
 
 						for(int c = 0; c <= 3; ++c){
-							if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_80MHZ)) num_ch_tx_possible = 4;
+							if((*channel_power)[c] > CCA_PRIMARY_80MHZ_PW) num_ch_tx_possible = 4;
 						}
 
 						for(int c = 4; c <= 7; ++c){
-							if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_80MHZ)) num_ch_tx_possible = 4;
+							if((*channel_power)[c] > CCA_SECONDARY_80MHZ_PW) num_ch_tx_possible = 4;
 						}
 
 					} else {
 
 						for(int c = 0; c <= 3; ++c){
-							if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_80MHZ)) num_ch_tx_possible = 4;
+							if((*channel_power)[c] > CCA_SECONDARY_80MHZ_PW) num_ch_tx_possible = 4;
 						}
 
 						for(int c = 4; c <= 7; ++c){
-							if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_80MHZ)) num_ch_tx_possible = 4;
+							if((*channel_power)[c] > CCA_PRIMARY_80MHZ_PW) num_ch_tx_possible = 4;
 						}
 
 					}
@@ -736,21 +508,21 @@ void GetTxChannelsByChannelBondingCCA11ax(int *channels_for_tx, int channel_bond
 							if(primary_channel <= 1){
 
 								for(int c = 0; c <= 1; ++c){
-									if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_40MHZ)) num_ch_tx_possible = 2;
+									if((*channel_power)[c] > CCA_PRIMARY_40MHZ_PW) num_ch_tx_possible = 2;
 								}
 
 								for(int c = 2; c <= 3; ++c){
-									if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_40MHZ)) num_ch_tx_possible = 2;
+									if((*channel_power)[c] > CCA_SECONDARY_40MHZ_PW) num_ch_tx_possible = 2;
 								}
 
 							} else {
 
 								for(int c = 0; c <= 1; ++c){
-									if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_40MHZ)) num_ch_tx_possible = 2;
+									if((*channel_power)[c] > CCA_SECONDARY_40MHZ_PW) num_ch_tx_possible = 2;
 								}
 
 								for(int c = 2; c <= 3; ++c){
-									if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_40MHZ)) num_ch_tx_possible = 2;
+									if((*channel_power)[c] > CCA_PRIMARY_40MHZ_PW) num_ch_tx_possible = 2;
 								}
 
 							}
@@ -760,21 +532,21 @@ void GetTxChannelsByChannelBondingCCA11ax(int *channels_for_tx, int channel_bond
 							if(primary_channel <= 5){
 
 								for(int c = 4; c <= 5; ++c){
-									if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_40MHZ)) num_ch_tx_possible = 2;
+									if((*channel_power)[c] > CCA_PRIMARY_40MHZ_PW) num_ch_tx_possible = 2;
 								}
 
 								for(int c = 6; c <= 7; ++c){
-									if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_40MHZ)) num_ch_tx_possible = 2;
+									if((*channel_power)[c] > CCA_SECONDARY_40MHZ_PW) num_ch_tx_possible = 2;
 								}
 
 							} else {
 
 								for(int c = 4; c <= 5; ++c){
-									if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_40MHZ)) num_ch_tx_possible = 2;
+									if((*channel_power)[c] > CCA_SECONDARY_40MHZ_PW) num_ch_tx_possible = 2;
 								}
 
 								for(int c = 6; c <= 7; ++c){
-									if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_40MHZ)) num_ch_tx_possible = 2;
+									if((*channel_power)[c] > CCA_PRIMARY_40MHZ_PW) num_ch_tx_possible = 2;
 								}
 
 							}
@@ -786,29 +558,29 @@ void GetTxChannelsByChannelBondingCCA11ax(int *channels_for_tx, int channel_bond
 						// Try 40 MHz
 						// Detect primary 20 MHz
 						if(primary_channel == 0){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel+1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel+1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 1){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel-1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel-1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 2){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel+1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel+1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 3){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel-1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel-1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 4){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel+1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel+1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 5){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel-1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel-1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 6){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel+1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel+1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 7){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel-1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel-1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						}
 
 					}
@@ -867,21 +639,21 @@ void GetTxChannelsByChannelBondingCCA11ax(int *channels_for_tx, int channel_bond
 						if(primary_channel <= 1){
 
 							for(int c = 0; c <= 1; ++c){
-								if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_40MHZ)) num_ch_tx_possible = 2;
+								if((*channel_power)[c] > CCA_PRIMARY_40MHZ_PW) num_ch_tx_possible = 2;
 							}
 
 							for(int c = 2; c <= 3; ++c){
-								if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_40MHZ)) num_ch_tx_possible = 2;
+								if((*channel_power)[c] > CCA_SECONDARY_40MHZ_PW) num_ch_tx_possible = 2;
 							}
 
 						} else {
 
 							for(int c = 0; c <= 1; ++c){
-								if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_40MHZ)) num_ch_tx_possible = 2;
+								if((*channel_power)[c] > CCA_SECONDARY_40MHZ_PW) num_ch_tx_possible = 2;
 							}
 
 							for(int c = 2; c <= 3; ++c){
-								if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_40MHZ)) num_ch_tx_possible = 2;
+								if((*channel_power)[c] > CCA_PRIMARY_40MHZ_PW) num_ch_tx_possible = 2;
 							}
 
 						}
@@ -891,21 +663,21 @@ void GetTxChannelsByChannelBondingCCA11ax(int *channels_for_tx, int channel_bond
 						if(primary_channel <= 5){
 
 							for(int c = 4; c <= 5; ++c){
-								if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_40MHZ)) num_ch_tx_possible = 2;
+								if((*channel_power)[c] > CCA_PRIMARY_40MHZ_PW) num_ch_tx_possible = 2;
 							}
 
 							for(int c = 6; c <= 7; ++c){
-								if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_40MHZ)) num_ch_tx_possible = 2;
+								if((*channel_power)[c] > CCA_SECONDARY_40MHZ_PW) num_ch_tx_possible = 2;
 							}
 
 						} else {
 
 							for(int c = 4; c <= 5; ++c){
-								if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_40MHZ)) num_ch_tx_possible = 2;
+								if((*channel_power)[c] > CCA_SECONDARY_40MHZ_PW) num_ch_tx_possible = 2;
 							}
 
 							for(int c = 6; c <= 7; ++c){
-								if((*channel_power)[c] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_40MHZ)) num_ch_tx_possible = 2;
+								if((*channel_power)[c] > CCA_PRIMARY_40MHZ_PW) num_ch_tx_possible = 2;
 							}
 
 						}
@@ -916,29 +688,29 @@ void GetTxChannelsByChannelBondingCCA11ax(int *channels_for_tx, int channel_bond
 						// Try 40 MHz
 						// Detect primary 20 MHz
 						if(primary_channel == 0){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel+1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel+1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 1){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel-1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel-1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 2){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel+1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel+1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 3){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel-1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel-1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 4){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel+1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel+1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 5){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel-1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel-1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 6){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel+1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel+1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						} else if(primary_channel == 7){
-							if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-							if((*channel_power)[primary_channel-1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+							if((*channel_power)[primary_channel-1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 						}
 
 					}
@@ -995,29 +767,29 @@ void GetTxChannelsByChannelBondingCCA11ax(int *channels_for_tx, int channel_bond
 					// Try 40 MHz
 					// Detect primary 20 MHz
 					if(primary_channel == 0){
-						if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-						if((*channel_power)[primary_channel+1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel+1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 					} else if(primary_channel == 1){
-						if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-						if((*channel_power)[primary_channel-1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel-1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 					} else if(primary_channel == 2){
-						if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-						if((*channel_power)[primary_channel+1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel+1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 					} else if(primary_channel == 3){
-						if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-						if((*channel_power)[primary_channel-1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel-1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 					} else if(primary_channel == 4){
-						if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-						if((*channel_power)[primary_channel+1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel+1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 					} else if(primary_channel == 5){
-						if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-						if((*channel_power)[primary_channel-1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel-1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 					} else if(primary_channel == 6){
-						if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-						if((*channel_power)[primary_channel+1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel+1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 					} else if(primary_channel == 7){
-						if((*channel_power)[primary_channel] > ConvertPower(DBM_TO_PW,CCA_PRIMARY_20MHZ)) num_ch_tx_possible = 1;
-						if((*channel_power)[primary_channel-1] > ConvertPower(DBM_TO_PW,CCA_SECONDARY_20MHZ)) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel] > CCA_PRIMARY_20MHZ_PW) num_ch_tx_possible = 1;
+						if((*channel_power)[primary_channel-1] > CCA_SECONDARY_20MHZ_PW) num_ch_tx_possible = 1;
 					}
 
 					if (num_ch_tx_possible == 1){
@@ -1092,9 +864,11 @@ void GetTxChannelsByChannelBondingCCA11ax(int *channels_for_tx, int channel_bond
 * @param "mcs_per_node" [type int**]: matrix containing the MCS to be used for each node and number of channels
 * @param "ix_mcs_per_node" [type int]: index of the MCS used per node
 * @param "num_channels_system" [type int]: total number of channels in the system
+* @param "stream" [type RandomStream]: channel bonding random stream of the node (probabilistic models)
 */
 void GetTxChannelsByChannelBondingCCASame(int *channels_for_tx, int channel_bonding_model, int *channels_free,
-    int min_channel_allowed, int max_channel_allowed, int primary_channel, int num_channels_system){
+    int min_channel_allowed, int max_channel_allowed, int primary_channel, int num_channels_system,
+	RandomStream &stream){
 
 	// Reset channels for transmitting
 	for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
@@ -1327,7 +1101,7 @@ void GetTxChannelsByChannelBondingCCASame(int *channels_for_tx, int channel_bond
 
 				int ch_range_ix = GetNumberOfSpecificElementInArray(1, possible_channel_ranges_ixs, 4);
 
-				int random_value = 1 + rand() % (ch_range_ix);	// 1 to ch_range_ix
+				int random_value = 1 + stream.Uniform(ch_range_ix);	// 1 to ch_range_ix
 
 				switch(ch_range_ix){
 
@@ -1635,17 +1409,18 @@ void GetMinAndMaxAllowedChannels(int& min_ch, int& max_ch, int primary_channel,
 * @param "num_channels_komondor" [type int]: number of channels in the system
 * @param "channel_power" [type double**]: array indicating the power perceived per channel
 * @param "channel_aggregation_cca_model" [type int]: indicates if CCA is considered to be different per bandwidth
+* @param "stream" [type RandomStream]: channel bonding random stream of the node (probabilistic models)
 */
 
 void GetTxChannels(int *channels_for_tx, int channel_bonding_model, int *channels_free,
     int min_channel_allowed, int max_channel_allowed, int primary_channel, int num_channels_komondor,
-	double **channel_power, int channel_aggregation_cca_model){
+	double **channel_power, int channel_aggregation_cca_model, RandomStream &stream){
 
 	switch(channel_aggregation_cca_model){
 
 		case CHANNEL_AGGREGATION_CCA_SAME:{
 			GetTxChannelsByChannelBondingCCASame(channels_for_tx, channel_bonding_model, channels_free,
-					min_channel_allowed, max_channel_allowed, primary_channel, num_channels_komondor);
+					min_channel_allowed, max_channel_allowed, primary_channel, num_channels_komondor, stream);
 			break;
 		}
 
@@ -0,0 +1,196 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+
+ /**
+ * power_conversion_methods.h: this file contains functions related to the main Komondor's operation
+ *
+ * - This file contains the dB/linear conversions used in the hot paths of the simulation
+ * - The exact conversions give the same values as ConvertPower(). The constants they use are folded
+ *   by the compiler, and the thresholds used per event are converted once (e.g., NOISE_LEVEL_PW).
+ * - The fast conversions approximate exp2/log2 with polynomials and selects (no calls nor branches),
+ *   so that the loops of the array versions can be vectorized by the compiler (e.g., -O3 -march=native). Error bounds (normal, positive powers):
+ *     + FastDbmToPw: relative error below 1e-8 (i.e., below 5e-8 dB)
+ *     + FastPwToDbm: absolute error below 1e-8 dB
+ *   They are only used if enabled (option --fast_power_conversion=1, useful for large sweeps), and
+ *   may change the outcome of a comparison with a threshold closer than the error bound.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../list_of_macros.h"
+
+#ifndef _POWER_CONVERSION_METHODS_
+#define _POWER_CONVERSION_METHODS_
+
+extern int fast_power_conversion;	///> TRUE to use the fast conversions in the hot paths (defined in komondor_main.cc, set once before the simulation starts)
+
+/**
+* Exact conversions (same formulas as ConvertPower)
+*/
+inline double ExactDbmToPw(double power_dbm){
+	return pow(10, (power_dbm + 90) / 10);
+}
+
+inline double ExactPwToDbm(double power_pw){
+	return 10 * log10(power_pw * 1e-9);
+}
+
+inline double ExactDbToLinear(double power_db){
+	return pow(10, power_db / 10);
+}
+
+inline double ExactLinearToDb(double power_linear){
+	return 10 * log10(power_linear);
+}
+
+/**
+* Approximate 2^x (relative error below 1e-8; 0 at or below 2^-1022, saturated at 2^1023)
+* @param "x" [type double]: exponent
+* @return "power" [type double]: 2^x
+*/
+inline double FastExp2(double x){
+	// 2^x = 2^k * 2^f, with k = round(x) and f in [-0.5, 0.5] (degree-7 Taylor series of e^(f ln2)).
+	// Adding and subtracting 1.5 * 2^52 rounds x to the integer k
+	const double round_shift (6755399441055744.0);
+	double x_clamped ((x < -1022) ? -1022 : ((x > 1023) ? 1023 : x));
+	double k_shifted (x_clamped + round_shift);
+	double k (k_shifted - round_shift);
+	double f ((x_clamped - k) * M_LN2);
+	double p (1 + f * (1 + f * (1.0/2 + f * (1.0/6 + f * (1.0/24 + f * (1.0/120
+		+ f * (1.0/720 + f * (1.0/5040))))))));
+	// 2^k is built from its biased exponent, clamped to the normal range
+	int64_t biased_exponent ((int64_t) k + 1023);
+	biased_exponent = (biased_exponent < 1) ? 1 : ((biased_exponent > 2046) ? 2046 : biased_exponent);
+	uint64_t bits ((uint64_t) biased_exponent << 52);
+	double two_to_k;
+	memcpy(&two_to_k, &bits, sizeof(double));
+	return (x_clamped == -1022) ? 0 : p * two_to_k;
+}
+
+/**
+* Approximate log2(x) (absolute error below 1e-9; -INFINITY for x <= 0)
+* @param "x" [type double]: normal positive value
+* @return "log" [type double]: log2(x)
+*/
+inline double FastLog2(double x){
+	// x = 2^e * m, with m in [sqrt(2)/2, sqrt(2)): ln(m) = 2 atanh(s), s = (m - 1) / (m + 1), |s| < 0.172
+	uint64_t bits;
+	memcpy(&bits, &x, sizeof(double));
+	double e ((double) ((int) ((bits >> 52) & 0x7ff) - 1023));
+	bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+	double m;
+	memcpy(&m, &bits, sizeof(double));
+	int m_high (m > M_SQRT2);
+	m = m_high ? m / 2 : m;
+	e = m_high ? e + 1 : e;
+	double s ((m - 1) / (m + 1));
+	double s2 (s * s);
+	double ln_m (2 * s * (1 + s2 * (1.0/3 + s2 * (1.0/5 + s2 * (1.0/7 + s2 * (1.0/9 + s2 * (1.0/11)))))));
+	return (x > 0) ? e + ln_m * M_LOG2E : -INFINITY;
+}
+
+/**
+* Fast conversions: 10^(x/10) = 2^(x log2(10) / 10), 10 log10(x) = 10 log10(2) log2(x)
+*/
+inline double FastDbmToPw(double power_dbm){
+	return FastExp2((power_dbm + 90) * (M_LN10 / M_LN2 / 10));
+}
+
+inline double FastPwToDbm(double power_pw){
+	return FastLog2(power_pw) * (10 * M_LN2 / M_LN10) - 90;
+}
+
+/**
+* Conversions of the hot paths (fast ones if enabled)
+*/
+inline double DbmToPw(double power_dbm){
+	return fast_power_conversion ? FastDbmToPw(power_dbm) : ExactDbmToPw(power_dbm);
+}
+
+inline double PwToDbm(double power_pw){
+	return fast_power_conversion ? FastPwToDbm(power_pw) : ExactPwToDbm(power_pw);
+}
+
+/**
+* Convert an array of powers from dBm to pW
+* @param "power_dbm" [type double*]: powers [dBm]
+* @param "power_pw" [type double*]: powers [pW] (to be filled by this method)
+* @param "size" [type int]: number of powers
+*/
+void DbmToPwArray(const double *power_dbm, double *power_pw, int size){
+	if(fast_power_conversion) {
+		for(int i = 0; i < size; ++i) power_pw[i] = FastDbmToPw(power_dbm[i]);
+	} else {
+		for(int i = 0; i < size; ++i) power_pw[i] = ExactDbmToPw(power_dbm[i]);
+	}
+}
+
+/**
+* Convert an array of powers from pW to dBm
+* @param "power_pw" [type double*]: powers [pW]
+* @param "power_dbm" [type double*]: powers [dBm] (to be filled by this method)
+* @param "size" [type int]: number of powers
+*/
+void PwToDbmArray(const double *power_pw, double *power_dbm, int size){
+	if(fast_power_conversion) {
+		for(int i = 0; i < size; ++i) power_dbm[i] = FastPwToDbm(power_pw[i]);
+	} else {
+		for(int i = 0; i < size; ++i) power_dbm[i] = ExactPwToDbm(power_pw[i]);
+	}
+}
+
+// Thresholds used per event, converted once
+const double NOISE_LEVEL_PW (ExactDbmToPw(NOISE_LEVEL_DBM));				///> Noise level [pW]
+const double CCA_PRIMARY_20MHZ_PW (ExactDbmToPw(CCA_PRIMARY_20MHZ));		///> CCA for primary channel of width 20 MHz [pW]
+const double CCA_SECONDARY_20MHZ_PW (ExactDbmToPw(CCA_SECONDARY_20MHZ));	///> CCA for secondary channel of width 20 MHz [pW]
+const double CCA_PRIMARY_40MHZ_PW (ExactDbmToPw(CCA_PRIMARY_40MHZ));		///> CCA for primary channel of width 40 MHz [pW]
+const double CCA_SECONDARY_40MHZ_PW (ExactDbmToPw(CCA_SECONDARY_40MHZ));	///> CCA for secondary channel of width 40 MHz [pW]
+const double CCA_PRIMARY_80MHZ_PW (ExactDbmToPw(CCA_PRIMARY_80MHZ));		///> CCA for primary channel of width 80 MHz [pW]
+const double CCA_SECONDARY_80MHZ_PW (ExactDbmToPw(CCA_SECONDARY_80MHZ));	///> CCA for secondary channel of width 80 MHz [pW]
+
+#endif
@@ -68,7 +68,7 @@
 * @param "srg" [type int]: SRG of the node inspecting the notification
 * @return "type_of_packet" [type int]: type of packet
 */
-int CheckPacketOrigin(Notification notification, int bss_color, int srg) {
+int CheckPacketOrigin(const Notification &notification, int bss_color, int srg) {
 
 	int type_of_packet;
 	int bss_color_enabled (false);
@@ -174,7 +174,7 @@ double ApplyTxPowerRestriction(double current_pd, double current_tx_power) {
 * @param "enter_or_leave" [type int]: indicates whether the transmission starts (1) or ends (0)
 */
 void UpdateTypeOngoingTransmissions(int *type_ongoing_transmissions,
-	Notification notification, int bss_color, int srg, int enter_or_leave) {
+	const Notification &notification, int bss_color, int srg, int enter_or_leave) {
 
 	// Identify the type of packet according to the BSS color and the SRG
 	int packet_type_source = CheckPacketOrigin(notification, bss_color, srg);
@@ -54,11 +54,6 @@
 #include <stddef.h>
 #include "../list_of_macros.h"
 
-// Exponential redefinition
-double	Random( double v=1.0)	{ return v*drand48();}
-int	Random( int v)	{ return (int)(v*drand48()); }
-double	Exponential(double mean){ return -mean*log(Random());}
-
 /**
 * Compute the minimum number of packets to be transmitted within the maximum PPDU time (IEEE_AX_MAX_PPDU_DURATION)
 * @param "num_packets_aggregated" [type int]: current number of aggregated packets
@@ -89,45 +84,6 @@ int findMaximumPacketsAggregated(int num_packets_aggregated, int data_packet_len
 
 }
 
-/**
-* Compute the transmission time (just link rate) according to the number of channels used and packet length
-* @param "total_bits" [type int]: total number bits to be transmitted
-* @param "data_rate" [type int]: data rate employed
-* @param "pdf_tx_time" [type int]: pdf type for computing the transmission type (PDF_DETERMINISTIC or PDF_EXPONENTIAL)
-* @return "tx_time" [type double]: transmission time
-*/
-double ComputeTxTime(int total_bits, double data_rate, int pdf_tx_time){
-
-	double tx_time;
-
-	// TODO: hardcoding rate to match CTMN analysis (MU for one channel)
-	// data_rate = pow(10,6);
-
-	switch(pdf_tx_time){
-
-		case PDF_DETERMINISTIC:{
-			tx_time = total_bits/data_rate;
-			break;
-		}
-
-		case PDF_EXPONENTIAL:{
-			tx_time = Exponential(total_bits/data_rate);
-			break;
-		}
-
-		default:{
-			printf("TX time model not found!\n");
-			exit(EXIT_FAILURE);
-		}
-	}
-
-	// TODO: THIS IS HARDCODED
-	// tx_time = 1000 * MICRO_VALUE;
-	// END HARCODED
-
-	return tx_time;
-}
-
 /**
 * Compute the RTS transmission time (IEEE 802.11ax)
 * @param "bits_ofdm_sym_legacy" [type double]: bits of a legacy OFDM symbol
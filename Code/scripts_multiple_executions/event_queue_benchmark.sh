@@ -0,0 +1,44 @@
+# define execution parameters
+SIM_TIME=10
+SEED=1992
+QUEUES=(simple heap dary calendar ladder)
+INPUT_FOLDER=input/validation/high_density_scenarios
+# compile KOMONDOR
+cd ..
+cd main
+./build_local
+echo 'BENCHMARKING THE EVENT QUEUES OF THE SIMULATION ENGINE... '
+cd ..
+# remove old script output file and node logs
+rm output/*
+
+# get input files path (the system configuration file is not a nodes file)
+cd $INPUT_FOLDER
+echo 'DETECTED KOMONDOR INPUT FILES: '
+file_ix=0
+while read line
+do
+	array[ $file_ix ]="$line"
+	echo "- ${array[file_ix]}"
+	(( file_ix++ ))
+done < <(ls input_nodes_*.csv)
+
+(( file_ix --));
+
+# execute every input file with every queue
+cd ../../..
+cd main
+echo "input;queue;events;seconds;events_per_second" > ../output/event_queue_benchmark.csv
+for (( executing_ix=0; executing_ix < (file_ix + 1); executing_ix++))
+do
+	for queue in "${QUEUES[@]}"
+	do
+		echo "- EXECUTING ${array[executing_ix]} WITH $queue (${executing_ix}/${file_ix})"
+		./komondor_main ../$INPUT_FOLDER/${array[executing_ix]} ../output/script_output.txt sim_${queue}_${array[executing_ix]} 0 0 0 $SIM_TIME $SEED --event_queue=$queue > ../output/logs_console_${queue}.txt
+		# "# <events> events processed in <seconds> seconds, event processing rate: <rate>"
+		grep "events processed in" ../output/logs_console_${queue}.txt | awk -v f=${array[executing_ix]} -v q=$queue '{print f";"q";"$2";"$6";"$NF}' >> ../output/event_queue_benchmark.csv
+	done
+done
+echo ""
+echo 'SCRIPT FINISHED: RESULTS SAVED IN /output/event_queue_benchmark.csv'
+echo ""
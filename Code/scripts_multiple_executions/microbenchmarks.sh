@@ -0,0 +1,27 @@
+# compile and run the unit tests and microbenchmarks of the data structures (folder 'microbenchmarks')
+# - each program includes the headers of the simulator and runs without the simulation engine
+# - the tests (*_test.cc) return a non-zero status if they fail
+echo 'RUNNING THE MICROBENCHMARKS... '
+mkdir -p ../output
+cd microbenchmarks
+failures=0
+for source in *.cc
+do
+	program=${source%.cc}
+	echo "- $program"
+	if ! g++ -O2 -Wall -pthread -o $program $source; then
+		echo "  COMPILATION FAILED"
+		(( failures++ ))
+		continue
+	fi
+	./$program > ../../output/$program.txt
+	if [ $? -ne 0 ]; then
+		(( failures++ ))
+	fi
+	cat ../../output/$program.txt
+	rm $program
+done
+echo ""
+echo "SCRIPT FINISHED: $failures FAILURES, RESULTS SAVED IN /output/<program>.txt"
+echo ""
+exit $failures
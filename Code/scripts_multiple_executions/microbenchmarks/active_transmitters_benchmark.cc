@@ -0,0 +1,205 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+/**
+ * active_transmitters_benchmark.cc: cost of the set of active transmitters sensed by a node
+ *
+ * - Runs the same random sets, erases and lookups (about NUM_ACTIVE transmitters sensed at a time) on
+ *   ActiveTransmitters, on the dense version it replaced (one slot per node of the scenario) and on a
+ *   std::map, and checks that the three agree.
+ * - Prints the time per operation, and the time and memory to initialize the sets of every node of
+ *   scenarios of increasing size (the dense slots grow with the square of the number of nodes).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+#include <map>
+
+#include "../../structures/active_transmitters.h"
+
+#define NUM_OPERATIONS	20000000	///> Operations of each measurement
+#define NUM_ACTIVE		20			///> Transmitters sensed at a time (on average)
+
+/**
+ * Return the current time of a monotonic clock
+ * @return "seconds" [type double]: time [s]
+ */
+double Now(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Set of active transmitters before the hash table: one slot per source id of the scenario
+ */
+struct DenseActiveTransmitters
+{
+	std::vector<int> slot_per_source;
+	std::vector<int> sources;
+	std::vector<double> power;
+
+	void InitializeActiveTransmitters(int total_nodes_number){
+		slot_per_source.assign(total_nodes_number, -1);
+		sources.clear();
+		power.clear();
+	}
+	void Set(int source, double pw_received){
+		int slot (slot_per_source[source]);
+		if(slot == -1) {
+			slot_per_source[source] = sources.size();
+			sources.push_back(source);
+			power.push_back(pw_received);
+		} else {
+			power[slot] = pw_received;
+		}
+	}
+	void Erase(int source){
+		int slot (slot_per_source[source]);
+		if(slot == -1) return;
+		int last (sources.back());
+		sources[slot] = last;
+		power[slot] = power.back();
+		slot_per_source[last] = slot;
+		slot_per_source[source] = -1;
+		sources.pop_back();
+		power.pop_back();
+	}
+	double Power(int source) const {
+		int slot (slot_per_source[source]);
+		return((slot == -1) ? 0 : power[slot]);
+	}
+};
+
+/**
+ * Random operations: a source id, and whether it starts (set) or finishes (erase) a transmission. An active
+ * source always finishes and an idle one starts with probability NUM_ACTIVE / (num_nodes - NUM_ACTIVE), so
+ * about NUM_ACTIVE are active at a time
+ */
+struct Operations
+{
+	std::vector<int> source;
+	std::vector<int> is_set;
+
+	Operations(int num_nodes){
+		srand48(1992);
+		std::vector<int> active(num_nodes, 0);
+		for(int i = 0; i < NUM_OPERATIONS; ++i){
+			int s ((int) (drand48() * num_nodes));
+			int start (!active[s] && drand48() < NUM_ACTIVE / (double) (num_nodes - NUM_ACTIVE));
+			active[s] = start;
+			source.push_back(s);
+			is_set.push_back(start);
+		}
+	}
+};
+
+int main(){
+
+	const int scenario_nodes[] = {100, 1000, 10000};
+	int failures (0);
+
+	for(int n = 0; n < 3; ++n){
+
+		int num_nodes (scenario_nodes[n]);
+		Operations operations(num_nodes);
+		double checksum_sparse (0), checksum_dense (0), checksum_map (0);
+
+		// Operations: the power of each source is looked up before it is set or erased
+		ActiveTransmitters sparse;
+		sparse.InitializeActiveTransmitters();
+		double start (Now());
+		for(int i = 0; i < NUM_OPERATIONS; ++i){
+			int s (operations.source[i]);
+			checksum_sparse += sparse.Power(s);
+			if(operations.is_set[i]) sparse.Set(s, s + 1); else sparse.Erase(s);
+		}
+		double ns_sparse ((Now() - start) / NUM_OPERATIONS * 1e9);
+
+		DenseActiveTransmitters dense;
+		dense.InitializeActiveTransmitters(num_nodes);
+		start = Now();
+		for(int i = 0; i < NUM_OPERATIONS; ++i){
+			int s (operations.source[i]);
+			checksum_dense += dense.Power(s);
+			if(operations.is_set[i]) dense.Set(s, s + 1); else dense.Erase(s);
+		}
+		double ns_dense ((Now() - start) / NUM_OPERATIONS * 1e9);
+
+		std::map<int, double> map;
+		start = Now();
+		for(int i = 0; i < NUM_OPERATIONS; ++i){
+			int s (operations.source[i]);
+			std::map<int, double>::iterator it (map.find(s));
+			checksum_map += (it == map.end()) ? 0 : it->second;
+			if(operations.is_set[i]) map[s] = s + 1; else if(it != map.end()) map.erase(it);
+		}
+		double ns_map ((Now() - start) / NUM_OPERATIONS * 1e9);
+
+		printf("%5d nodes, %d active: hash table %6.2f ns/op, dense slots %6.2f ns/op, std::map %6.2f ns/op\n",
+			num_nodes, sparse.Size(), ns_sparse, ns_dense, ns_map);
+		if(checksum_sparse != checksum_dense || checksum_sparse != checksum_map || sparse.Size() != (int) map.size()) {
+			printf("FAILED: the sets differ (checksums %g, %g and %g)\n", checksum_sparse, checksum_dense, checksum_map);
+			++failures;
+		}
+
+		// Initialization of the set of every node of the scenario
+		std::vector<ActiveTransmitters> sparse_per_node(num_nodes);
+		start = Now();
+		for(int i = 0; i < num_nodes; ++i) sparse_per_node[i].InitializeActiveTransmitters();
+		double ms_sparse ((Now() - start) * 1e3);
+		std::vector<DenseActiveTransmitters> dense_per_node(num_nodes);
+		start = Now();
+		for(int i = 0; i < num_nodes; ++i) dense_per_node[i].InitializeActiveTransmitters(num_nodes);
+		double ms_dense ((Now() - start) * 1e3);
+		printf("%5d nodes, initialization: hash table %8.3f ms (%7.2f MB), dense slots %8.3f ms (%7.2f MB)\n",
+			num_nodes, ms_sparse, num_nodes * (2 << ActiveTransmitters::INITIAL_BUCKETS_LOG2) * sizeof(int) * 1e-6,
+			ms_dense, num_nodes * (double) num_nodes * sizeof(int) * 1e-6);
+	}
+
+	return failures;
+}
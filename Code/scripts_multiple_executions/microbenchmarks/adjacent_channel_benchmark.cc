@@ -0,0 +1,180 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+/**
+ * adjacent_channel_benchmark.cc: cost of the adjacent channel interference models
+ *
+ * - Applies the boundary and extreme models with the leakage table (ApplyAdjacentChannelInterferenceModel)
+ *   and with the per-channel dBm conversions they replaced, to the same random transmissions.
+ * - Prints the time per call of each one and the largest relative difference between their powers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <string>
+
+#include "../../list_of_macros.h"
+#include "../../structures/notification.h"
+#include "../../structures/wlan.h"
+#include "../../methods/power_channel_methods.h"
+
+int fast_power_conversion (FALSE);	///> Exact conversions (defined in komondor_main.cc in the simulator)
+
+#define NUM_CALLS			5000000	///> Calls of each measurement
+#define NUM_TRANSMISSIONS	1024	///> Random transmissions applied in turn
+
+/**
+ * Return the current time of a monotonic clock
+ * @return "seconds" [type double]: time [s]
+ */
+double Now(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Adjacent channel interference as computed before the leakage table: the power is converted to dBm,
+ * reduced by 20 dB per channel of distance and converted back, once per affected channel
+ * @param "adjacent_channel_model" [type int]: adjacent channel model
+ * @param "total_power" [type double]: total power in each channel (to be updated by this method)
+ * @param "notification" [type Notification]: transmission
+ * @param "pw_received" [type double]: power received in pW
+ */
+void ApplyAdjacentChannelInterferenceModelPerChannel(int adjacent_channel_model, double total_power[],
+	const Notification &notification, double pw_received){
+
+	for(int i = notification.left_channel; i <= notification.right_channel; ++i){
+		total_power[i] = pw_received;
+	}
+	if(adjacent_channel_model == ADJACENT_CHANNEL_BOUNDARY) {
+		for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c) {
+			if(c < notification.left_channel || c > notification.right_channel){
+				double pw_loss_db (20 * abs(c < notification.left_channel ?
+					c - notification.left_channel : c - notification.right_channel));
+				double total_power_dbm (ConvertPower(PW_TO_DBM, pw_received) - pw_loss_db);
+				total_power[c] = total_power[c] + ConvertPower(DBM_TO_PW, total_power_dbm);
+				if(total_power[c] < MIN_VALUE_C_LANGUAGE) total_power[c] = 0;
+			}
+		}
+	} else {
+		for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c) {
+			for(int j = notification.left_channel; j <= notification.right_channel; ++j){
+				if(c != j) {
+					double total_power_dbm (ConvertPower(PW_TO_DBM, pw_received) - 20 * abs(c-j));
+					total_power[c] = total_power[c] + ConvertPower(DBM_TO_PW, total_power_dbm);
+					if(total_power[c] < MIN_DOUBLE_VALUE_KOMONDOR) total_power[c] = 0;
+				}
+			}
+		}
+	}
+}
+
+int main(){
+
+	// Random transmissions over 1, 2, 4 or 8 aligned channels, received between -90 and -30 dBm
+	Notification *notifications = new Notification[NUM_TRANSMISSIONS];
+	double *pw_received = new double[NUM_TRANSMISSIONS];
+	srand48(1992);
+	for(int t = 0; t < NUM_TRANSMISSIONS; ++t){
+		int width (1 << (int) (drand48() * 4));
+		notifications[t].left_channel = width * (int) (drand48() * NUM_CHANNELS_KOMONDOR / width);
+		notifications[t].right_channel = notifications[t].left_channel + width - 1;
+		pw_received[t] = ConvertPower(DBM_TO_PW, -90 + 60 * drand48());
+	}
+
+	const int models[] = {ADJACENT_CHANNEL_BOUNDARY, ADJACENT_CHANNEL_EXTREME};
+	const char *model_names[] = {"boundary", "extreme"};
+
+	for(int m = 0; m < 2; ++m){
+
+		// Accuracy: both implementations on every transmission
+		double max_relative_difference (0);
+		for(int t = 0; t < NUM_TRANSMISSIONS; ++t){
+			double power_table[NUM_CHANNELS_KOMONDOR] = {0};
+			double power_per_channel[NUM_CHANNELS_KOMONDOR] = {0};
+			ApplyAdjacentChannelInterferenceModel(models[m], power_table, notifications[t], 5, pw_received[t], 0);
+			ApplyAdjacentChannelInterferenceModelPerChannel(models[m], power_per_channel, notifications[t], pw_received[t]);
+			for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
+				if(power_per_channel[c] > 0) {
+					max_relative_difference = std::max(max_relative_difference,
+						fabs(power_table[c] - power_per_channel[c]) / power_per_channel[c]);
+				}
+			}
+		}
+
+		// Speed: the power of each call is accumulated, as in the nodes
+		double power[NUM_CHANNELS_KOMONDOR] = {0};
+		double start (Now());
+		for(int i = 0; i < NUM_CALLS; ++i){
+			int t (i % NUM_TRANSMISSIONS);
+			ApplyAdjacentChannelInterferenceModel(models[m], power, notifications[t], 5, pw_received[t], 0);
+		}
+		double seconds_table (Now() - start);
+		double checksum_table (power[0]);
+
+		for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c) power[c] = 0;
+		start = Now();
+		for(int i = 0; i < NUM_CALLS; ++i){
+			int t (i % NUM_TRANSMISSIONS);
+			ApplyAdjacentChannelInterferenceModelPerChannel(models[m], power, notifications[t], pw_received[t]);
+		}
+		double seconds_per_channel (Now() - start);
+		double checksum_per_channel (power[0]);
+
+		printf("%-8s leakage table: %7.2f ns/call (checksum %g)\n", model_names[m],
+			seconds_table / NUM_CALLS * 1e9, checksum_table);
+		printf("%-8s dBm per channel: %7.2f ns/call (checksum %g)\n", model_names[m],
+			seconds_per_channel / NUM_CALLS * 1e9, checksum_per_channel);
+		printf("%-8s speedup x%.1f, max relative difference %g\n", model_names[m],
+			seconds_per_channel / seconds_table, max_relative_difference);
+	}
+
+	delete[] notifications;
+	delete[] pw_received;
+	return 0;
+}
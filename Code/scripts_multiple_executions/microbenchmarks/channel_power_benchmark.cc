@@ -0,0 +1,149 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+/**
+ * channel_power_benchmark.cc: cost of the updates of the power sensed per channel
+ *
+ * - Starts and finishes random transmissions with plain additions (before the compensated summation) and with
+ *   UpdateChannelsPower, and recomputes the power from NUM_ACTIVE transmissions as the nodes do every
+ *   CHANNEL_POWER_RECOMPUTE_UPDATES updates.
+ * - Prints the time per update of each one, and the cost of the recomputation spread over the updates.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <string>
+
+#include "../../list_of_macros.h"
+#include "../../structures/notification.h"
+#include "../../structures/wlan.h"
+#include "../../methods/power_channel_methods.h"
+
+int fast_power_conversion (FALSE);	///> Exact conversions (defined in komondor_main.cc in the simulator)
+
+#define NUM_UPDATES			10000000	///> Updates of each measurement
+#define NUM_TRANSMISSIONS	1024		///> Random transmissions started and finished in turn
+#define NUM_ACTIVE			20			///> Transmissions sensed when the power is recomputed
+
+/**
+ * Return the current time of a monotonic clock
+ * @return "seconds" [type double]: time [s]
+ */
+double Now(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(){
+
+	Notification *notifications = new Notification[NUM_TRANSMISSIONS];
+	double *pw_received = new double[NUM_TRANSMISSIONS];
+	srand48(1992);
+	for(int t = 0; t < NUM_TRANSMISSIONS; ++t){
+		int width (1 << (int) (drand48() * 4));
+		notifications[t].left_channel = width * (int) (drand48() * NUM_CHANNELS_KOMONDOR / width);
+		notifications[t].right_channel = notifications[t].left_channel + width - 1;
+		pw_received[t] = pow(10, -3 + 10 * drand48());
+	}
+
+	// Plain additions: each transmission starts and then finishes
+	double power[NUM_CHANNELS_KOMONDOR] = {0};
+	double start (Now());
+	for(int i = 0; i < NUM_UPDATES; ++i){
+		int t ((i / 2) % NUM_TRANSMISSIONS);
+		double total_power[NUM_CHANNELS_KOMONDOR];
+		memset(total_power, 0, NUM_CHANNELS_KOMONDOR * sizeof(double));
+		ApplyAdjacentChannelInterferenceModel(ADJACENT_CHANNEL_BOUNDARY, total_power, notifications[t], 5, pw_received[t], 0);
+		if(i % 2 == 0) {
+			for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c) power[c] = power[c] + total_power[c];
+		} else {
+			for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
+				double remaining (power[c] - total_power[c]);
+				power[c] = (remaining < 0.000001) ? 0 : remaining;
+			}
+		}
+	}
+	double ns_plain ((Now() - start) / NUM_UPDATES * 1e9);
+	printf("plain additions:        %7.2f ns/update (checksum %g)\n", ns_plain, power[0]);
+
+	// Compensated summation
+	double compensation[NUM_CHANNELS_KOMONDOR] = {0};
+	double *power_ptr (power);
+	for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c) power[c] = 0;
+	start = Now();
+	for(int i = 0; i < NUM_UPDATES; ++i){
+		int t ((i / 2) % NUM_TRANSMISSIONS);
+		UpdateChannelsPower(&power_ptr, compensation, notifications[t], (i % 2 == 0) ? TX_INITIATED : TX_FINISHED,
+			5, 0, ADJACENT_CHANNEL_BOUNDARY, pw_received[t], 0);
+	}
+	double ns_compensated ((Now() - start) / NUM_UPDATES * 1e9);
+	printf("compensated summation:  %7.2f ns/update (checksum %g)\n", ns_compensated, power[0]);
+
+	// Recomputation from the transmissions sensed
+	int num_recomputations (NUM_UPDATES / CHANNEL_POWER_RECOMPUTE_UPDATES);
+	start = Now();
+	for(int r = 0; r < num_recomputations; ++r){
+		for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
+			power[c] = 0;
+			compensation[c] = 0;
+		}
+		for(int a = 0; a < NUM_ACTIVE; ++a){
+			int t ((r + a) % NUM_TRANSMISSIONS);
+			UpdateChannelsPower(&power_ptr, compensation, notifications[t], TX_INITIATED,
+				5, 0, ADJACENT_CHANNEL_BOUNDARY, pw_received[t], 0);
+		}
+	}
+	double ns_recomputation ((Now() - start) / num_recomputations * 1e9);
+	printf("recomputation (%d tx): %7.2f ns, %.3f ns/update every %d updates (checksum %g)\n", NUM_ACTIVE,
+		ns_recomputation, ns_recomputation / CHANNEL_POWER_RECOMPUTE_UPDATES, CHANNEL_POWER_RECOMPUTE_UPDATES, power[0]);
+
+	delete[] notifications;
+	delete[] pw_received;
+	return 0;
+}
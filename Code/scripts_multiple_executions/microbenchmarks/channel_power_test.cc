@@ -0,0 +1,181 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+/**
+ * channel_power_test.cc: accuracy of the power sensed per channel under constant load
+ *
+ * - A strong transmitter never stops, so the channels never empty and the power sensed is never reset.
+ *   Weaker transmitters (1e-3 to 1e7 pW, 1 to 8 channels) start and finish at random on top of it.
+ * - The power is updated as before the compensated summation (plain additions), with UpdateChannelsPower,
+ *   and with UpdateChannelsPower plus the recomputation from the transmissions sensed that the nodes run every
+ *   CHANNEL_POWER_RECOMPUTE_UPDATES updates.
+ * - Every channel is compared with the exact sum (long double) of the transmissions sensed. The test fails if
+ *   the recomputed power is off by more than MAX_RELATIVE_ERROR.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+
+#include "../../list_of_macros.h"
+#include "../../structures/notification.h"
+#include "../../structures/wlan.h"
+#include "../../methods/power_channel_methods.h"
+
+int fast_power_conversion (FALSE);	///> Exact conversions (defined in komondor_main.cc in the simulator)
+
+#define NUM_SOURCES			20			///> Transmitters (the first one never stops)
+#define NUM_EVENTS			2000000		///> Starts and finishes of the other transmitters
+#define CHECK_INTERVAL		1000		///> Events between two comparisons with the exact sum
+#define MAX_RELATIVE_ERROR	1e-12		///> Largest relative error accepted with the recomputation
+
+/**
+ * Power of a transmission sensed at each channel
+ * @param "notification" [type Notification]: transmission
+ * @param "pw_received" [type double]: power received [pW]
+ * @param "total_power" [type double*]: power per channel (to be filled)
+ */
+void PowerPerChannel(const Notification &notification, double pw_received, double *total_power){
+	memset(total_power, 0, NUM_CHANNELS_KOMONDOR * sizeof(double));
+	ApplyAdjacentChannelInterferenceModel(ADJACENT_CHANNEL_BOUNDARY, total_power, notification, 5, pw_received, 0);
+}
+
+int main(){
+
+	Notification notifications[NUM_SOURCES];
+	double pw_received[NUM_SOURCES];
+	int active[NUM_SOURCES];
+	srand48(1992);
+	for(int s = 0; s < NUM_SOURCES; ++s){
+		int width (1 << (int) (drand48() * 4));
+		notifications[s].left_channel = width * (int) (drand48() * NUM_CHANNELS_KOMONDOR / width);
+		notifications[s].right_channel = notifications[s].left_channel + width - 1;
+		pw_received[s] = pow(10, -3 + 10 * drand48());
+		active[s] = FALSE;
+	}
+	// The strong transmitter leaks into every channel
+	notifications[0].left_channel = 0;
+	notifications[0].right_channel = 1;
+	pw_received[0] = 1e7;
+
+	double plain[NUM_CHANNELS_KOMONDOR] = {0};
+	double compensated[NUM_CHANNELS_KOMONDOR] = {0};
+	double compensated_error[NUM_CHANNELS_KOMONDOR] = {0};
+	double recomputed[NUM_CHANNELS_KOMONDOR] = {0};
+	double recomputed_error[NUM_CHANNELS_KOMONDOR] = {0};
+	double *compensated_ptr (compensated), *recomputed_ptr (recomputed);
+	int num_updates (0);
+	double max_error_plain (0), max_error_compensated (0), max_error_recomputed (0);
+
+	for(int e = -1; e < NUM_EVENTS; ++e){
+
+		int s (e < 0 ? 0 : 1 + (int) (drand48() * (NUM_SOURCES - 1)));
+		int update_type (active[s] ? TX_FINISHED : TX_INITIATED);
+		active[s] = !active[s];
+
+		// Plain additions (before the compensated summation)
+		double total_power[NUM_CHANNELS_KOMONDOR];
+		PowerPerChannel(notifications[s], pw_received[s], total_power);
+		for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
+			if(update_type == TX_INITIATED) {
+				plain[c] = plain[c] + total_power[c];
+			} else {
+				double remaining (plain[c] - total_power[c]);
+				plain[c] = (remaining < 0.000001) ? 0 : remaining;
+			}
+		}
+
+		// Compensated summation, with and without the recomputation of the nodes
+		UpdateChannelsPower(&compensated_ptr, compensated_error, notifications[s], update_type,
+			5, 0, ADJACENT_CHANNEL_BOUNDARY, pw_received[s], 0);
+		UpdateChannelsPower(&recomputed_ptr, recomputed_error, notifications[s], update_type,
+			5, 0, ADJACENT_CHANNEL_BOUNDARY, pw_received[s], 0);
+		++num_updates;
+		if(update_type == TX_FINISHED && num_updates >= CHANNEL_POWER_RECOMPUTE_UPDATES) {
+			for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
+				recomputed[c] = 0;
+				recomputed_error[c] = 0;
+			}
+			for(int t = 0; t < NUM_SOURCES; ++t){
+				if(active[t]) UpdateChannelsPower(&recomputed_ptr, recomputed_error, notifications[t], TX_INITIATED,
+					5, 0, ADJACENT_CHANNEL_BOUNDARY, pw_received[t], 0);
+			}
+			num_updates = 0;
+		}
+
+		// Exact sum of the transmissions sensed
+		if(e % CHECK_INTERVAL == 0) {
+			long double exact[NUM_CHANNELS_KOMONDOR] = {0};
+			for(int t = 0; t < NUM_SOURCES; ++t){
+				if(active[t]) {
+					PowerPerChannel(notifications[t], pw_received[t], total_power);
+					for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c) exact[c] += total_power[c];
+				}
+			}
+			for(int c = 0; c < NUM_CHANNELS_KOMONDOR; ++c){
+				if(exact[c] > 0) {
+					max_error_plain = std::max(max_error_plain, (double) (fabsl(plain[c] - exact[c]) / exact[c]));
+					max_error_compensated = std::max(max_error_compensated,
+						(double) (fabsl(compensated[c] - exact[c]) / exact[c]));
+					max_error_recomputed = std::max(max_error_recomputed,
+						(double) (fabsl(recomputed[c] - exact[c]) / exact[c]));
+				}
+			}
+		}
+	}
+
+	printf("max relative error, plain additions:           %g\n", max_error_plain);
+	printf("max relative error, compensated summation:     %g\n", max_error_compensated);
+	printf("max relative error, compensated + recomputed:  %g\n", max_error_recomputed);
+
+	if(max_error_recomputed > MAX_RELATIVE_ERROR) {
+		printf("FAILED: the recomputed power is off by more than %g\n", MAX_RELATIVE_ERROR);
+		return 1;
+	}
+	printf("PASSED\n");
+	return 0;
+}
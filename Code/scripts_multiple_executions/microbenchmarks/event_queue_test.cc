@@ -0,0 +1,124 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+/**
+ * event_queue_test.cc: order of the simultaneous events in every event queue backend
+ *
+ * - Enqueues bursts of events with the same time (as the receivers of one transmission or slot aligned
+ *   backoffs), with some deletions, and dequeues them from every backend of SelectableQueue.
+ * - The test fails if a backend does not take the events out in (time, insertion order), the order of
+ *   the simple queue.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "../../COST/priority_q.h"
+
+#define NUM_EVENTS	20000	///> Events enqueued in each backend
+#define NUM_TIMES	500		///> Different times (about NUM_EVENTS / NUM_TIMES events share each one)
+
+// Event with the fields the queues use (as CostEvent)
+struct TestEvent
+{
+	typedef long long time_type;
+	long long time;
+	TestEvent *next;
+	union {
+		TestEvent *prev;
+		int pos;
+	};
+	int bucket;
+	unsigned long long seq;
+	int id;		///> Order in which the event was enqueued
+};
+
+int main(){
+
+	const char *backends[] = {"simple", "heap", "dary", "calendar", "ladder"};
+	int failures (0);
+
+	for(int b = 0; b < 5; ++b){
+
+		SelectableQueue<TestEvent> queue;
+		queue.Select(backends[b]);
+		std::vector<TestEvent> events(NUM_EVENTS);
+		std::vector<int> deleted(NUM_EVENTS, 0);
+		srand48(1992);
+		for(int i = 0; i < NUM_EVENTS; ++i){
+			events[i].time = 1000 * (long long) (drand48() * NUM_TIMES);
+			events[i].id = i;
+			queue.EnQueue(&events[i]);
+			// Cancel some of the pending events (timers reset before they expire)
+			if(i % 7 == 6) {
+				int j (i - 1 - (int) (drand48() * 6));
+				if(!deleted[j]) {
+					queue.Delete(&events[j]);
+					deleted[j] = 1;
+				}
+			}
+		}
+
+		int num_dequeued (0);
+		int ordered (1);
+		TestEvent *last (NULL);
+		TestEvent *event;
+		while((event = queue.DeQueue()) != NULL){
+			if(last != NULL && (event->time < last->time || (event->time == last->time && event->id < last->id))) ordered = 0;
+			last = event;
+			++num_dequeued;
+		}
+		int num_expected (0);
+		for(int i = 0; i < NUM_EVENTS; ++i) num_expected += !deleted[i];
+
+		printf("%-8s: %d events dequeued (%d expected), %s\n", backends[b], num_dequeued, num_expected,
+			ordered ? "in (time, insertion) order" : "OUT OF ORDER");
+		if(!ordered || num_dequeued != num_expected) ++failures;
+	}
+
+	printf("event_queue_test: %s\n", failures == 0 ? "PASSED" : "FAILED");
+	return failures;
+}
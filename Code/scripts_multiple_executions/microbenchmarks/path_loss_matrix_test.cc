@@ -0,0 +1,163 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+/**
+ * path_loss_matrix_test.cc: loading of the measured path loss matrix (CSV and binary files)
+ *
+ * - Well-formed files: a CSV file with mixed separators, CR line ends, blank lines, and empty and
+ *   "nan" fields, and a binary file of the right size. Every entry must hold the value written.
+ * - Malformed files: a malformed field, too many or too few rows and columns, and a short binary
+ *   file. The loader exits, so each one is loaded in a child process that must fail with the
+ *   expected message.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "../../structures/path_loss_matrix.h"
+
+#define NUM_NODES	3	///> Nodes (rows and columns) of the matrices
+
+int failures (0);
+
+// Writes the contents to a new temporary file with the given extension and returns its name
+std::string WriteTempFile(const char *extension, const void *contents, size_t size){
+	char filename[64];
+	snprintf(filename, sizeof(filename), "/tmp/path_loss_matrix_test_XXXXXX%s", extension);
+	int fd (mkstemps(filename, strlen(extension)));
+	if(fd < 0 || write(fd, contents, size) != (ssize_t) size) {
+		printf("ERROR: temporary file '%s' could not be written\n", filename);
+		exit(-1);
+	}
+	close(fd);
+	return filename;
+}
+
+std::string WriteTempCsv(const char *contents){
+	return WriteTempFile(".csv", contents, strlen(contents));
+}
+
+// Checks every entry of a loaded matrix against the expected values (NAN: missing link)
+void CheckValues(const char *name, const std::string &filename, const float *expected){
+	PathLossMatrix matrix;
+	matrix.LoadPathLossMatrix(filename.c_str(), NUM_NODES);
+	int correct (1);
+	for(int rx = 0; rx < NUM_NODES; ++rx){
+		for(int tx = 0; tx < NUM_NODES; ++tx){
+			float value (matrix.PathLoss(rx, tx));
+			float expected_value (expected[rx * NUM_NODES + tx]);
+			if(isnan(expected_value) ? !isnan(value) : value != expected_value) {
+				printf("  (%d, %d): %f (%f expected)\n", rx, tx, value, expected_value);
+				correct = 0;
+			}
+		}
+	}
+	printf("%-24s: %s\n", name, correct ? "loaded" : "WRONG VALUES");
+	if(!correct) ++failures;
+	unlink(filename.c_str());
+}
+
+// Loads a malformed matrix in a child process, which must exit with the expected error message
+void CheckError(const char *name, const std::string &filename, const char *expected_message){
+	int pipe_fd[2];
+	if(pipe(pipe_fd) != 0) {
+		printf("ERROR: pipe could not be created\n");
+		exit(-1);
+	}
+	fflush(stdout);
+	pid_t pid (fork());
+	if(pid == 0) {
+		dup2(pipe_fd[1], STDOUT_FILENO);
+		close(pipe_fd[0]);
+		PathLossMatrix matrix;
+		matrix.LoadPathLossMatrix(filename.c_str(), NUM_NODES);
+		_exit(0);
+	}
+	close(pipe_fd[1]);
+	std::string output;
+	char buffer[256];
+	ssize_t bytes;
+	while((bytes = read(pipe_fd[0], buffer, sizeof(buffer))) > 0) output.append(buffer, bytes);
+	close(pipe_fd[0]);
+	int status;
+	waitpid(pid, &status, 0);
+	int rejected (WIFEXITED(status) && WEXITSTATUS(status) != 0 && output.find(expected_message) != std::string::npos);
+	printf("%-24s: %s\n", name, rejected ? "rejected" : "NOT REJECTED AS EXPECTED");
+	if(!rejected) {
+		printf("  output: %s", output.empty() ? "(none)\n" : output.c_str());
+		++failures;
+	}
+	unlink(filename.c_str());
+}
+
+int main(){
+
+	float expected[NUM_NODES * NUM_NODES] = {
+		70, 80.5f, 90,
+		85, NAN, NAN,
+		60, NAN, -75};
+
+	// Mixed separators, CR line ends, blank lines, blanks around the values, empty and "nan" fields
+	CheckValues("csv", WriteTempCsv("70,80.5;90\r\n\r\n\n85;;nan\r\n 60 , NaN,-75\n\n"), expected);
+	// Last line without line end
+	CheckValues("csv without last newline", WriteTempCsv("70;80.5;90\n85,,\n60;nan;-75"), expected);
+	CheckValues("bin", WriteTempFile(".bin", expected, sizeof(expected)), expected);
+
+	CheckError("malformed field", WriteTempCsv("70,80.5,90\n85,8x5,\n60,,-75\n"), "malformed value '8x5' at row 1, column 1");
+	CheckError("too many rows", WriteTempCsv("70,80,90\n85,,\n60,,-75\n1,2,3\n"), "has more than 3 rows");
+	CheckError("too few rows", WriteTempCsv("70,80,90\n\n85,,\n"), "has 2 rows (3 expected)");
+	CheckError("too many columns", WriteTempCsv("70,80,90\n85,,,\n60,,-75\n"), "has more than 3 values");
+	CheckError("too few columns", WriteTempCsv("70,80,90\n85,\n60,,-75\n"), "has 2 values (3 expected)");
+	CheckError("short bin", WriteTempFile(".bin", expected, sizeof(expected) - sizeof(float)),
+		"has 32 bytes (3 x 3 float32 expected)");
+
+	printf("path_loss_matrix_test: %s\n", failures == 0 ? "PASSED" : "FAILED");
+	return failures;
+}
@@ -0,0 +1,142 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+/**
+ * power_conversion_benchmark.cc: accuracy and speed of the fast dB/linear conversions
+ *
+ * - Compares FastDbmToPw and FastPwToDbm with the exact conversions over the powers met in the simulations
+ *   (-200 to 100 dBm) and checks the error bounds documented in power_conversion_methods.h, as well as the
+ *   values of FastExp2 out of the normal range (0 below, saturated above).
+ * - Prints the conversions per second of the exact and fast array versions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "../../methods/power_conversion_methods.h"
+
+int fast_power_conversion (FALSE);	///> Switched by this program (defined in komondor_main.cc in the simulator)
+
+#define NUM_POWERS		1000000		///> Powers of each array
+#define NUM_REPETITIONS	50			///> Conversions of each array per measurement
+#define MAX_RELATIVE_ERROR_PW	1e-8	///> Error bound of FastDbmToPw
+#define MAX_ERROR_DB			1e-8	///> Error bound of FastPwToDbm [dB]
+
+/**
+ * Return the current time of a monotonic clock
+ * @return "seconds" [type double]: time [s]
+ */
+double Now(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(){
+
+	int failures (0);
+
+	// Accuracy over -200 to 100 dBm
+	double *power_dbm = new double[NUM_POWERS];
+	double *power_pw = new double[NUM_POWERS];
+	double *converted = new double[NUM_POWERS];
+	for(int i = 0; i < NUM_POWERS; ++i){
+		power_dbm[i] = -200 + 300 * (i + 0.5) / NUM_POWERS;
+		power_pw[i] = ExactDbmToPw(power_dbm[i]);
+	}
+	double max_relative_error_pw (0), max_error_db (0);
+	for(int i = 0; i < NUM_POWERS; ++i){
+		max_relative_error_pw = fmax(max_relative_error_pw, fabs(FastDbmToPw(power_dbm[i]) - power_pw[i]) / power_pw[i]);
+		max_error_db = fmax(max_error_db, fabs(FastPwToDbm(power_pw[i]) - power_dbm[i]));
+	}
+	printf("FastDbmToPw: max relative error %g (bound %g)\n", max_relative_error_pw, MAX_RELATIVE_ERROR_PW);
+	printf("FastPwToDbm: max absolute error %g dB (bound %g dB)\n", max_error_db, MAX_ERROR_DB);
+	if(max_relative_error_pw > MAX_RELATIVE_ERROR_PW || max_error_db > MAX_ERROR_DB) {
+		printf("FAILED: error bound exceeded\n");
+		++failures;
+	}
+
+	// Out of the normal range
+	const double exponents[] = {-5000, -1100, -1022.4, 1023.4, 1100, 5000};
+	for(int i = 0; i < 6; ++i){
+		double power (FastExp2(exponents[i]));
+		int expected (exponents[i] <= -1022 ? power == 0 : (isfinite(power) && power >= ldexp(1, 1022)));
+		printf("FastExp2(%g) = %g%s\n", exponents[i], power, expected ? "" : " (FAILED)");
+		if(!expected) ++failures;
+	}
+	printf("FastPwToDbm(0) = %g, FastPwToDbm(-1) = %g\n", FastPwToDbm(0), FastPwToDbm(-1));
+	if(FastPwToDbm(0) != -INFINITY || FastPwToDbm(-1) != -INFINITY) ++failures;
+
+	// Speed of the array versions
+	const char *names[] = {"exact", "fast"};
+	for(int fast = FALSE; fast <= TRUE; ++fast){
+		fast_power_conversion = fast;
+		double checksum (0);
+		double start (Now());
+		for(int r = 0; r < NUM_REPETITIONS; ++r){
+			DbmToPwArray(power_dbm, converted, NUM_POWERS);
+			checksum += converted[r];
+		}
+		double seconds (Now() - start);
+		printf("DbmToPwArray (%s): %7.1f Mconversions/s (checksum %g)\n", names[fast],
+			(double) NUM_POWERS * NUM_REPETITIONS / seconds * 1e-6, checksum);
+		checksum = 0;
+		start = Now();
+		for(int r = 0; r < NUM_REPETITIONS; ++r){
+			PwToDbmArray(power_pw, converted, NUM_POWERS);
+			checksum += converted[r];
+		}
+		seconds = Now() - start;
+		printf("PwToDbmArray (%s): %7.1f Mconversions/s (checksum %g)\n", names[fast],
+			(double) NUM_POWERS * NUM_REPETITIONS / seconds * 1e-6, checksum);
+	}
+
+	delete[] power_dbm;
+	delete[] power_pw;
+	delete[] converted;
+	return failures;
+}
@@ -0,0 +1,119 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+
+
+/**
+ * random_stream_benchmark.cc: throughput of the random number streams
+ *
+ * - Draws from the Philox streams (words, uniforms and exponentials, the draws of the backoff and
+ *   of the traffic generators) and, as a reference, from the drand48() generator they replaced.
+ * - Prints the draws per second of each one.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "../../list_of_macros.h"
+#include "../../structures/random_stream.h"
+
+#define NUM_DRAWS	50000000	///> Draws of each measurement
+
+/**
+ * Return the current time of a monotonic clock
+ * @return "seconds" [type double]: time [s]
+ */
+double Now(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Print the throughput of a measurement
+ * @param "name" [type char*]: name of the generator
+ * @param "start" [type double]: time at which the draws started [s]
+ * @param "checksum" [type double]: sum of the draws (keeps the compiler from removing them)
+ */
+void PrintThroughput(const char *name, double start, double checksum){
+	double seconds (Now() - start);
+	printf("%-28s %8.1f Mdraws/s (%.3f s, checksum %g)\n", name, NUM_DRAWS / seconds * 1e-6, seconds, checksum);
+}
+
+int main(){
+
+	RandomStream stream;
+	stream.Initialize(1992, 0, RNG_STREAM_BACKOFF);
+	double checksum (0);
+	double start (Now());
+	for(int i = 0; i < NUM_DRAWS; ++i) checksum += stream.NextWord();
+	PrintThroughput("RandomStream::NextWord", start, checksum);
+
+	checksum = 0;
+	start = Now();
+	for(int i = 0; i < NUM_DRAWS; ++i) checksum += stream.Uniform();
+	PrintThroughput("RandomStream::Uniform", start, checksum);
+
+	checksum = 0;
+	start = Now();
+	for(int i = 0; i < NUM_DRAWS; ++i) checksum += stream.Exponential(1.0);
+	PrintThroughput("RandomStream::Exponential", start, checksum);
+
+	// Reference: the global generator used before the streams
+	srand48(1992);
+	checksum = 0;
+	start = Now();
+	for(int i = 0; i < NUM_DRAWS; ++i) checksum += drand48();
+	PrintThroughput("drand48", start, checksum);
+
+	checksum = 0;
+	start = Now();
+	for(int i = 0; i < NUM_DRAWS; ++i) checksum += -log(drand48());
+	PrintThroughput("drand48 exponential", start, checksum);
+
+	return 0;
+}
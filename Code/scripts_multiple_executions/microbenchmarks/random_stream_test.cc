@@ -0,0 +1,139 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+
+
+/**
+ * random_stream_test.cc: checks that the random number streams are reproducible
+ *
+ * - Every node draws from its own streams. The sequence of each stream must be the same whatever
+ *   the order in which the nodes draw (one node after the other, randomly interleaved, or with
+ *   some nodes drawing extra numbers from their other streams), and it must change with the seed.
+ * - Returns 0 if all the checks pass.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+
+#include "../../list_of_macros.h"
+#include "../../structures/random_stream.h"
+
+#define NUM_NODES	64		///> Number of nodes drawing numbers
+#define NUM_DRAWS	2000	///> Numbers drawn by each node from its backoff stream
+#define SEED		1992	///> Simulation seed
+
+/**
+ * Draw the backoff sequences of all the nodes in a given order
+ * @param "seed" [type int]: simulation seed
+ * @param "order" [type std::vector<int>]: node drawing at each step
+ * @param "extra_draws" [type int]: flag for drawing from the traffic stream in between
+ * @return "sequences" [type std::vector<std::vector<double>>]: sequence drawn by each node
+ */
+std::vector< std::vector<double> > DrawSequences(int seed, const std::vector<int> &order, int extra_draws){
+	std::vector<RandomStream> backoff(NUM_NODES), traffic(NUM_NODES);
+	for(int n = 0; n < NUM_NODES; ++n){
+		backoff[n].Initialize(seed, n, RNG_STREAM_BACKOFF);
+		traffic[n].Initialize(seed, n, RNG_STREAM_TRAFFIC);
+	}
+	std::vector< std::vector<double> > sequences(NUM_NODES);
+	for(size_t i = 0; i < order.size(); ++i){
+		int n (order[i]);
+		if(extra_draws && (i % 3 == 0)) traffic[n].Exponential(0.01);
+		sequences[n].push_back(backoff[n].Uniform());
+	}
+	return sequences;
+}
+
+int main(){
+
+	int failures (0);
+
+	// Reference: each node draws all its numbers, one node after the other
+	std::vector<int> sequential;
+	for(int n = 0; n < NUM_NODES; ++n) sequential.insert(sequential.end(), NUM_DRAWS, n);
+	std::vector< std::vector<double> > reference (DrawSequences(SEED, sequential, FALSE));
+
+	// Same draws, randomly interleaved among the nodes
+	std::vector<int> interleaved (sequential);
+	srand(1);
+	for(int i = (int) interleaved.size() - 1; i > 0; --i) std::swap(interleaved[i], interleaved[rand() % (i + 1)]);
+	if(DrawSequences(SEED, interleaved, FALSE) != reference){
+		printf("FAILED: the sequences depend on the order in which the nodes draw\n");
+		++failures;
+	}
+	// Extra draws from other streams do not shift the sequences
+	if(DrawSequences(SEED, interleaved, TRUE) != reference){
+		printf("FAILED: the sequences depend on the draws of the other streams\n");
+		++failures;
+	}
+	// Reversed order of the nodes
+	std::vector<int> reversed (sequential.rbegin(), sequential.rend());
+	if(DrawSequences(SEED, reversed, FALSE) != reference){
+		printf("FAILED: the sequences depend on the order of the nodes\n");
+		++failures;
+	}
+	// A different seed gives different sequences, and so do different nodes
+	if(DrawSequences(SEED + 1, sequential, FALSE) == reference){
+		printf("FAILED: the sequences do not depend on the seed\n");
+		++failures;
+	}
+	if(reference[0] == reference[1]){
+		printf("FAILED: two nodes draw the same sequence\n");
+		++failures;
+	}
+	// Seeking a block reproduces its numbers
+	RandomStream stream;
+	stream.Initialize(SEED, 0, RNG_STREAM_BACKOFF);
+	stream.Seek(NUM_DRAWS / 4);
+	if(stream.Uniform() != reference[0][NUM_DRAWS / 2]){
+		printf("FAILED: seeking a block does not reproduce its numbers\n");
+		++failures;
+	}
+
+	printf("random_stream_test: %s (%d nodes x %d draws)\n", failures ? "FAILED" : "PASSED", NUM_NODES, NUM_DRAWS);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,46 @@
+# check that the parallel execution gives the same results as the serial one
+# - the interference radius splits the scenario into interference islands (WLANs 10 m apart), which
+#   run in 2 and 3 threads
+# - the serial run (1 thread) keeps all the nodes in a single island, as without islands
+SIM_TIME=10
+SEED=1992
+ISLAND_THREADS=(1 2 3)
+INTERFERENCE_RADIUS=5
+INPUT_FOLDER=input/validation/complex_scenarios
+INPUT_FILE=input_nodes_scenario_2d.csv
+# compile KOMONDOR
+cd ..
+cd main
+./build_local
+echo 'CHECKING THE PARALLEL EXECUTION... '
+cd ..
+# remove old script output file and node logs
+rm output/*
+
+cd main
+for threads in "${ISLAND_THREADS[@]}"
+do
+	echo "- EXECUTING $INPUT_FILE IN $threads THREADS"
+	./komondor_main ../$INPUT_FOLDER/$INPUT_FILE ../output/script_output_th$threads.txt sim_th$threads 0 0 0 $SIM_TIME $SEED --island_threads=$threads --interference_radius=$INTERFERENCE_RADIUS > ../output/logs_console_th$threads.txt
+done
+
+# compare the results (the simulation codes differ)
+cd ..
+cd output
+result=0
+for threads in "${ISLAND_THREADS[@]}"
+do
+	grep "KOMONDOR SIMULATION" script_output_th$threads.txt | sed -E "s/'[^']*'//" > results_th$threads.txt
+	if ! diff -q results_th1.txt results_th$threads.txt > /dev/null; then
+		echo "FAILED: the results with $threads threads differ from the serial ones"
+		result=1
+	fi
+done
+if [ $(wc -l < results_th1.txt) -ne 1 ]; then
+	echo "FAILED: no serial result found"
+	result=1
+fi
+echo ""
+if [ $result -eq 0 ]; then echo 'SCRIPT FINISHED: SERIAL AND PARALLEL RESULTS MATCH'; else echo 'SCRIPT FINISHED: SERIAL AND PARALLEL RESULTS DIFFER'; fi
+echo ""
+exit $result
@@ -0,0 +1,55 @@
+# check that the simulations are reproducible: the same seed gives the same script output
+# - every seed is simulated twice, one simulation after the other
+# - the same seeds are simulated again as replications on several threads, so that the random
+#   draws of the replications interleave (each node draws from its own streams)
+SIM_TIME=10
+SEED=1992
+NUM_REPLICATIONS=4
+INPUT_FOLDER=input/validation/complex_scenarios
+INPUT_FILE=input_nodes_scenario_2a.csv
+# compile KOMONDOR
+cd ..
+cd main
+./build_local
+echo 'CHECKING THE REPRODUCIBILITY OF THE SIMULATIONS... '
+cd ..
+# remove old script output file and node logs
+rm output/*
+
+cd main
+for run in a b
+do
+	for (( replication_ix=0; replication_ix < NUM_REPLICATIONS; replication_ix++))
+	do
+		seed=$(( SEED + replication_ix ))
+		echo "- EXECUTING $INPUT_FILE WITH SEED $seed (RUN $run)"
+		./komondor_main ../$INPUT_FOLDER/$INPUT_FILE ../output/script_output_$run.txt sim_${run}_$seed 0 0 0 $SIM_TIME $seed > /dev/null
+	done
+done
+echo "- EXECUTING $INPUT_FILE WITH $NUM_REPLICATIONS REPLICATIONS ON $NUM_REPLICATIONS THREADS"
+./komondor_main ../$INPUT_FOLDER/$INPUT_FILE ../output/script_output_replications.txt sim 0 0 0 $SIM_TIME $SEED --replications=$NUM_REPLICATIONS --threads=$NUM_REPLICATIONS > /dev/null
+
+# compare the results of each seed (the simulation codes differ, and the replications finish in any order)
+cd ..
+cd output
+for run in a b replications
+do
+	grep "KOMONDOR SIMULATION" script_output_$run.txt | sed -E "s/'[^']*'//" | sort > results_$run.txt
+done
+result=0
+if ! diff -q results_a.txt results_b.txt > /dev/null; then
+	echo "FAILED: two simulations with the same seed differ"
+	result=1
+fi
+if ! diff -q results_a.txt results_replications.txt > /dev/null; then
+	echo "FAILED: the replications differ from the simulations with the same seeds"
+	result=1
+fi
+if [ $(wc -l < results_a.txt) -ne $NUM_REPLICATIONS ]; then
+	echo "FAILED: $(wc -l < results_a.txt) results found ($NUM_REPLICATIONS expected)"
+	result=1
+fi
+echo ""
+if [ $result -eq 0 ]; then echo 'SCRIPT FINISHED: SIMULATIONS REPRODUCIBLE'; else echo 'SCRIPT FINISHED: SIMULATIONS NOT REPRODUCIBLE'; fi
+echo ""
+exit $result
@@ -0,0 +1,62 @@
+# check that the memory of a long simulation does not grow with the simulated time
+# - the nodes aggregate up to 64 packets per frame, so the packet buffers are always full
+# - the resident set size (VmRSS) is sampled every second while the simulation runs
+# - the largest sample of the second half of the run must stay within MAX_GROWTH_PERCENT of
+#   the largest sample of the first half (the buffers reach their size during the warm-up)
+SIM_TIME=500
+SEED=1992
+NUM_PACKETS_AGGREGATED=64
+MAX_GROWTH_PERCENT=10
+MIN_SAMPLES=4
+INPUT_FOLDER=input/validation/complex_scenarios
+INPUT_FILE=input_nodes_scenario_2a.csv
+# compile KOMONDOR
+cd ..
+cd main
+./build_local
+echo 'CHECKING THE MEMORY OF A LONG SIMULATION... '
+cd ..
+# remove old script output file and node logs
+rm output/*
+
+# input with A-MPDUs (num_packets_aggregated column)
+awk -F';' -v OFS=';' -v n=$NUM_PACKETS_AGGREGATED 'NR > 1 {$17 = n} {print}' \
+	$INPUT_FOLDER/$INPUT_FILE > output/input_nodes_ampdu.csv
+
+cd main
+echo "- EXECUTING $INPUT_FILE UNTIL $SIM_TIME s"
+./komondor_main ../output/input_nodes_ampdu.csv ../output/script_output.txt rss 0 0 0 $SIM_TIME $SEED > /dev/null &
+pid=$!
+while kill -0 $pid 2> /dev/null
+do
+	grep VmRSS /proc/$pid/status 2> /dev/null | awk '{print $2}' >> ../output/rss_samples.txt
+	sleep 1
+done
+wait $pid
+status=$?
+
+cd ..
+cd output
+result=0
+if [ $status -ne 0 ]; then
+	echo "FAILED: the simulation exited with status $status"
+	result=1
+fi
+num_samples=$(wc -l < rss_samples.txt)
+if [ $num_samples -lt $MIN_SAMPLES ]; then
+	echo "FAILED: $num_samples samples of the memory taken ($MIN_SAMPLES needed, increase SIM_TIME)"
+	result=1
+else
+	half=$(( num_samples / 2 ))
+	rss_first=$(head -n $half rss_samples.txt | sort -n | tail -n 1)
+	rss_second=$(tail -n +$(( half + 1 )) rss_samples.txt | sort -n | tail -n 1)
+	echo "- MAXIMUM RSS: $rss_first kB (first half), $rss_second kB (second half), $num_samples samples"
+	if [ $(( rss_second * 100 )) -gt $(( rss_first * (100 + MAX_GROWTH_PERCENT) )) ]; then
+		echo "FAILED: the memory grew more than $MAX_GROWTH_PERCENT % in the second half of the simulation"
+		result=1
+	fi
+fi
+echo ""
+if [ $result -eq 0 ]; then echo 'SCRIPT FINISHED: MEMORY BOUNDED'; else echo 'SCRIPT FINISHED: MEMORY GROWING'; fi
+echo ""
+exit $result
@@ -0,0 +1,66 @@
+# check that a snapshot only carries the state of the simulation, not its inputs
+# - the scenario runs with Poisson traffic and a snapshot is saved half-way
+# - resuming the snapshot with the same input gives the result of the uninterrupted simulation
+# - resuming it with a lower traffic load gives a lower throughput (the new load takes effect)
+SIM_TIME=10
+SNAPSHOT_TIME=5
+SEED=1992
+TRAFFIC_LOAD=1000
+LOW_TRAFFIC_LOAD=50
+INPUT_FOLDER=input/validation/complex_scenarios
+INPUT_FILE=input_nodes_scenario_2a.csv
+# compile KOMONDOR
+cd ..
+cd main
+./build_local
+echo 'CHECKING THE INPUTS OF THE RESUMED SIMULATIONS... '
+cd ..
+# remove old script output file and node logs
+rm output/*
+
+# inputs with Poisson traffic (traffic_model and traffic_load(pkts/s) columns) at both loads
+awk -F';' -v OFS=';' -v load=$TRAFFIC_LOAD 'NR > 1 && $15 > 0 {$14 = 1; $15 = load} {print}' \
+	$INPUT_FOLDER/$INPUT_FILE > output/input_nodes_base.csv
+awk -F';' -v OFS=';' -v load=$LOW_TRAFFIC_LOAD 'NR > 1 && $15 > 0 {$14 = 1; $15 = load} {print}' \
+	$INPUT_FOLDER/$INPUT_FILE > output/input_nodes_low.csv
+
+cd main
+echo "- EXECUTING $INPUT_FILE UNTIL $SIM_TIME s"
+./komondor_main ../output/input_nodes_base.csv ../output/script_output_full.txt full 0 0 0 $SIM_TIME $SEED > /dev/null
+echo "- EXECUTING $INPUT_FILE AND SAVING A SNAPSHOT AT $SNAPSHOT_TIME s"
+./komondor_main ../output/input_nodes_base.csv ../output/script_output_saved.txt saved 0 0 0 $SIM_TIME $SEED \
+	--save_snapshot=../output/snapshot.bin --snapshot_time=$SNAPSHOT_TIME > /dev/null
+echo "- RESUMING THE SNAPSHOT WITH THE SAME INPUT"
+./komondor_main ../output/input_nodes_base.csv ../output/script_output_resumed.txt resumed 0 0 0 $SIM_TIME $SEED \
+	--load_snapshot=../output/snapshot.bin > /dev/null
+echo "- RESUMING THE SNAPSHOT WITH A TRAFFIC LOAD OF $LOW_TRAFFIC_LOAD pkts/s"
+./komondor_main ../output/input_nodes_low.csv ../output/script_output_low.txt low 0 0 0 $SIM_TIME $SEED \
+	--load_snapshot=../output/snapshot.bin > /dev/null
+
+# compare the results (the simulation codes differ)
+cd ..
+cd output
+for run in full resumed low
+do
+	grep "KOMONDOR SIMULATION" script_output_$run.txt | sed -E "s/'[^']*'//" > results_$run.txt
+done
+result=0
+if [ $(wc -l < results_full.txt) -ne 1 ] || [ $(wc -l < results_low.txt) -ne 1 ]; then
+	echo "FAILED: a simulation did not finish"
+	result=1
+fi
+if ! diff -q results_full.txt results_resumed.txt > /dev/null; then
+	echo "FAILED: the resumed simulation differs from the uninterrupted one"
+	result=1
+fi
+# the first field after the seed is the throughput of the first AP [Mbps]
+throughput_full=$(cut -d';' -f2 results_full.txt)
+throughput_low=$(cut -d';' -f2 results_low.txt)
+if ! awk -v full="$throughput_full" -v low="$throughput_low" 'BEGIN {exit !(low < full)}'; then
+	echo "FAILED: the throughput with the lower traffic load ($throughput_low Mbps) is not below $throughput_full Mbps"
+	result=1
+fi
+echo ""
+if [ $result -eq 0 ]; then echo 'SCRIPT FINISHED: SNAPSHOTS KEEP THE NEW INPUTS'; else echo 'SCRIPT FINISHED: SNAPSHOTS OVERRIDE THE INPUTS'; fi
+echo ""
+exit $result
@@ -1,65 +1,130 @@
+#include "../list_of_macros.h"
 #include "notification.h"
-#include <deque>
+#include "../COST/snapshot.h"
+#include <vector>
 
 /*
-	FIFO Class
+	Packet descriptor: what the buffer keeps of each frame waiting to be transmitted (the
+	notifications of an A-MPDU are built from the first one and the number of frames aggregated)
+*/
+
+struct Packet
+{
+		int packet_id;				///> Packet identifier
+		double timestamp_generated;	///> Timestamp when the packet was generated
+
+		void Checkpoint(CostSnapshot &snapshot);
+};
+
+void Packet :: Checkpoint(CostSnapshot &snapshot)
+{
+	snapshot.Value(packet_id);
+	snapshot.Value(timestamp_generated);
+};
+
+/*
+	FIFO Class: ring of packet descriptors. Its slots are recycled when the frames are acknowledged,
+	and it only grows (doubling) when the queue is larger than ever before
 */
 
 struct FIFO
-{	
-		std::deque <Notification> m_queue;
-		
+{
+		std::vector <Packet> m_ring;	///> Slots of the ring
+		int m_head;						///> Slot of the first packet
+
 		int queue_size;
 
-		Notification GetFirstPacket();
-		Notification GetPacketAt(int n);
-		void DelFirstPacket();		
+		FIFO() : m_ring(PACKET_BUFFER_SIZE), m_head(0), queue_size(0) {}
+
+		const Packet &GetFirstPacket();
+		const Packet &GetPacketAt(int n);
+		void DelFirstPacket();
 		void DeletePacketIn(int i);
-		void PutPacket(Notification &packet);
-		void PutPacketFront(Notification &packet);
-		void PutPacketIn(Notification &packet, int);
+		void PutPacket(const Packet &packet);
+		void PutPacketFront(const Packet &packet);
+		void PutPacketIn(const Packet &packet, int);
 		int QueueSize();
+		void Checkpoint(CostSnapshot &snapshot);
+
+	private:
+
+		int Slot(int n);
+		void Grow();
 };
 
-Notification FIFO :: GetFirstPacket()
+int FIFO :: Slot(int n)
 {
-	return(m_queue.front());	
-}; 
+	return((m_head + n) % m_ring.size());
+};
 
-Notification FIFO :: GetPacketAt(int n)
+void FIFO :: Grow()
 {
-	return(m_queue.at(n));	
-}; 
+	std::vector <Packet> ring(2 * m_ring.size());
+	for(int i = 0; i < queue_size; ++i) ring[i] = m_ring[Slot(i)];
+	m_ring.swap(ring);
+	m_head = 0;
+};
+
+const Packet &FIFO :: GetFirstPacket()
+{
+	return(m_ring[m_head]);
+};
+
+const Packet &FIFO :: GetPacketAt(int n)
+{
+	return(m_ring[Slot(n)]);
+};
 
 
 void FIFO :: DelFirstPacket()
 {
-	m_queue.pop_front();
-}; 
+	m_head = Slot(1);
+	--queue_size;
+};
 
-void FIFO :: PutPacket(Notification &packet)
-{	
-	m_queue.push_back(packet);
-}; 
+void FIFO :: PutPacket(const Packet &packet)
+{
+	if(queue_size == (int) m_ring.size()) Grow();
+	m_ring[Slot(queue_size)] = packet;
+	++queue_size;
+};
 
-void FIFO :: PutPacketFront(Notification &packet)
-{	
-	m_queue.push_front(packet);
-}; 
+void FIFO :: PutPacketFront(const Packet &packet)
+{
+	if(queue_size == (int) m_ring.size()) Grow();
+	m_head = Slot(m_ring.size() - 1);
+	m_ring[m_head] = packet;
+	++queue_size;
+};
 
 int FIFO :: QueueSize()
 {
-	return(m_queue.size());
-}; 
+	return(queue_size);
+};
 
-void FIFO :: PutPacketIn(Notification & packet,int i)
+void FIFO :: PutPacketIn(const Packet & packet,int i)
 {
-	m_queue.insert(m_queue.begin()+i,packet);
-}; 
+	PutPacket(packet);
+	for(int j = queue_size - 1; j > i; --j) m_ring[Slot(j)] = m_ring[Slot(j - 1)];
+	m_ring[Slot(i)] = packet;
+};
 
 void FIFO :: DeletePacketIn(int i)
 {
-	m_queue.erase(m_queue.begin()+i);
+	for(int j = i; j < queue_size - 1; ++j) m_ring[Slot(j)] = m_ring[Slot(j + 1)];
+	--queue_size;
 };
 
-
+void FIFO :: Checkpoint(CostSnapshot &snapshot)
+{
+	// The packets are saved in queue order (the capacity of the ring is not saved)
+	int num_packets (queue_size);
+	snapshot.Value(num_packets);
+	if(snapshot.Loading()) {
+		m_head = 0;
+		queue_size = 0;
+		Packet packet;
+		for(int i = 0; i < num_packets; ++i) PutPacket(packet);
+	}
+	for(int i = 0; i < queue_size; ++i) m_ring[Slot(i)].Checkpoint(snapshot);
+};
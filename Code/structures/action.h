@@ -49,6 +49,7 @@
 
 #include "../list_of_macros.h"
 #include "logger.h"
+#include "performance.h"
 
 #ifndef _AUX_ACTION_
 #define _AUX_ACTION_
@@ -153,6 +154,20 @@ struct Action
         LOGS(save_logs, logger.file, "%.15f;%s;%s;%s average_reward_since_last_request = %f\n", sim_time, string_device, LOG_C03, LOG_LVL3, average_reward_since_last_cc_request);
     }
 
+    /**
+     * Save or load the statistics of the action (its configuration is rebuilt from the input)
+     * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+     */
+    void Checkpoint(CostSnapshot &snapshot) {
+        snapshot.Value(instantaneous_reward);
+        snapshot.Value(cumulative_reward);
+        snapshot.Value(times_played);
+        performance_since_last_cc_request.Checkpoint(snapshot);
+        snapshot.Value(cumulative_reward_since_last_cc_request);
+        snapshot.Value(times_played_since_last_cc_request);
+        snapshot.Value(average_reward_since_last_cc_request);
+    }
+
 };
 
 #endif
@@ -0,0 +1,251 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+
+
+/**
+ * active_transmitters.h: this file defines the set of ACTIVE TRANSMITTERS sensed by a node
+ *
+ * - Sparse set keyed by source id: the active sources and the power received from them are kept
+ *   packed in two arrays, and a small hash table (open addressing with linear probing) maps each
+ *   active source id to its slot. The table is sized by the number of concurrent transmissions
+ *   sensed, not by the number of nodes of the scenario. Set, erase and lookup are O(1) and never
+ *   allocate once the arrays reached the number of concurrent transmissions sensed.
+ * - Erasing moves the last active source to the freed slot, so the packed order is not the id order.
+ */
+
+#ifndef _AUX_ACTIVE_TRANSMITTERS_
+#define _AUX_ACTIVE_TRANSMITTERS_
+
+#include <vector>
+#include "../COST/snapshot.h"
+
+// Active transmitters info
+struct ActiveTransmitters
+{
+	enum {
+		NO_SLOT = -1,				///> Slot of an empty bucket
+		NO_SOURCE = -1,				///> Source id of an empty bucket
+		INITIAL_BUCKETS_LOG2 = 4	///> Log2 of the initial number of buckets (16)
+	};
+
+	std::vector<int> bucket_source;		///> Source id of each bucket of the hash table (NO_SOURCE if empty)
+	std::vector<int> bucket_slot;		///> Slot in the packed arrays of the source of each bucket
+	int buckets_log2;					///> Log2 of the number of buckets
+	std::vector<int> sources;			///> Packed ids of the active sources
+	std::vector<double> power;			///> Packed power received from each active source [pW]
+
+	/**
+	 * Leave the set empty, with the initial hash table
+	 */
+	void InitializeActiveTransmitters(){
+		buckets_log2 = INITIAL_BUCKETS_LOG2;
+		bucket_source.assign(1 << buckets_log2, NO_SOURCE);
+		bucket_slot.assign(1 << buckets_log2, NO_SLOT);
+		sources.clear();
+		power.clear();
+	}
+
+	/**
+	 * Insert a source or update the power received from it
+	 * @param "source" [type int]: source id
+	 * @param "pw_received" [type double]: power received [pW]
+	 */
+	void Set(int source, double pw_received){
+		int bucket (Find(source));
+		if(bucket_source[bucket] == NO_SOURCE) {
+			// Keep the table at most half full
+			if(2 * (sources.size() + 1) > bucket_source.size()) {
+				Rehash(buckets_log2 + 1);
+				bucket = Find(source);
+			}
+			bucket_source[bucket] = source;
+			bucket_slot[bucket] = sources.size();
+			sources.push_back(source);
+			power.push_back(pw_received);
+		} else {
+			power[bucket_slot[bucket]] = pw_received;
+		}
+	}
+
+	/**
+	 * Remove a source (nothing is done if it is not active)
+	 * @param "source" [type int]: source id
+	 */
+	void Erase(int source){
+		int bucket (Find(source));
+		if(bucket_source[bucket] == NO_SOURCE) return;
+		int slot (bucket_slot[bucket]);
+		RemoveBucket(bucket);
+		int last (sources.back());
+		if(last != source) {
+			sources[slot] = last;
+			power[slot] = power.back();
+			bucket_slot[Find(last)] = slot;
+		}
+		sources.pop_back();
+		power.pop_back();
+	}
+
+	/**
+	 * Power received from a source (0 if it is not active)
+	 * @param "source" [type int]: source id
+	 * @return "power" [type double]: power received [pW]
+	 */
+	double Power(int source) const {
+		int bucket (Find(source));
+		return((bucket_source[bucket] == NO_SOURCE) ? 0 : power[bucket_slot[bucket]]);
+	}
+
+	/**
+	 * Check whether a source is active
+	 * @param "source" [type int]: source id
+	 * @return "active" [type int]: TRUE if the power received from the source is in the set
+	 */
+	int IsActive(int source) const {
+		return(bucket_source[Find(source)] != NO_SOURCE);
+	}
+
+	/**
+	 * Number of active sources
+	 * @return "size" [type int]: active sources in the set
+	 */
+	int Size() const {
+		return(sources.size());
+	}
+
+	/**
+	 * Remove every source (the hash table keeps its size)
+	 */
+	void Clear(){
+		for(size_t i = 0; i < sources.size(); ++i) RemoveBucket(Find(sources[i]));
+		sources.clear();
+		power.clear();
+	}
+
+	/**
+	 * Save or load the set. The hash table is rebuilt from the packed arrays, which are saved in their order
+	 * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+	 */
+	void Checkpoint(CostSnapshot &snapshot){
+		int num_active (sources.size());
+		snapshot.Value(num_active);
+		if(snapshot.Loading()) {
+			sources.resize(num_active);
+			power.resize(num_active);
+		}
+		if(num_active > 0) {
+			snapshot.Array(&sources[0], num_active);
+			snapshot.Array(&power[0], num_active);
+		}
+		if(snapshot.Loading()) {
+			int log2 (INITIAL_BUCKETS_LOG2);
+			while((1 << log2) < 2 * num_active) ++log2;
+			Rehash(log2);
+		}
+	}
+
+	private:
+
+	/**
+	 * Home bucket of a source (Fibonacci hashing)
+	 * @param "source" [type int]: source id
+	 * @return "bucket" [type int]: first bucket probed for the source
+	 */
+	int Home(int source) const {
+		return((unsigned int) source * 2654435769u >> (32 - buckets_log2));
+	}
+
+	/**
+	 * Bucket holding a source, or the empty bucket where it would be inserted
+	 * @param "source" [type int]: source id
+	 * @return "bucket" [type int]: bucket found
+	 */
+	int Find(int source) const {
+		int mask (bucket_source.size() - 1);
+		int bucket (Home(source));
+		while(bucket_source[bucket] != NO_SOURCE && bucket_source[bucket] != source) bucket = (bucket + 1) & mask;
+		return(bucket);
+	}
+
+	/**
+	 * Empty a bucket, moving back the sources probed past it so that no probe sequence is broken
+	 * @param "bucket" [type int]: bucket to empty
+	 */
+	void RemoveBucket(int bucket){
+		int mask (bucket_source.size() - 1);
+		int next (bucket);
+		while(true) {
+			next = (next + 1) & mask;
+			if(bucket_source[next] == NO_SOURCE) break;
+			// Move the source back unless its home bucket lies cyclically in (bucket, next]
+			int home (Home(bucket_source[next]));
+			if(((next - home) & mask) >= ((next - bucket) & mask)) {
+				bucket_source[bucket] = bucket_source[next];
+				bucket_slot[bucket] = bucket_slot[next];
+				bucket = next;
+			}
+		}
+		bucket_source[bucket] = NO_SOURCE;
+		bucket_slot[bucket] = NO_SLOT;
+	}
+
+	/**
+	 * Resize the hash table and insert the active sources again
+	 * @param "log2" [type int]: log2 of the new number of buckets
+	 */
+	void Rehash(int log2){
+		buckets_log2 = log2;
+		bucket_source.assign(1 << buckets_log2, NO_SOURCE);
+		bucket_slot.assign(1 << buckets_log2, NO_SLOT);
+		for(size_t i = 0; i < sources.size(); ++i){
+			int bucket (Find(sources[i]));
+			bucket_source[bucket] = sources[i];
+			bucket_slot[bucket] = i;
+		}
+	}
+};
+
+#endif
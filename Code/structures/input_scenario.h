@@ -0,0 +1,190 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+
+
+/**
+ * input_scenario.h: this file defines the INPUT SCENARIO, i.e., the contents of the input files of
+ * a simulation (config_models, nodes and agents CSVs and measured path loss matrix)
+ *
+ * - The files are read and split into fields once. The scenario is not modified afterwards, so the
+ *   replications of a batch share it and each one builds its own nodes and agents from it.
+ * - The fields of a CSV line are split like the original GetField(): the first one ends at ';' and
+ *   the rest at ';' or the end of the line. Empty fields are skipped.
+ */
+
+#ifndef _AUX_INPUT_SCENARIO_
+#define _AUX_INPUT_SCENARIO_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "../list_of_macros.h"
+#include "path_loss_matrix.h"
+
+// Input row info
+struct InputRow
+{
+	std::vector<std::string> fields;	///> Fields of the line
+
+	/**
+	 * Split a CSV line into its fields
+	 * @param "line" [type char*]: line of the CSV
+	 */
+	void SplitInputRow(const char *line){
+		std::vector<char> buffer(line, line + strlen(line) + 1);
+		char *save_ptr;
+		fields.clear();
+		for(const char *tok = strtok_r(&buffer[0], ";", &save_ptr); tok && *tok;
+				tok = strtok_r(NULL, ";\n", &save_ptr)) {
+			fields.push_back(tok);
+		}
+	}
+
+	/**
+	 * Return a field corresponding to a given index
+	 * @param "num" [type int]: field number (index, starting at 1)
+	 * @return "field" [type char*]: field corresponding to the introduced index (NULL if missing)
+	 */
+	const char *Field(int num) const {
+		return (num >= 1 && num <= (int) fields.size()) ? fields[num - 1].c_str() : NULL;
+	}
+};
+
+// Input CSV info
+struct InputCsv
+{
+	std::vector<InputRow> rows;			///> Lines of the file after the first (informative) one
+
+	/**
+	 * Read a CSV file
+	 * @param "filename" [type char*]: CSV filename
+	 * @param "description" [type char*]: description of the file for the error messages
+	 */
+	void ReadInputCsv(const char *filename, const char *description){
+		FILE* stream = fopen(filename, "r");
+		if (!stream){
+			printf("[MAIN] ERROR: %s file %s not found!\n", description, filename);
+			exit(-1);
+		}
+		char line[CHAR_BUFFER_SIZE];
+		int first_line_skiped_flag (0);	// Flag for skipping first informative line of input file
+		rows.clear();
+		while (fgets(line, CHAR_BUFFER_SIZE, stream)){
+			if(!first_line_skiped_flag){
+				first_line_skiped_flag = 1;
+			} else {
+				rows.push_back(InputRow());
+				rows.back().SplitInputRow(line);
+			}
+		}
+		fclose(stream);
+	}
+};
+
+// Input scenario info
+struct InputScenario
+{
+	std::vector<std::string> config_values;	///> Value of each (non-comment) line of config_models, in order
+	std::string path_loss_matrix_filename;	///> Measured path loss matrix replacing the model (empty if none)
+	PathLossMatrix path_loss_matrix;		///> Measured path loss of each link (if any)
+	InputCsv nodes;							///> Nodes input CSV
+	InputCsv agents;						///> Agents input CSV (empty without agents)
+
+	/**
+	 * Read the input files of a scenario
+	 * @param "config_filename" [type char*]: system configuration filename (config_models)
+	 * @param "nodes_filename" [type char*]: filename of the nodes input CSV
+	 * @param "agents_filename" [type char*]: filename of the agents input CSV (NULL without agents)
+	 * @param "print_system_logs" [type int]: flag for activating the printing of system logs
+	 */
+	void ReadInputScenario(const char *config_filename, const char *nodes_filename,
+			const char *agents_filename, int print_system_logs){
+
+		if (print_system_logs) printf("\n%s Reading system configuration file '%s'...\n", LOG_LVL1, config_filename);
+		FILE* config_file = fopen(config_filename, "r");
+		if (!config_file){
+			printf("%s Test file '%s' not found!\n", LOG_LVL3, config_filename);
+			exit(-1);
+		}
+		char line[CHAR_BUFFER_SIZE];
+		config_values.clear();
+		while (fgets(line, CHAR_BUFFER_SIZE, config_file)){
+			// Ignore lines with comments
+			if(line[0] == '#') continue;
+			// Separate the value of the parameter from the entire line
+			char *save_ptr;
+			strtok_r(line, "=", &save_ptr);
+			const char *value (strtok_r(NULL, "=", &save_ptr));
+			config_values.push_back(value != NULL ? value : "");
+		}
+		fclose(config_file);
+		// Measured path loss matrix (optional): it replaces the path-loss model
+		path_loss_matrix_filename.clear();
+		if(config_values.size() > IX_CONFIG_PATH_LOSS_MATRIX) {
+			path_loss_matrix_filename = config_values[IX_CONFIG_PATH_LOSS_MATRIX];
+			path_loss_matrix_filename.erase(path_loss_matrix_filename.find_last_not_of(" \t\r\n") + 1);
+			if(path_loss_matrix_filename == "none") path_loss_matrix_filename.clear();
+		}
+
+		if (print_system_logs) printf("%s Reading nodes input file '%s'...\n", LOG_LVL2, nodes_filename);
+		nodes.ReadInputCsv(nodes_filename, "Nodes configuration");
+		if(agents_filename != NULL) {
+			if (print_system_logs) printf("%s Reading agents input file '%s'...\n", LOG_LVL2, agents_filename);
+			agents.ReadInputCsv(agents_filename, "Agents configuration");
+		}
+
+		// The matrix has a row and a column per node
+		if(!path_loss_matrix_filename.empty()) {
+			path_loss_matrix.LoadPathLossMatrix(path_loss_matrix_filename.c_str(), (int) nodes.rows.size());
+			if (print_system_logs) printf("%s Path loss matrix '%s' loaded\n", LOG_LVL2, path_loss_matrix_filename.c_str());
+		}
+	}
+};
+
+#endif
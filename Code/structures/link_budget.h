@@ -0,0 +1,251 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+
+
+
+/**
+ * link_budget.h: this file defines the LINK BUDGET shared by the nodes
+ *
+ * - The positions of the nodes are stored once: the distance of a pair of nodes is computed when
+ *   needed, so the symmetric distance matrix is never stored.
+ * - The power received by each node (rx) from each other node (tx) is stored as a float in dBm. The
+ *   store is dense (a row of N values per receiver) when every link is computed, or sparse (the
+ *   linked transmitters of each receiver, sorted, and their power) when the links are pruned to an
+ *   interference radius. A link not stored receives no power.
+ * - The path loss of a link is fixed (the random losses of the models come from the shadowing field),
+ *   so the power received scales with the transmission power: the stored powers correspond to the
+ *   default power of each transmitter, and a change of power only updates the scale of the transmitter
+ *   (no path loss is recomputed).
+ * - Scales are only written by the nodes receiving from the transmitter, which belong to its
+ *   interference island, so they are never shared by two threads.
+ * - The nodes access their row through a LinkBudgetView.
+ */
+
+#ifndef _AUX_LINK_BUDGET_
+#define _AUX_LINK_BUDGET_
+
+#include <math.h>
+#include <vector>
+#include <algorithm>
+#include "../list_of_macros.h"
+#include "../COST/snapshot.h"
+#include "../methods/power_conversion_methods.h"
+
+// Link budget info
+struct LinkBudget
+{
+	int num_nodes;		///> Total number of nodes
+	int sparse;			///> TRUE if only the links added at setup are stored
+
+	double *x;			///> X position of each node [m]
+	double *y;			///> Y position of each node [m]
+	double *z;			///> Z position of each node [m]
+
+	double *tx_power_default_per_node;	///> Transmission power the stored powers of each transmitter correspond to [pW]
+	double *tx_power_scale_per_node;	///> Current transmission power of each node divided by its default one
+
+	float *power_dense;							///> Dense store: power received by each node from each node (index: rx * num_nodes + tx) [dBm]
+	std::vector<int> *linked_per_node;			///> Sparse store: transmitters linked to each node, sorted
+	std::vector<float> *power_linked_per_node;	///> Sparse store: power received by each node from its linked transmitters [dBm]
+
+	/**
+	 * Allocate the link budget (the positions and the links are filled afterwards)
+	 * @param "total_nodes_number" [type int]: total number of nodes
+	 * @param "sparse_links" [type int]: TRUE to store only the links added, FALSE to store all of them
+	 */
+	void InitializeLinkBudget(int total_nodes_number, int sparse_links){
+		num_nodes = total_nodes_number;
+		sparse = sparse_links;
+		x = new double[num_nodes];
+		y = new double[num_nodes];
+		z = new double[num_nodes];
+		tx_power_default_per_node = new double[num_nodes];
+		tx_power_scale_per_node = new double[num_nodes];
+		power_dense = NULL;
+		linked_per_node = NULL;
+		power_linked_per_node = NULL;
+		if(sparse) {
+			linked_per_node = new std::vector<int>[num_nodes];
+			power_linked_per_node = new std::vector<float>[num_nodes];
+		} else {
+			power_dense = new float[(long) num_nodes * num_nodes];
+			std::fill(power_dense, power_dense + (long) num_nodes * num_nodes, -INFINITY);
+		}
+	}
+
+	/**
+	 * Set the position and the default transmission power of a node
+	 * @param "n" [type int]: node
+	 * @param "x_n" [type double]: X position [m]
+	 * @param "y_n" [type double]: Y position [m]
+	 * @param "z_n" [type double]: Z position [m]
+	 * @param "tx_power_default" [type double]: default transmission power (the one of the powers added) [pW]
+	 */
+	void SetNode(int n, double x_n, double y_n, double z_n, double tx_power_default){
+		x[n] = x_n;
+		y[n] = y_n;
+		z[n] = z_n;
+		tx_power_default_per_node[n] = tx_power_default;
+		tx_power_scale_per_node[n] = 1;
+	}
+
+	/**
+	 * Distance between two nodes (same value as ComputeDistance())
+	 * @param "n" [type int]: first node
+	 * @param "m" [type int]: second node
+	 * @return "distance" [type double]: distance [m]
+	 */
+	double Distance(int n, int m) const {
+		return sqrt((x[n] - x[m]) * (x[n] - x[m]) + (y[n] - y[m]) * (y[n] - y[m]) + (z[n] - z[m]) * (z[n] - z[m]));
+	}
+
+	/**
+	 * Find the stored power of a link
+	 * @param "rx" [type int]: receiver
+	 * @param "tx" [type int]: transmitter
+	 * @return "power" [type float*]: stored power [dBm], NULL if the link is not stored
+	 */
+	float *FindLink(int rx, int tx) const {
+		if(!sparse) return &power_dense[(long) rx * num_nodes + tx];
+		std::vector<int> &linked (linked_per_node[rx]);
+		std::vector<int>::iterator it (std::lower_bound(linked.begin(), linked.end(), tx));
+		if(it == linked.end() || *it != tx) return NULL;
+		return &power_linked_per_node[rx][it - linked.begin()];
+	}
+
+	/**
+	 * Add a link (in the sparse store, the transmitters of each receiver are added in increasing order)
+	 * @param "rx" [type int]: receiver
+	 * @param "tx" [type int]: transmitter
+	 * @param "power_pw" [type double]: power received [pW]
+	 */
+	void AddLink(int rx, int tx, double power_pw){
+		AddLinkDbm(rx, tx, (float) PwToDbm(power_pw));
+	}
+
+	/**
+	 * Add a link given its power in dBm (e.g., from a measured path loss, with no conversion)
+	 * @param "rx" [type int]: receiver
+	 * @param "tx" [type int]: transmitter
+	 * @param "power_dbm" [type float]: power received [dBm]
+	 */
+	void AddLinkDbm(int rx, int tx, float power_dbm){
+		if(sparse) {
+			linked_per_node[rx].push_back(tx);
+			power_linked_per_node[rx].push_back(power_dbm);
+		} else {
+			power_dense[(long) rx * num_nodes + tx] = power_dbm;
+		}
+	}
+
+	/**
+	 * Power received by a node from another one (0 if the link is not stored)
+	 * @param "rx" [type int]: receiver
+	 * @param "tx" [type int]: transmitter
+	 * @return "power_pw" [type double]: power received [pW]
+	 */
+	double ReceivedPower(int rx, int tx) const {
+		float *power_dbm (FindLink(rx, tx));
+		if(power_dbm == NULL) return 0;
+		return DbmToPw(*power_dbm) * tx_power_scale_per_node[tx];
+	}
+
+	/**
+	 * Update the transmission power of a node (the power received from it is scaled)
+	 * @param "tx" [type int]: transmitter
+	 * @param "tx_power" [type double]: transmission power [pW]
+	 */
+	void SetTxPower(int tx, double tx_power){
+		tx_power_scale_per_node[tx] = tx_power / tx_power_default_per_node[tx];
+	}
+
+	/**
+	 * Save or load the transmission power scales (the positions, links and powers received are rebuilt
+	 * by the setup: they are a deterministic function of the inputs and the seed)
+	 * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+	 */
+	void Checkpoint(CostSnapshot &snapshot){
+		snapshot.Array(tx_power_scale_per_node, num_nodes);
+	}
+
+};
+
+// Link budget of a node: its row of the link budget
+struct LinkBudgetView
+{
+	LinkBudget *link_budget;	///> Link budget shared by the nodes
+	int node_id;				///> Node the view belongs to
+
+	/**
+	 * Distance to another node
+	 * @param "m" [type int]: other node
+	 * @return "distance" [type double]: distance [m]
+	 */
+	double Distance(int m) const {
+		return link_budget->Distance(node_id, m);
+	}
+
+	/**
+	 * Power received from another node
+	 * @param "tx" [type int]: transmitter
+	 * @return "power_pw" [type double]: power received [pW]
+	 */
+	double ReceivedPower(int tx) const {
+		return link_budget->ReceivedPower(node_id, tx);
+	}
+
+	/**
+	 * Update the transmission power of another node
+	 * @param "tx" [type int]: transmitter
+	 * @param "tx_power" [type double]: transmission power [pW]
+	 */
+	void SetTxPower(int tx, double tx_power){
+		link_budget->SetTxPower(tx, tx_power);
+	}
+
+};
+
+#endif
@@ -0,0 +1,361 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+
+
+/**
+ * medium.h: this file defines the MEDIUM shared by the nodes
+ *
+ * - Each node subscribes to the channels it may sense (its allowed channel range). The start of a
+ *   transmission is only delivered to the subscribers of the channels it reaches (its own range
+ *   widened by the adjacent channel interference) that may sense the transmitter, plus the nodes
+ *   that always listen to it (itself, its WLAN and node 0). Its end is delivered to the same nodes.
+ * - Transmissions flagging a change in the transmission power go to every node that may sense the
+ *   transmitter, because the nodes refresh the power they receive from it with them.
+ * - A node that changes its channels re-subscribes and gets the ongoing transmissions it now senses.
+ * - The medium also holds the interference state of every node, as one array per quantity with a row
+ *   of NUM_CHANNELS_KOMONDOR values per node: the nodes work on their row instead of owning a copy,
+ *   and the set of ongoing transmissions is tracked once instead of in a flag array per node.
+ * - Nodes of different interference islands never share a subscription list, so each island is only
+ *   read and written by the thread running it.
+ */
+
+#ifndef _AUX_MEDIUM_
+#define _AUX_MEDIUM_
+
+#include <vector>
+#include <algorithm>
+#include "../list_of_macros.h"
+#include "../COST/snapshot.h"
+#include "notification.h"
+
+// Medium info
+struct Medium
+{
+	int num_nodes;							///> Total number of nodes
+	int num_islands;						///> Number of interference islands
+	int *island_per_node;					///> Interference island of each node
+
+	std::vector<int> *listeners_per_node;	///> Nodes receiving every transmission of each node, sorted (itself, its WLAN and node 0)
+	std::vector<int> *neighbors_per_node;	///> Other nodes that may sense each node if they share some channel, sorted
+	int *channel_reach_per_node;			///> Channels beyond its range reached by the adjacent channel interference of each node
+
+	std::vector<int> *subscribers_per_channel;	///> Nodes subscribed to each channel of each island (index: island * NUM_CHANNELS_KOMONDOR + channel)
+	int *min_channel_subscribed;				///> First channel each node is subscribed to
+	int *max_channel_subscribed;				///> Last channel each node is subscribed to
+
+	int *transmitting;						///> TRUE while a node is transmitting
+	Notification *ongoing_notification;		///> Ongoing transmission of each node
+	std::vector<int> *receivers_per_node;	///> Nodes the ongoing transmission of each node has been delivered to, sorted
+
+	// Interference state of the nodes (row of NUM_CHANNELS_KOMONDOR values per node)
+	double *channel_power_per_node;				///> Power sensed by each node in each channel [pW]
+	double *channel_power_compensation_per_node;	///> Rounding errors of the updates of the power sensed (compensated summation) [pW]
+	double *timestamp_channel_free_per_node;	///> Time when each channel became free for each node
+	std::vector<int> *senders_per_node;			///> Nodes whose ongoing transmission has been delivered to each node, sorted
+
+	long *mark_per_node;			///> Delivery in which a node was last marked (avoids delivering twice)
+	long *deliveries_per_island;	///> Number of deliveries computed in each island
+
+	/**
+	 * Allocate the medium (the listeners, neighbors and reach of each node are filled afterwards)
+	 * @param "total_nodes_number" [type int]: total number of nodes
+	 * @param "total_islands_number" [type int]: number of interference islands
+	 * @param "island_per_node_array" [type int*]: interference island of each node
+	 */
+	void InitializeMedium(int total_nodes_number, int total_islands_number, int *island_per_node_array){
+		num_nodes = total_nodes_number;
+		num_islands = total_islands_number;
+		island_per_node = island_per_node_array;
+		listeners_per_node = new std::vector<int>[num_nodes];
+		neighbors_per_node = new std::vector<int>[num_nodes];
+		channel_reach_per_node = new int[num_nodes];
+		subscribers_per_channel = new std::vector<int>[num_islands * NUM_CHANNELS_KOMONDOR];
+		min_channel_subscribed = new int[num_nodes];
+		max_channel_subscribed = new int[num_nodes];
+		transmitting = new int[num_nodes];
+		ongoing_notification = new Notification[num_nodes];
+		receivers_per_node = new std::vector<int>[num_nodes];
+		mark_per_node = new long[num_nodes];
+		deliveries_per_island = new long[num_islands];
+		channel_power_per_node = new double[num_nodes * NUM_CHANNELS_KOMONDOR];
+		channel_power_compensation_per_node = new double[num_nodes * NUM_CHANNELS_KOMONDOR];
+		timestamp_channel_free_per_node = new double[num_nodes * NUM_CHANNELS_KOMONDOR];
+		senders_per_node = new std::vector<int>[num_nodes];
+		for(int i = 0; i < num_nodes * NUM_CHANNELS_KOMONDOR; ++i){
+			channel_power_per_node[i] = 0;
+			channel_power_compensation_per_node[i] = 0;
+			timestamp_channel_free_per_node[i] = 0;
+		}
+		for(int n = 0; n < num_nodes; ++n){
+			channel_reach_per_node[n] = 0;
+			min_channel_subscribed[n] = NUM_CHANNELS_KOMONDOR;	// Not subscribed
+			max_channel_subscribed[n] = -1;
+			transmitting[n] = FALSE;
+			mark_per_node[n] = 0;
+		}
+		for(int i = 0; i < num_islands; ++i){
+			deliveries_per_island[i] = 0;
+		}
+	}
+
+	/**
+	 * Get the power sensed by a node per channel
+	 * @param "node_id" [type int]: node
+	 * @return "channel_power" [type double*]: row of the node (NUM_CHANNELS_KOMONDOR values) [pW]
+	 */
+	double *ChannelPower(int node_id){
+		return &channel_power_per_node[node_id * NUM_CHANNELS_KOMONDOR];
+	}
+
+	/**
+	 * Get the rounding errors of the power sensed by a node per channel
+	 * @param "node_id" [type int]: node
+	 * @return "compensation" [type double*]: row of the node (NUM_CHANNELS_KOMONDOR values) [pW]
+	 */
+	double *ChannelPowerCompensation(int node_id){
+		return &channel_power_compensation_per_node[node_id * NUM_CHANNELS_KOMONDOR];
+	}
+
+	/**
+	 * Get the times when the channels became free for a node
+	 * @param "node_id" [type int]: node
+	 * @return "timestamps" [type double*]: row of the node (NUM_CHANNELS_KOMONDOR values)
+	 */
+	double *TimestampsChannelFree(int node_id){
+		return &timestamp_channel_free_per_node[node_id * NUM_CHANNELS_KOMONDOR];
+	}
+
+	/**
+	 * Get the number of ongoing transmissions delivered to a node
+	 * @param "node_id" [type int]: node
+	 * @return "num_transmissions" [type int]: number of transmissions sensed
+	 */
+	int NumTransmissionsSensed(int node_id){
+		return senders_per_node[node_id].size();
+	}
+
+	/**
+	 * Flag the nodes whose ongoing transmission has been delivered to a node (only the node's own
+	 * list is read, so the other islands may be running meanwhile)
+	 * @param "node_id" [type int]: node
+	 * @param "transmitters_sensed" [type int*]: TRUE for each transmitter sensed (to be filled, one value per node)
+	 */
+	void GetTransmittersSensed(int node_id, int *transmitters_sensed){
+		std::fill(transmitters_sensed, transmitters_sensed + num_nodes, (int) FALSE);
+		for(size_t i = 0; i < senders_per_node[node_id].size(); ++i){
+			transmitters_sensed[senders_per_node[node_id][i]] = TRUE;
+		}
+	}
+
+	/**
+	 * Add a transmitter to the sorted list of the transmissions sensed by a node
+	 * @param "node_id" [type int]: node receiving the transmission
+	 * @param "source_id" [type int]: node transmitting
+	 */
+	void AddSender(int node_id, int source_id){
+		std::vector<int> &senders (senders_per_node[node_id]);
+		senders.insert(std::lower_bound(senders.begin(), senders.end(), source_id), source_id);
+	}
+
+	/**
+	 * Check whether a transmission of a node reaches a channel range
+	 * @param "notification" [type Notification]: transmission
+	 * @param "min_channel" [type int]: first channel of the range
+	 * @param "max_channel" [type int]: last channel of the range
+	 * @return "reaches" [type int]: TRUE if the transmission (or its adjacent channel interference) reaches the range
+	 */
+	int ReachesChannels(const Notification &notification, int min_channel, int max_channel){
+		int reach (channel_reach_per_node[notification.source_id]);
+		return (notification.left_channel - reach <= max_channel && notification.right_channel + reach >= min_channel);
+	}
+
+	/**
+	 * Move a node from the subscription lists of its previous channel range to the ones of a new range
+	 * @param "node_id" [type int]: node subscribing
+	 * @param "min_channel" [type int]: first channel sensed by the node
+	 * @param "max_channel" [type int]: last channel sensed by the node
+	 */
+	void SetSubscription(int node_id, int min_channel, int max_channel){
+
+		std::vector<int> *subscribers (&subscribers_per_channel[island_per_node[node_id] * NUM_CHANNELS_KOMONDOR]);
+
+		for(int c = min_channel_subscribed[node_id]; c <= max_channel_subscribed[node_id]; ++c){
+			subscribers[c].erase(std::lower_bound(subscribers[c].begin(), subscribers[c].end(), node_id));
+		}
+		for(int c = min_channel; c <= max_channel; ++c){
+			subscribers[c].insert(std::lower_bound(subscribers[c].begin(), subscribers[c].end(), node_id), node_id);
+		}
+		min_channel_subscribed[node_id] = min_channel;
+		max_channel_subscribed[node_id] = max_channel;
+	}
+
+	/**
+	 * Subscribe a node to a channel range (replacing its previous subscription)
+	 * @param "node_id" [type int]: node subscribing
+	 * @param "min_channel" [type int]: first channel sensed by the node
+	 * @param "max_channel" [type int]: last channel sensed by the node
+	 * @param "late_senders" [type std::vector<int>]: nodes whose ongoing transmission was not delivered to the node and now reaches it (to be filled)
+	 */
+	void Subscribe(int node_id, int min_channel, int max_channel, std::vector<int> &late_senders){
+
+		SetSubscription(node_id, min_channel, max_channel);
+
+		// The ongoing transmissions now reaching the node will also deliver their end to it
+		late_senders.clear();
+		for(size_t i = 0; i < neighbors_per_node[node_id].size(); ++i){
+			int sender (neighbors_per_node[node_id][i]);
+			std::vector<int> &receivers (receivers_per_node[sender]);
+			std::vector<int>::iterator it (std::lower_bound(receivers.begin(), receivers.end(), node_id));
+			if(transmitting[sender] && (it == receivers.end() || *it != node_id)
+				&& std::binary_search(neighbors_per_node[sender].begin(), neighbors_per_node[sender].end(), node_id)
+				&& ReachesChannels(ongoing_notification[sender], min_channel, max_channel)) {
+				receivers.insert(it, node_id);
+				AddSender(node_id, sender);
+				late_senders.push_back(sender);
+			}
+		}
+	}
+
+	/**
+	 * Register the start of a transmission and find the nodes it must be delivered to
+	 * @param "notification" [type Notification]: transmission started
+	 * @return "receivers" [type std::vector<int>]: nodes receiving the start of the transmission, sorted
+	 */
+	std::vector<int> &StartTransmission(const Notification &notification){
+
+		int source_id (notification.source_id);
+		int island (island_per_node[source_id]);
+		long delivery (++deliveries_per_island[island]);
+		long marked (2 * delivery);			// Neighbor not delivered yet
+		long delivered (2 * delivery + 1);	// Already delivered
+
+		std::vector<int> &receivers (receivers_per_node[source_id]);
+		receivers.clear();
+
+		receivers.insert(receivers.end(), listeners_per_node[source_id].begin(), listeners_per_node[source_id].end());
+		if(notification.tx_info.flag_change_in_tx_power) {
+			// The nodes refresh the power received from the source with this transmission: deliver it to every neighbor
+			receivers.insert(receivers.end(), neighbors_per_node[source_id].begin(), neighbors_per_node[source_id].end());
+		} else {
+			for(size_t i = 0; i < neighbors_per_node[source_id].size(); ++i){
+				mark_per_node[neighbors_per_node[source_id][i]] = marked;
+			}
+			int reach (channel_reach_per_node[source_id]);
+			int left_channel (std::max(0, notification.left_channel - reach));
+			int right_channel (std::min(NUM_CHANNELS_KOMONDOR - 1, notification.right_channel + reach));
+			std::vector<int> *subscribers (&subscribers_per_channel[island * NUM_CHANNELS_KOMONDOR]);
+			for(int c = left_channel; c <= right_channel; ++c){
+				for(size_t i = 0; i < subscribers[c].size(); ++i){
+					int node_id (subscribers[c][i]);
+					if(mark_per_node[node_id] == marked){
+						receivers.push_back(node_id);
+						mark_per_node[node_id] = delivered;
+					}
+				}
+			}
+		}
+
+		// Deliver in the order of the node identifiers
+		std::sort(receivers.begin(), receivers.end());
+		for(size_t i = 0; i < receivers.size(); ++i){
+			AddSender(receivers[i], source_id);
+		}
+
+		transmitting[source_id] = TRUE;
+		ongoing_notification[source_id] = notification;
+		return receivers;
+	}
+
+	/**
+	 * Register the end of a transmission and get the nodes its start was delivered to
+	 * @param "source_id" [type int]: node finishing the transmission
+	 * @param "receivers" [type std::vector<int>]: nodes receiving the end of the transmission, sorted (to be filled)
+	 */
+	void FinishTransmission(int source_id, std::vector<int> &receivers){
+		receivers.clear();
+		receivers.swap(receivers_per_node[source_id]);
+		transmitting[source_id] = FALSE;
+		for(size_t i = 0; i < receivers.size(); ++i){
+			std::vector<int> &senders (senders_per_node[receivers[i]]);
+			senders.erase(std::lower_bound(senders.begin(), senders.end(), source_id));
+		}
+	}
+
+	/**
+	 * Save or load the subscriptions and the ongoing transmissions (the listeners and neighbors are rebuilt by
+	 * Setup, the transmissions sensed by each node are rebuilt from the receivers, and each node saves its rows of
+	 * the interference state)
+	 * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+	 */
+	void Checkpoint(CostSnapshot &snapshot){
+		for(int n = 0; n < num_nodes; ++n){
+			if(snapshot.Loading()) senders_per_node[n].clear();
+		}
+		for(int n = 0; n < num_nodes; ++n){
+			int min_channel (min_channel_subscribed[n]);
+			int max_channel (max_channel_subscribed[n]);
+			snapshot.Value(min_channel);
+			snapshot.Value(max_channel);
+			if(snapshot.Loading()) SetSubscription(n, min_channel, max_channel);
+			snapshot.Value(transmitting[n]);
+			ongoing_notification[n].Checkpoint(snapshot);
+			long num_receivers (receivers_per_node[n].size());
+			snapshot.Value(num_receivers);
+			if(snapshot.Loading()) receivers_per_node[n].resize(num_receivers);
+			if(num_receivers > 0) snapshot.Array(&receivers_per_node[n][0], num_receivers);
+			if(snapshot.Loading()) {
+				for(long i = 0; i < num_receivers; ++i){
+					AddSender(receivers_per_node[n][i], n);
+				}
+			}
+		}
+		snapshot.Array(mark_per_node, num_nodes);
+		snapshot.Array(deliveries_per_island, num_islands);
+	}
+
+};
+
+#endif
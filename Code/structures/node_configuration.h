@@ -51,6 +51,7 @@
 #define _AUX_CONFIGURATION_
 
 #include "../methods/power_channel_methods.h"
+#include "../COST/snapshot.h"
 
 struct Capabilities
 {
@@ -117,6 +118,26 @@ struct Capabilities
 			sim_time, node_id, LOG_F00, LOG_LVL4, sensitivity_default, ConvertPower(PW_TO_DBM, sensitivity_default));
 	}
 
+	/**
+	 * Save or load the capabilities
+	 * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+	 */
+	void Checkpoint(CostSnapshot &snapshot){
+		snapshot.Value(node_code);
+		snapshot.Value(node_id);
+		snapshot.Value(x);
+		snapshot.Value(y);
+		snapshot.Value(z);
+		snapshot.Value(node_type);
+		snapshot.Value(primary_channel);
+		snapshot.Value(min_channel_allowed);
+		snapshot.Value(max_channel_allowed);
+		snapshot.Value(num_channels_allowed);
+		snapshot.Value(tx_power_default);
+		snapshot.Value(sensitivity_default);
+		snapshot.Value(current_max_bandwidth);
+	}
+
 };
 
 struct AgentCapabilities
@@ -152,6 +173,16 @@ struct AgentCapabilities
 		fprintf(logger.file, "%.15f;A%d;%s;%s time_betwee_requests = %f\n",
 			sim_time, agent_id,  LOG_F00, LOG_LVL4, time_between_requests);
 	}
+
+	/**
+	 * Save or load the agent's capabilities (the list of available actions is only used by the CC)
+	 * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+	 */
+	void Checkpoint(CostSnapshot &snapshot){
+		snapshot.Value(agent_id);
+		snapshot.Value(time_between_requests);
+		snapshot.Value(num_arms);
+	}
 };
 
 // Node's configuration
@@ -214,6 +245,27 @@ struct Configuration
 			sim_time, LOG_F00, LOG_LVL4, selected_max_bandwidth);
 	}
 
+	/**
+	 * Save or load the configuration
+	 * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+	 */
+	void Checkpoint(CostSnapshot &snapshot){
+		snapshot.Value(timestamp);
+		snapshot.Value(selected_primary_channel);
+		snapshot.Value(selected_pd);
+		snapshot.Value(selected_tx_power);
+		snapshot.Value(selected_max_bandwidth);
+		snapshot.Value(frame_length);
+		snapshot.Value(max_num_packets_aggregated);
+		snapshot.Value(spatial_reuse_enabled);
+		snapshot.Value(bss_color);
+		snapshot.Value(srg);
+		snapshot.Value(non_srg_obss_pd);
+		snapshot.Value(srg_obss_pd);
+		capabilities.Checkpoint(snapshot);
+		agent_capabilities.Checkpoint(snapshot);
+	}
+
 };
 
 #endif
@@ -50,13 +50,13 @@
 #ifndef _AUX_NOTIFICATION_
 #define _AUX_NOTIFICATION_
 
+#include "../COST/snapshot.h"
+
 // Notification specific info (may be not checked by the other nodes)
 struct TxInfo
 {
 
-	int num_packets_aggregated;				///> Number of frames aggregated
-	int *list_id_aggregated;				///> List of frame IDs aggregated
-	double *timestamp_frames_aggregated;	///> List of timestamps of the frames aggregated
+	int num_packets_aggregated;				///> Number of frames aggregated (the packet of the notification and the following ones)
 
 	// For RTS/CTS management
 	double data_duration;		///> Duration of the data packet
@@ -96,28 +96,6 @@ struct TxInfo
 			packet_id, destination_id, tx_duration, tx_power, x, y, z);
 	}
 
-	/**
-	 * Set the size of the array list_id_aggregated
-	 * @param "num_packets_aggregated" [type int]: number of packets aggregated
-	 */
-	void SetSizeOfIdsAggregatedArray(int num_packets_aggregated){
-		list_id_aggregated = new int[num_packets_aggregated];
-		for(int t = 0; t < num_packets_aggregated; ++t){
-			list_id_aggregated[t] = 0;
-		}
-	}
-
-	/**
-	 * Set the size of the array timestamp_frames_aggregated
-	 * @param "num_packets_aggregated" [type int]: number of packets aggregated
-	 */
-	void SetSizeOfTimestampAggregatedArray(int num_packets_aggregated){
-		timestamp_frames_aggregated = new double[num_packets_aggregated];
-		for(int t = 0; t < num_packets_aggregated; ++t){
-			timestamp_frames_aggregated[t] = 0;
-		}
-	}
-
 	/**
 	 * Set the size of the array modulation_schemes
 	 * @param "channels_groups" [type int]: groups of channels that can be used
@@ -129,6 +107,34 @@ struct TxInfo
 		}
 	}
 
+	/**
+	 * Save or load the transmission information
+	 * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+	 */
+	void Checkpoint(CostSnapshot &snapshot){
+		snapshot.Value(num_packets_aggregated);
+		snapshot.Value(data_duration);
+		snapshot.Value(ack_duration);
+		snapshot.Value(rts_duration);
+		snapshot.Value(cts_duration);
+		snapshot.Value(preoccupancy_duration);
+		snapshot.Value(total_tx_power);
+		snapshot.Value(tx_power);
+		snapshot.Value(tx_gain);
+		snapshot.Value(pd);
+		snapshot.Value(bits_ofdm_sym);
+		snapshot.Value(data_rate);
+		snapshot.Array(modulation_schemes, 4);
+		snapshot.Value(x);
+		snapshot.Value(y);
+		snapshot.Value(z);
+		snapshot.Value(nav_time);
+		snapshot.Value(flag_change_in_tx_power);
+		snapshot.Value(bss_color);
+		snapshot.Value(srg);
+		snapshot.Value(txop_sr_identified);
+	}
+
 };
 
 // Notification info
@@ -158,6 +164,25 @@ struct Notification
 		tx_info.PrintTxInfo(packet_id, destination_id, tx_duration);
 	}
 
+	/**
+	 * Save or load the notification
+	 * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+	 */
+	void Checkpoint(CostSnapshot &snapshot){
+		snapshot.Value(packet_id);
+		snapshot.Value(packet_type);
+		snapshot.Value(source_id);
+		snapshot.Value(destination_id);
+		snapshot.Value(tx_duration);
+		snapshot.Value(left_channel);
+		snapshot.Value(right_channel);
+		snapshot.Value(frame_length);
+		snapshot.Value(modulation_id);
+		snapshot.Value(timestamp);
+		snapshot.Value(timestamp_generated);
+		tx_info.Checkpoint(snapshot);
+	}
+
 };
 
 #endif
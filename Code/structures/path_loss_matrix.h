@@ -0,0 +1,213 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+
+
+/**
+ * path_loss_matrix.h: this file defines the measured PATH LOSS MATRIX, which replaces the path loss
+ * model when it is given in config_models (path_loss_matrix=FILE)
+ *
+ * - Entry (rx, tx) is the path loss from node tx to node rx [dB] (node ids in the order of the nodes
+ *   input file). The power received is the transmission power minus the path loss, so the matrix
+ *   includes the antenna gains and may be asymmetric (e.g., measured RSSI).
+ * - Missing links (not measured) are NaN: no power is received through them.
+ * - Binary file (extension .bin): the N x N matrix of little-endian float32, row by row (e.g., written
+ *   with numpy's astype('<f4').tofile()). It is mapped in memory (no parsing).
+ * - CSV file (any other extension): N lines of N values separated by ',' or ';' (empty or "nan" for
+ *   the missing links, any other field must be a number). It is parsed once.
+ */
+
+#ifndef _AUX_PATH_LOSS_MATRIX_
+#define _AUX_PATH_LOSS_MATRIX_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Path loss matrix info
+struct PathLossMatrix
+{
+	int num_nodes;					///> Number of nodes (rows and columns)
+	const float *path_loss;			///> Path loss of each link (index: rx * num_nodes + tx) [dB]
+	void *mapping;					///> Memory mapping of a binary file (NULL for CSV)
+	size_t mapping_size;			///> Size of the mapping [bytes]
+	std::vector<float> parsed;		///> Values parsed from a CSV file
+
+	PathLossMatrix() : num_nodes(0), path_loss(NULL), mapping(NULL), mapping_size(0) {}
+
+	~PathLossMatrix(){
+		if(mapping != NULL) munmap(mapping, mapping_size);
+	}
+
+	/**
+	 * Load the path loss matrix of a scenario
+	 * @param "filename" [type char*]: matrix file (binary if its extension is .bin, CSV otherwise)
+	 * @param "total_nodes_number" [type int]: number of nodes of the scenario
+	 */
+	void LoadPathLossMatrix(const char *filename, int total_nodes_number){
+		num_nodes = total_nodes_number;
+		size_t length (strlen(filename));
+		if(length > 4 && strcmp(filename + length - 4, ".bin") == 0) {
+			MapBinary(filename);
+		} else {
+			ParseCsv(filename);
+		}
+	}
+
+	/**
+	 * Path loss of a link
+	 * @param "rx" [type int]: receiver
+	 * @param "tx" [type int]: transmitter
+	 * @return "path_loss" [type float]: path loss [dB] (NaN if the link was not measured)
+	 */
+	float PathLoss(int rx, int tx) const {
+		return path_loss[(long) rx * num_nodes + tx];
+	}
+
+	private:
+
+	void MapBinary(const char *filename){
+		size_t expected_size ((size_t) num_nodes * num_nodes * sizeof(float));
+		int fd (open(filename, O_RDONLY));
+		if(fd < 0) {
+			printf("ERROR: Path loss matrix '%s' could not be opened: %s!\n", filename, strerror(errno));
+			exit(-1);
+		}
+		struct stat file_stat;
+		if(fstat(fd, &file_stat) != 0) {
+			printf("ERROR: Path loss matrix '%s' could not be read: %s!\n", filename, strerror(errno));
+			exit(-1);
+		}
+		if((size_t) file_stat.st_size != expected_size) {
+			printf("ERROR: Path loss matrix '%s' has %ld bytes (%d x %d float32 expected)!\n",
+				filename, (long) file_stat.st_size, num_nodes, num_nodes);
+			exit(-1);
+		}
+		mapping_size = expected_size;
+		mapping = mmap(NULL, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		int mmap_errno (errno);
+		close(fd);
+		if(mapping == MAP_FAILED) {
+			printf("ERROR: Path loss matrix '%s' could not be mapped: %s!\n", filename, strerror(mmap_errno));
+			exit(-1);
+		}
+		path_loss = (const float *) mapping;
+	}
+
+	void ParseCsv(const char *filename){
+		FILE *stream (fopen(filename, "r"));
+		if(stream == NULL) {
+			printf("ERROR: Path loss matrix '%s' not found!\n", filename);
+			exit(-1);
+		}
+		parsed.assign((size_t) num_nodes * num_nodes, NAN);
+		std::string line;
+		int rx (0);
+		int c;
+		do {
+			c = fgetc(stream);
+			if(c != '\n' && c != EOF) {
+				line += (char) c;
+				continue;
+			}
+			if(line.find_first_not_of(" \t\r") != std::string::npos) {
+				if(rx >= num_nodes) {
+					printf("ERROR: Path loss matrix '%s' has more than %d rows!\n", filename, num_nodes);
+					exit(-1);
+				}
+				ParseRow(filename, line, rx);
+				++rx;
+			}
+			line.clear();
+		} while(c != EOF);
+		fclose(stream);
+		if(rx != num_nodes) {
+			printf("ERROR: Path loss matrix '%s' has %d rows (%d expected)!\n", filename, rx, num_nodes);
+			exit(-1);
+		}
+		path_loss = &parsed[0];
+	}
+
+	void ParseRow(const char *filename, const std::string &line, int rx){
+		int tx (0);
+		size_t start (0);
+		while(start <= line.size()) {
+			size_t end (line.find_first_of(",;", start));
+			if(end == std::string::npos) end = line.size();
+			if(tx >= num_nodes) {
+				printf("ERROR: Row %d of path loss matrix '%s' has more than %d values!\n", rx, filename, num_nodes);
+				exit(-1);
+			}
+			// Only empty and NaN fields are missing links: the rest must be a number followed by blanks at most
+			std::string field (line.substr(start, end - start));
+			if(field.find_first_not_of(" \t\r") != std::string::npos) {
+				char *field_end;
+				double value (strtod(field.c_str(), &field_end));
+				if(field_end == field.c_str() || field_end[strspn(field_end, " \t\r")] != '\0') {
+					printf("ERROR: Path loss matrix '%s' has a malformed value '%s' at row %d, column %d!\n",
+						filename, field.c_str(), rx, tx);
+					exit(-1);
+				}
+				if(!isnan(value)) parsed[(long) rx * num_nodes + tx] = value;
+			}
+			++tx;
+			start = end + 1;
+		}
+		if(tx != num_nodes) {
+			printf("ERROR: Row %d of path loss matrix '%s' has %d values (%d expected)!\n", rx, filename, tx, num_nodes);
+			exit(-1);
+		}
+	}
+};
+
+#endif
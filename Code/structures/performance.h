@@ -50,6 +50,9 @@
 #ifndef _AUX_PERFORMANCE_
 #define _AUX_PERFORMANCE_
 
+#include "../COST/snapshot.h"
+#include "link_budget.h"
+
 struct Performance
 {
 
@@ -84,7 +87,7 @@ struct Performance
 	// Environment statistics
 	double *max_received_power_in_ap_per_wlan;
     double *rssi_list;					///> List of RSSI received from each other WLAN
-    double *received_power_array;		///> Array containing the power received by each node
+    LinkBudgetView links;				///> Power received from each node
     double total_channel_occupancy;
     double successful_channel_occupancy;
 
@@ -174,17 +177,6 @@ struct Performance
 		}
 	}
 
-	/**
-	 * Set the size of the array containing the received power from each node
-	 * @param "total_nodes_number" [type int]: total number of nodes
-	 */
-	void SetSizeOfRxPowerList(int total_nodes_number){
-		received_power_array = new double[total_nodes_number];
-		for(int i = 0; i < total_nodes_number; ++i){
-			received_power_array[i] = 0;
-		}
-	}
-
 	/**
 	 * Set the size of the array containing the RSSI in each STA from the same WLAN
 	 * @param "num_stas" [type int]: number of STAs in the WLAN
@@ -196,6 +188,44 @@ struct Performance
 		}
 	}
 
+	/**
+	 * Save or load the scalar metrics (the arrays are saved by the node that allocated them)
+	 * @param "snapshot" [type CostSnapshot]: snapshot being saved or loaded
+	 */
+	void Checkpoint(CostSnapshot &snapshot){
+		snapshot.Value(timestamp);
+		snapshot.Value(sum_time_channel_idle);
+		snapshot.Value(throughput);
+		snapshot.Value(throughput_loss);
+		snapshot.Value(max_bound_throughput);
+		snapshot.Value(data_packets_acked);
+		snapshot.Value(data_frames_acked);
+		snapshot.Value(data_packets_sent);
+		snapshot.Value(data_packets_lost);
+		snapshot.Value(rts_cts_sent);
+		snapshot.Value(rts_cts_lost);
+		snapshot.Value(rts_lost_slotted_bo);
+		snapshot.Value(num_packets_generated);
+		snapshot.Value(num_packets_dropped);
+		snapshot.Value(num_delay_measurements);
+		snapshot.Value(sum_delays);
+		snapshot.Value(average_delay);
+		snapshot.Value(average_rho);
+		snapshot.Value(average_utilization);
+		snapshot.Value(generation_drop_ratio);
+		snapshot.Value(total_channel_occupancy);
+		snapshot.Value(successful_channel_occupancy);
+		snapshot.Value(expected_backoff);
+		snapshot.Value(num_new_backoff_computations);
+		snapshot.Value(average_waiting_time);
+		snapshot.Value(bandwidth_used_txing);
+		snapshot.Value(time_in_nav);
+		snapshot.Value(num_stas);
+		snapshot.Value(num_tx_init_tried);
+		snapshot.Value(num_tx_init_not_possible);
+		snapshot.Value(prob_slotted_bo_collision);
+	}
+
 };
 
 #endif
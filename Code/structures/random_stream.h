@@ -0,0 +1,204 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+
+/**
+ * random_stream.h: this file defines the counter-based random number streams
+ *
+ * - Each stream is a Philox4x32-10 generator keyed by (seed, entity id, purpose). The n-th
+ *   draw of a stream only depends on its key and on n, so the sequence of a node does not change
+ *   when other nodes draw more or fewer numbers, nor when simulations run in parallel.
+ * - Streams keyed by a 64-bit identifier (e.g., the sites of the shadowing field) take both words of
+ *   the key with it, and carry the seed in the last word of the counter instead.
+ */
+
+#include <stdint.h>
+#include <math.h>
+
+#ifndef _AUX_RANDOM_STREAM_
+#define _AUX_RANDOM_STREAM_
+
+#define PHILOX_M0	0xD2511F53	///> Philox4x32 multiplier (first pair)
+#define PHILOX_M1	0xCD9E8D57	///> Philox4x32 multiplier (second pair)
+#define PHILOX_W0	0x9E3779B9	///> Philox4x32 key increment (golden ratio)
+#define PHILOX_W1	0xBB67AE85	///> Philox4x32 key increment (sqrt(3)-1)
+#define PHILOX_ROUNDS	10		///> Number of rounds of Philox4x32
+
+/**
+ * Philox4x32-10 block function: encrypts a 128-bit counter with a 64-bit key
+ * @param "counter" [type uint32_t*]: counter (4 words), overwritten with the output block
+ * @param "key" [type const uint32_t*]: key (2 words)
+ */
+inline void Philox4x32(uint32_t *counter, const uint32_t *key){
+	uint32_t k0 (key[0]);
+	uint32_t k1 (key[1]);
+	for(int r = 0; r < PHILOX_ROUNDS; ++r){
+		uint64_t p0 ((uint64_t) PHILOX_M0 * counter[0]);
+		uint64_t p1 ((uint64_t) PHILOX_M1 * counter[2]);
+		uint32_t c0 ((uint32_t) (p1 >> 32) ^ counter[1] ^ k0);
+		uint32_t c2 ((uint32_t) (p0 >> 32) ^ counter[3] ^ k1);
+		counter[0] = c0;
+		counter[1] = (uint32_t) p1;
+		counter[2] = c2;
+		counter[3] = (uint32_t) p0;
+		k0 += PHILOX_W0;
+		k1 += PHILOX_W1;
+	}
+}
+
+struct RandomStream
+{
+	uint32_t key[2];		///> Key of the stream: seed and entity (node, agent...) identifier
+	uint32_t purpose;		///> Purpose of the stream (RNG_STREAM_*), part of the counter
+	uint32_t counter_seed;	///> Seed of the streams keyed by a 64-bit identifier, part of the counter (0 otherwise)
+	uint64_t block_ix;		///> Index of the next block to be generated
+	uint32_t block[4];		///> Last generated block
+	int word_ix;			///> Next unused word of the block (4: block exhausted)
+
+	/**
+	 * Initialize the stream
+	 * @param "seed" [type int]: simulation seed
+	 * @param "entity_id" [type int]: identifier of the entity owning the stream (e.g., node id)
+	 * @param "stream_purpose" [type int]: purpose of the stream (RNG_STREAM_*)
+	 */
+	void Initialize(int seed, int entity_id, int stream_purpose){
+		key[0] = (uint32_t) seed;
+		key[1] = (uint32_t) entity_id;
+		purpose = (uint32_t) stream_purpose;
+		counter_seed = 0;
+		block_ix = 0;
+		word_ix = 4;
+	}
+
+	/**
+	 * Initialize a stream keyed by a 64-bit identifier (the seed goes to the counter)
+	 * @param "seed" [type int]: simulation seed
+	 * @param "entity_key" [type uint64_t]: identifier of the entity owning the stream (e.g., site of the shadowing field)
+	 * @param "stream_purpose" [type int]: purpose of the stream (RNG_STREAM_*)
+	 */
+	void Initialize(int seed, uint64_t entity_key, int stream_purpose){
+		key[0] = (uint32_t) entity_key;
+		key[1] = (uint32_t) (entity_key >> 32);
+		purpose = (uint32_t) stream_purpose;
+		counter_seed = (uint32_t) seed;
+		block_ix = 0;
+		word_ix = 4;
+	}
+
+	/**
+	 * Move the stream to a block, e.g., to draw the numbers of an item identified by the block index
+	 * @param "block" [type uint64_t]: index of the next block to be generated (4 words each)
+	 */
+	void Seek(uint64_t block){
+		block_ix = block;
+		word_ix = 4;
+	}
+
+	/**
+	 * Return the next 32 random bits of the stream
+	 * @return "word" [type uint32_t]: random word
+	 */
+	uint32_t NextWord(){
+		if(word_ix == 4){
+			block[0] = (uint32_t) block_ix;
+			block[1] = (uint32_t) (block_ix >> 32);
+			block[2] = purpose;
+			block[3] = counter_seed;
+			Philox4x32(block, key);
+			++block_ix;
+			word_ix = 0;
+		}
+		return block[word_ix++];
+	}
+
+	/**
+	 * Draw a uniform double with 53 random bits
+	 * @return "u" [type double]: random value in [0,1)
+	 */
+	double Uniform(){
+		uint32_t a (NextWord() >> 5);
+		uint32_t b (NextWord() >> 6);
+		return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+	}
+
+	/**
+	 * Draw a uniform double in [0,v)
+	 * @param "v" [type double]: upper bound
+	 * @return "u" [type double]: random value
+	 */
+	double Uniform(double v){
+		return v * Uniform();
+	}
+
+	/**
+	 * Draw a uniform integer in [0,n-1]
+	 * @param "n" [type int]: number of possible values
+	 * @return "ix" [type int]: random integer
+	 */
+	int Uniform(int n){
+		return (int) (n * Uniform());
+	}
+
+	/**
+	 * Draw a uniform double in [min,max)
+	 * @param "min" [type double]: minimum value
+	 * @param "max" [type double]: maximum value
+	 * @return "u" [type double]: random value
+	 */
+	double Uniform(double min, double max){
+		return min + Uniform() * (max - min);
+	}
+
+	/**
+	 * Draw an exponentially distributed value
+	 * @param "mean" [type double]: mean of the distribution
+	 * @return "x" [type double]: random value
+	 */
+	double Exponential(double mean){
+		return -mean * log(1 - Uniform());
+	}
+};
+
+#endif
@@ -0,0 +1,144 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+
+
+/**
+ * shadowing_field.h: this file defines the SHADOWING FIELD of the path loss models with random losses
+ *
+ * - The random losses of a link (shadowing and obstacles) are a deterministic function of the seed and
+ *   of the link: they are drawn from the counter-based stream keyed by one end of the link, at the block
+ *   of the other end. They are symmetric, the same every time the link is computed, and independent of
+ *   the order in which the links are computed.
+ * - With a decorrelation distance, the ends are the cells of that size where the nodes are, instead of
+ *   the nodes: links between the same pair of cells share their losses (spatially correlated shadowing).
+ *   The site of an end (node id or packed cell coordinates) keys the stream with its 64 bits.
+ * - Limits of the cells, a coarse stand-in for a correlation that decays with distance:
+ *     + The correlation is all-or-nothing: links between the same pair of cells share one value, and
+ *       links between different pairs of cells are independent, however close their nodes are.
+ *     + The losses jump at the cell edges: two close nodes on both sides of an edge get independent
+ *       losses, while two nodes at opposite corners of a cell get the same ones.
+ *     + The cell coordinates keep 21 bits each, so cells 2^21 decorrelation distances apart alias.
+ * - The field is only evaluated when the link budget is built. The link budget stores the result, so
+ *   the path loss of a link is never drawn again.
+ */
+
+#ifndef _AUX_SHADOWING_FIELD_
+#define _AUX_SHADOWING_FIELD_
+
+#include <math.h>
+#include <stdint.h>
+#include <algorithm>
+#include "../list_of_macros.h"
+#include "random_stream.h"
+
+// Random losses of a link, as fractions of the maximum loss of the model
+struct LinkShadowing
+{
+	double shadowing;	///> Shadowing, in [0,1)
+	double obstacles;	///> Loss of the obstacles (per wall), in [0,1)
+};
+
+// Shadowing field info
+struct ShadowingField
+{
+	int seed;						///> Simulation seed
+	double decorrelation_distance;	///> Size of the cells sharing their losses (0: independent per link) [m]
+	const double *x;				///> X position of each node [m]
+	const double *y;				///> Y position of each node [m]
+	const double *z;				///> Z position of each node [m]
+
+	/**
+	 * Set the field of a simulation
+	 * @param "simulation_seed" [type int]: simulation seed
+	 * @param "decorrelation" [type double]: decorrelation distance (0: independent losses per link) [m]
+	 * @param "x_nodes" [type double*]: X position of each node [m]
+	 * @param "y_nodes" [type double*]: Y position of each node [m]
+	 * @param "z_nodes" [type double*]: Z position of each node [m]
+	 */
+	void InitializeShadowingField(int simulation_seed, double decorrelation,
+		const double *x_nodes, const double *y_nodes, const double *z_nodes){
+		seed = simulation_seed;
+		decorrelation_distance = decorrelation;
+		x = x_nodes;
+		y = y_nodes;
+		z = z_nodes;
+	}
+
+	/**
+	 * End of a link in the field: the node, or its cell with a decorrelation distance
+	 * @param "n" [type int]: node
+	 * @return "site" [type uint64_t]: identifier of the end
+	 */
+	uint64_t Site(int n) const {
+		if(decorrelation_distance <= 0) return (uint64_t) n;
+		uint64_t mask (((uint64_t) 1 << 21) - 1);
+		return (((uint64_t) (int64_t) floor(x[n] / decorrelation_distance) & mask) << 42)
+			| (((uint64_t) (int64_t) floor(y[n] / decorrelation_distance) & mask) << 21)
+			| ((uint64_t) (int64_t) floor(z[n] / decorrelation_distance) & mask);
+	}
+
+	/**
+	 * Random losses of a link (symmetric)
+	 * @param "n" [type int]: first node
+	 * @param "m" [type int]: second node
+	 * @return "shadowing" [type LinkShadowing]: random losses of the link
+	 */
+	LinkShadowing Link(int n, int m) const {
+		uint64_t site_n (Site(n));
+		uint64_t site_m (Site(m));
+		uint64_t low (std::min(site_n, site_m));
+		uint64_t high (std::max(site_n, site_m));
+		RandomStream stream;
+		stream.Initialize(seed, low, RNG_STREAM_SHADOWING);
+		stream.Seek(high);
+		LinkShadowing shadowing;
+		shadowing.shadowing = stream.Uniform();
+		shadowing.obstacles = stream.Uniform();
+		return shadowing;
+	}
+};
+
+#endif
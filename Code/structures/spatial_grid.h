@@ -0,0 +1,165 @@
+/* Komondor IEEE 802.11ax Simulator
+ *
+ * Copyright (c) 2017, Universitat Pompeu Fabra.
+ * GNU GENERAL PUBLIC LICENSE
+ * Version 3, 29 June 2007
+
+ * Copyright (C) 2007 Free Software Foundation, Inc. <http://fsf.org/>
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * -----------------------------------------------------------------
+ *
+ * Author  : Sergio Barrachina-Muñoz and Francesc Wilhelmi
+ * Created : 2016-12-05
+ * Updated : $Date: 2017/03/20 10:32:36 $
+ *           $Revision: 1.0 $
+ *
+ * -----------------------------------------------------------------
+ */
+
+
+
+/**
+ * spatial_grid.h: this file defines a uniform grid indexing the positions of the nodes
+ *
+ * - Space is split in cubic cells. Each cell is identified by a key packing its three integer
+ *   coordinates (21 bits each, wrapped: two far cells may share a key, which only adds candidates).
+ * - The nodes are sorted by the key of their cell, so the nodes of a cell are contiguous and the
+ *   cell is found by binary search. Building the grid is O(N log N).
+ * - The nodes within a radius of a point are searched in the cells overlapping the cube around it.
+ */
+
+#ifndef _AUX_SPATIAL_GRID_
+#define _AUX_SPATIAL_GRID_
+
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+
+#define SPATIAL_GRID_BITS	21	///> Bits of each cell coordinate in the key of a cell
+
+// Spatial grid info
+struct SpatialGrid
+{
+	double cell_size;					///> Size of the side of the cells [m]
+	std::vector<double> x;				///> X position of each node
+	std::vector<double> y;				///> Y position of each node
+	std::vector<double> z;				///> Z position of each node
+	std::vector<uint64_t> keys_sorted;	///> Key of the cell of each node, sorted
+	std::vector<int> nodes_sorted;		///> Nodes sorted by the key of their cell (and by identifier)
+
+	/**
+	 * Get the integer coordinate of the cell containing a position
+	 * @param "position" [type double]: position in one axis [m]
+	 * @return "coordinate" [type int64_t]: cell coordinate
+	 */
+	int64_t CellCoordinate(double position){
+		return (int64_t) floor(position / cell_size);
+	}
+
+	/**
+	 * Get the key of a cell
+	 * @param "cx" [type int64_t]: X coordinate of the cell
+	 * @param "cy" [type int64_t]: Y coordinate of the cell
+	 * @param "cz" [type int64_t]: Z coordinate of the cell
+	 * @return "key" [type uint64_t]: key of the cell
+	 */
+	uint64_t CellKey(int64_t cx, int64_t cy, int64_t cz){
+		uint64_t mask (((uint64_t) 1 << SPATIAL_GRID_BITS) - 1);
+		return (((uint64_t) cx & mask) << (2 * SPATIAL_GRID_BITS))
+			| (((uint64_t) cy & mask) << SPATIAL_GRID_BITS) | ((uint64_t) cz & mask);
+	}
+
+	/**
+	 * Build the grid
+	 * @param "num_nodes" [type int]: number of nodes
+	 * @param "x_per_node" [type double*]: X position of each node
+	 * @param "y_per_node" [type double*]: Y position of each node
+	 * @param "z_per_node" [type double*]: Z position of each node
+	 * @param "size" [type double]: size of the side of the cells [m]
+	 */
+	void BuildSpatialGrid(int num_nodes, double *x_per_node, double *y_per_node, double *z_per_node, double size){
+		cell_size = size;
+		x.assign(x_per_node, x_per_node + num_nodes);
+		y.assign(y_per_node, y_per_node + num_nodes);
+		z.assign(z_per_node, z_per_node + num_nodes);
+		std::vector< std::pair<uint64_t, int> > key_node(num_nodes);
+		for(int n = 0; n < num_nodes; ++n){
+			key_node[n].first = CellKey(CellCoordinate(x[n]), CellCoordinate(y[n]), CellCoordinate(z[n]));
+			key_node[n].second = n;
+		}
+		std::sort(key_node.begin(), key_node.end());
+		keys_sorted.resize(num_nodes);
+		nodes_sorted.resize(num_nodes);
+		for(int i = 0; i < num_nodes; ++i){
+			keys_sorted[i] = key_node[i].first;
+			nodes_sorted[i] = key_node[i].second;
+		}
+	}
+
+	/**
+	 * Find the nodes within a radius of a position
+	 * @param "px" [type double]: X position [m]
+	 * @param "py" [type double]: Y position [m]
+	 * @param "pz" [type double]: Z position [m]
+	 * @param "radius" [type double]: radius [m]
+	 * @param "nodes" [type std::vector<int>]: nodes found, sorted by identifier (to be filled)
+	 */
+	void GetNodesInRadius(double px, double py, double pz, double radius, std::vector<int> &nodes){
+		nodes.clear();
+		int64_t num_cells ((int64_t) ceil(radius / cell_size));
+		int64_t cx (CellCoordinate(px));
+		int64_t cy (CellCoordinate(py));
+		int64_t cz (CellCoordinate(pz));
+		std::vector<uint64_t> keys_visited;
+		for(int64_t i = cx - num_cells; i <= cx + num_cells; ++i){
+			for(int64_t j = cy - num_cells; j <= cy + num_cells; ++j){
+				for(int64_t k = cz - num_cells; k <= cz + num_cells; ++k){
+					uint64_t key (CellKey(i, j, k));
+					// Wrapped coordinates may give the same key twice
+					if(std::find(keys_visited.begin(), keys_visited.end(), key) != keys_visited.end()) continue;
+					keys_visited.push_back(key);
+					std::vector<uint64_t>::iterator first (std::lower_bound(keys_sorted.begin(), keys_sorted.end(), key));
+					for(std::vector<uint64_t>::iterator it = first; it != keys_sorted.end() && *it == key; ++it){
+						int n (nodes_sorted[it - keys_sorted.begin()]);
+						double dx (x[n] - px);
+						double dy (y[n] - py);
+						double dz (z[n] - pz);
+						if(dx * dx + dy * dy + dz * dz <= radius * radius) nodes.push_back(n);
+					}
+				}
+			}
+		}
+		std::sort(nodes.begin(), nodes.end());
+	}
+
+};
+
+#endif